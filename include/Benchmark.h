@@ -0,0 +1,79 @@
+#pragma once
+#include "CameraView.h"
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+struct BenchmarkOptions {
+    int frames = 600;
+    int width = 1280;
+    int height = 720;
+    int enemies = 6;  // max enemies spawned during the run
+    std::string outputPath = "benchmark.json";
+};
+
+// Headless render benchmark: renders a scripted camera path into an
+// offscreen framebuffer for a fixed number of frames and writes per-frame
+// CPU and GPU timings as JSON.
+//
+// Where FirstOGL is built with EGL the context comes from HeadlessContext,
+// so it runs without any display server (e.g. Mesa's llvmpipe on CI);
+// otherwise from a hidden GLUT window. Nothing is presented; every frame
+// goes to the FBO.
+class Benchmark {
+public:
+    // How many GPU timer queries may be in flight before results are read back
+    static constexpr int QUERY_RING = 8;
+
+    // Looks for --benchmark [--frames N] [--size WxH] [--enemies N] [--out file].
+    // Returns false when --benchmark is absent.
+    static bool parseArgs(int argc, char** argv, BenchmarkOptions& options);
+
+    Benchmark();
+    ~Benchmark();
+
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    // Needs a current GL context; false (with a message) without framebuffer objects
+    bool initialize(const BenchmarkOptions& options);
+
+    bool isFinished() const { return currentFrame >= options.frames; }
+    int getFrameIndex() const { return currentFrame; }
+
+    // Camera for the current frame: a looped fly-through of the arena
+    CameraView getCameraView() const;
+
+    // Bracket one frame's rendering; endFrame() may add cull counts for the record
+    void beginFrame();
+    void endFrame(int objectsDrawn, int objectsCulled, int objectsOccluded);
+
+    // Reads back outstanding GPU timings and writes the JSON report
+    bool writeReport();
+
+private:
+    struct FrameRecord {
+        double startMs;  // nowMs() at beginFrame()
+        double cpuMs;    // CPU time from beginFrame() to endFrame()
+        double frameMs;  // wall time since the previous beginFrame()
+        double gpuMs;    // negative when no timer query result exists
+        int drawn;
+        int culled;
+        int occluded;
+    };
+
+    // Path position for t in [0, 1)
+    void getEyeAndTarget(float t, Vector3& eye, Vector3& target) const;
+    void collectGpuTime(int frame);
+
+    BenchmarkOptions options;
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    GLuint depthBuffer;
+    GLuint timerQueries[QUERY_RING];
+    bool gpuTimers;
+    int currentFrame;
+    double frameStart;
+    double previousFrameStart;
+    std::vector<FrameRecord> records;
+};
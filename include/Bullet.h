@@ -5,15 +5,19 @@ class Bullet
 {
 public:
     Bullet(Vector3 ipos, Vector3 idirection, float idamage = 1.0f);
-    void draw();
     void move(float dt);
 
+    // Fixed-step interpolation, as for Enemy; the renderer draws its own
+    // sphere between getPreviousPosition() and getPosition()
+    void storePreviousState() {previousPosition = position;}
+
     void setPosition(Vector3 ipos) {position = ipos;}
     void setColor(Color icolor);
     void setDamage(float d) {damage = d;}
     void deactivate() {active = false;}
 
     Vector3 getPosition() {return position;}
+    Vector3 getPreviousPosition() const {return previousPosition;}
     Color getColor() {return sphere->getColor();}
     Shape* getShape() {return (Shape*)sphere;}
     float getDamage() {return damage;}
@@ -23,6 +27,7 @@ public:
 private:
     Sphere* sphere;
     Vector3 position;
+    Vector3 previousPosition;  // position at the start of the current simulation step
     Vector3 direction;
     float speed;
 
@@ -1,5 +1,7 @@
 #pragma once
 #include "Vector3.h"  // For Vector3
+#include "CameraView.h"
+#include "Quaternion.h"
 
 class Scene; // Forward declaration
 
@@ -7,7 +9,20 @@ class Camera {
 public:
     Camera(float x = 0.0f, float y = 2.0f, float z = 10.0f);
 
+    // Loads getProjectionMatrix() and getViewMatrix() into GL
     void applyView() const;
+
+    // Yaw about -Y, then pitch about X, applied to the default -Z forward
+    Quaternion getOrientation() const;
+    Matrix4 getViewMatrix() const;
+    Matrix4 getProjectionMatrix() const { return perspective.matrix(); }
+    Matrix4 getViewProjectionMatrix() const { return getProjectionMatrix() * getViewMatrix(); }
+    // View from the position blended alpha of the way from the previous simulation step
+    Matrix4 getInterpolatedViewMatrix(float alpha) const;
+    Vector3 getInterpolatedPosition(float alpha) const;
+    // Called before each fixed simulation step
+    void storePreviousState() { prevX = x; prevY = y; prevZ = z; }
+    void setPerspective(const Perspective& p) { perspective = p; }
     void move(float forward, float right);
     void rotate(float deltaYaw, float deltaPitch);
     void update(float deltaTime);  // Update physics (gravity, jumping)
@@ -22,6 +37,7 @@ public:
     Vector3 getLookDirection() const { return Vector3(lookX - x, lookY - y, lookZ - z); }
 
     // Setters
+    // Teleports: the next frame is not blended from the old position
     void setPosition(float x, float y, float z);
     void setMoveSpeed(float speed) { moveSpeed = speed; }
     float getMoveSpeed() const { return moveSpeed; }
@@ -33,10 +49,12 @@ public:
 
 private:
     float x, y, z;          // Position
+    float prevX, prevY, prevZ; // Position at the start of the current simulation step
     float yaw, pitch;       // Rotation angles
     float moveSpeed;        // Movement speed
     float collisionRadius;  // Collision detection radius
     Scene* scene;           // Scene reference for collision detection
+    Perspective perspective;
 
     // Jump physics
     float verticalVelocity; // Vertical velocity for jumping
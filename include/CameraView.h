@@ -0,0 +1,38 @@
+#pragma once
+#include "Matrix4.h"
+#include "Vector3.h"
+
+// Perspective projection parameters, as passed to gluPerspective
+struct Perspective {
+    float fovyDegrees;
+    float aspect;
+    float zNear;
+    float zFar;
+
+    Perspective(float fovy = 60.0f, float aspectRatio = 4.0f / 3.0f, float nearPlane = 0.1f, float farPlane = 100.0f)
+        : fovyDegrees(fovy), aspect(aspectRatio), zNear(nearPlane), zFar(farPlane) {}
+
+    Matrix4 matrix() const { return Matrix4::perspective(fovyDegrees, aspect, zNear, zFar); }
+};
+
+// The active camera's matrices for one frame, built on the CPU from camera
+// state. Culling, LOD, lighting and HUD projection read these instead of
+// querying GL for the modelview/projection/viewport.
+struct CameraView {
+    Matrix4 view;
+    Matrix4 projection;
+    Matrix4 viewProjection;
+    Vector3 position;  // world-space eye
+    int viewportWidth;
+    int viewportHeight;
+
+    CameraView();
+    CameraView(const Matrix4& view, const Matrix4& projection, int viewportWidth, int viewportHeight);
+
+    // Loads projection and view into the fixed-function matrix stacks
+    // (leaves GL_MODELVIEW current)
+    void apply() const;
+
+    // Window coordinates, origin at the bottom-left; false when the point is behind the camera
+    bool project(const Vector3& world, float& winX, float& winY) const;
+};
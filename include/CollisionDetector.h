@@ -19,7 +19,7 @@ struct Projection {
     }
     
     static Projection merge(const Projection& a, const Projection& b) {
-        return Projection(min(a.minValue, b.minValue), max(a.maxValue, b.maxValue));
+        return Projection((std::min)(a.minValue, b.minValue), (std::max)(a.maxValue, b.maxValue));
     }
 };
 
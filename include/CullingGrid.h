@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Shapes.h"
+#include "ViewFrustum.h"
+#include <vector>
+#include <memory>
+
+// Coarse XZ grid over static shapes so view culling rejects whole cells
+// before testing individual bounding spheres. Each shape lives in the cell
+// containing its center; a cell's bounds grow to enclose its members'
+// spheres, so no shape is ever listed twice.
+class CullingGrid {
+public:
+    static constexpr float CELL_SIZE = 10.0f;
+
+    CullingGrid();
+
+    // Shapes are treated as static: rebuild after adding, moving or resizing them
+    void build(const std::vector<std::shared_ptr<Shape>>& shapes);
+
+    // Appends the indices (into the vector passed to build()) of shapes whose
+    // bounding spheres intersect the frustum, and returns how many were rejected
+    int collectVisible(const ViewFrustum& frustum, std::vector<int>& visible) const;
+
+    int getShapeCount() const { return static_cast<int>(centers.size()); }
+    int getCellCount() const { return static_cast<int>(cells.size()); }
+
+private:
+    struct Cell {
+        Vector3 min;
+        Vector3 max;
+        std::vector<int> members;
+    };
+
+    std::vector<Cell> cells;       // cellsX * cellsZ, row-major in z; empty cells are skipped
+    std::vector<Vector3> centers;  // per shape, same order as build()
+    std::vector<float> radii;
+    int cellsX;
+    int cellsZ;
+};
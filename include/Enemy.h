@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Shapes.h"
+#include <cstdint>
+#include <vector>
 
 class Enemy
 {
@@ -9,7 +11,6 @@ public:
     Enemy(Vector3 ipos, Color icol = Color());
     Enemy(Vector3 ipos, Color icolHead, Color icolBody);
     ~Enemy();  // Destructor to clean up shape pointers
-    void draw();
 
     void setPosition(Vector3 ipos) {position = ipos; updatePos();}
     void setColor(Color icolor, PartType part);
@@ -19,9 +20,56 @@ public:
     Vector3 getPosition() {return position;}
     Color getColor(PartType part) {return part == BODY ? bodyLower->getColor() : head->getColor();}
     bool isAlive() {return alive;}
+    float getHealth() const {return currentHealth;}
+    float getMaxHealth() const {return maxHealth;}
     float getYaw() {return yaw;}
     Shape* getBodyShape() {return (Shape*)bodyLower;}
     Shape* getHeadShape() {return (Shape*)head;}
+
+    // All 12 parts in a fixed order. The body and head (indices 0 and 1) are in world
+    // space; the rest are in enemy-local space (feet at origin, facing +Z).
+    // EnemyRenderer places them with the rendered position and yaw.
+    std::vector<Shape*> getParts() const;
+    static constexpr int PART_COUNT = 12;
+    static constexpr int BODY_PART_INDEX = 0;
+    static constexpr int HEAD_PART_INDEX = 1;
+    // Same order as getParts(), without allocating (per-frame use)
+    void collectParts(Shape* parts[PART_COUNT]) const;
+
+    // Tessellation level of every part, as last picked by EnemyRenderer::updateLod()
+    void getPartLodLevels(int levels[PART_COUNT]) const;
+
+    // World-space point the health bar hangs from, at the rendered position
+    Vector3 getHealthBarAnchor() const;
+
+    // Sphere enclosing every part and the health bar at the rendered position, for view culling
+    void getBoundingSphere(Vector3& center, float& radius) const;
+
+    // The same shapes for an enemy standing at position, for callers that
+    // track enemies without Enemy objects (EnemyHorde). Hit spheres are the
+    // body then the head, as getBodyShape() and getHeadShape().
+    static constexpr int HIT_SPHERE_COUNT = 2;
+    static void boundingSphereAt(const Vector3& position, Vector3& center, float& radius);
+    static void hitSpheresAt(const Vector3& position, Vector3 centers[HIT_SPHERE_COUNT], float radii[HIT_SPHERE_COUNT]);
+
+    // Fixed-step interpolation: storePreviousState() before each simulation
+    // step, interpolate() once per rendered frame. Drawing, culling, LOD and
+    // the health bar use the blended pose; collision uses the simulated one.
+    void storePreviousState() {previousPosition = position; previousYaw = yaw;}
+    void interpolate(float alpha);
+    Vector3 getRenderPosition() const {return renderPosition;}
+    float getRenderYaw() const {return renderYaw;}
+    Vector3 getPreviousPosition() const {return previousPosition;}
+    float getPreviousYaw() const {return previousYaw;}
+
+    // For the renderer's stand-ins, which replay a snapshot's pose and health
+    void setPose(Vector3 ipos, float iyaw) {position = ipos; yaw = iyaw; updatePos();}
+    void setHealth(float health) {currentHealth = health; alive = health > 0.0f;}
+
+    // Unique per spawned enemy (EnemyManager numbers them from 1, 0 = unassigned),
+    // so the renderer can follow one enemy across snapshots
+    void setId(uint32_t value) {id = value;}
+    uint32_t getId() const {return id;}
 private:
     // Body structure (2 spheres)
     Sphere* bodyLower;    // Large bottom sphere
@@ -41,11 +89,16 @@ private:
 
     Vector3 position;
     float yaw;  // Rotation angle around Y-axis (radians), 0 = facing +Z direction
+    Vector3 previousPosition;  // pose at the start of the current simulation step
+    float previousYaw;
+    Vector3 renderPosition;    // pose blended by the last interpolate()
+    float renderYaw;
 
     float currentHealth;
     float maxHealth;
     bool alive;
+    uint32_t id;
 
+    void createParts();
     void updatePos();
-    void drawHealthBar();
 };
@@ -0,0 +1,123 @@
+#pragma once
+#include "Enemy.h"
+#include "Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Scene;
+class Bullet;
+class NavigationGrid;
+class FlowField;
+
+// Enemies for horde mode, tens of thousands at a time. Instead of an Enemy
+// with twelve heap-allocated shapes each, every member is one index into
+// parallel arrays (position, pose, health, colors), so a tick streams through
+// contiguous memory and adding a member allocates nothing once reserved.
+//
+// Members steer by a shared FlowField toward the goal and keep apart by a
+// soft separation push from neighbours found through a uniform bucket grid.
+// The grid is rebuilt (counting sort, no allocation) at the start of every
+// update() and keeps its own copy of the positions in bucket order, so a
+// neighbour scan reads contiguous memory. The push is still the expensive
+// part, so each member rescans every SEPARATION_INTERVAL steps (staggered by
+// index) and reuses its last push in between.
+//
+// Movement reads only the step's starting poses and writes each member's own
+// entry, so it runs on the JobSystem and gives the same result on any number
+// of threads. Static geometry is taken from the NavigationGrid, whose blocked
+// cells are already grown by the enemy radius, so a move is one cell lookup.
+class EnemyHorde {
+public:
+    static constexpr float MAX_HEALTH = 5.0f;  // same as Enemy
+
+    explicit EnemyHorde(const Scene* scene);
+
+    void reserve(size_t count);
+    void add(const Vector3& position, float yaw, const Color& bodyColor, const Color& headColor);
+    void clear();
+    size_t size() const { return positionX.size(); }
+    bool empty() const { return positionX.empty(); }
+
+    // One simulation step for every member: stores the previous pose, then
+    // moves toward goal along field (straight at it where the field has no
+    // direction). grid may be null for an open arena.
+    void update(float deltaTime, float speed, const NavigationGrid* grid, const FlowField& field, const Vector3& goal);
+
+    // Queries against the poses of the last update(); they search far enough
+    // past the buckets to cover a step's movement, so they stay exact until
+    // the next update().
+    // Active bullets that hit a member are deactivated and deal their damage;
+    // returns how many members that killed
+    int applyBullets(const std::vector<Bullet*>& bullets);
+    // Whether any living member's body is within radius of position (horizontally)
+    bool touches(const Vector3& position, float radius) const;
+    // Closest living member to from; false when there is none
+    bool findNearest(const Vector3& from, Vector3& outPosition) const;
+
+    // Drops members with no health left, keeping the others in order; returns how many went
+    size_t removeDead();
+
+    // Stable for a member's lifetime and increasing in member order, since
+    // removeDead() keeps the order; never 0
+    uint32_t getId(size_t i) const { return memberId[i]; }
+    Vector3 getPosition(size_t i) const { return Vector3(positionX[i], 0.0f, positionZ[i]); }
+    Vector3 getPreviousPosition(size_t i) const { return Vector3(previousX[i], 0.0f, previousZ[i]); }
+    float getYaw(size_t i) const { return yaw[i]; }
+    float getPreviousYaw(size_t i) const { return previousYaw[i]; }
+    float getHealth(size_t i) const { return health[i]; }
+    const Color& getColor(size_t i, Enemy::PartType part) const {
+        return part == Enemy::BODY ? bodyColor[i] : headColor[i];
+    }
+
+private:
+    static constexpr float SEPARATION_DISTANCE = 1.2f;  // members closer than this push apart
+    static constexpr float BUCKET_SIZE = SEPARATION_DISTANCE;  // so separation scans 3x3 buckets
+    static constexpr float MAX_DRIFT = 0.5f;            // queries' allowance for movement since bucketing
+    static constexpr float SEPARATION_STRENGTH = 1.5f;  // push speed at full overlap, in units of speed
+    static constexpr int MAX_NEIGHBOURS = 8;            // bounds the cost inside dense crowds
+    static constexpr uint32_t SEPARATION_INTERVAL = 2;  // steps between a member's separation scans
+    static constexpr float ARRIVE_DISTANCE = 0.8f;      // stop seeking this close to the goal
+    static constexpr float BODY_CLEARANCE = 1.1f;       // NavigationGrid::ENEMY_RADIUS
+    static constexpr size_t MOVE_GRAIN = 256;           // members per movement job
+
+    void rebuildBuckets();
+    int bucketOf(float x, float z) const;
+    // Calls visit(member, bucketedX, bucketedZ) for every member in the
+    // buckets within reach of (x, z), in bucket then index order (every
+    // member, when the buckets are stale); stops early when visit returns false
+    template <typename Visit>
+    void forEachNear(float x, float z, float reach, const Visit& visit) const;
+    // Writes member i's own entries only
+    void moveMember(size_t i, float deltaTime, float speed, const NavigationGrid* grid, const FlowField& field,
+                    const Vector3& goal);
+    bool canMoveTo(const NavigationGrid* grid, float x, float z, bool fromBlocked) const;
+
+    const Scene* scene;
+
+    std::vector<float> positionX;
+    std::vector<float> positionZ;
+    std::vector<float> yaw;
+    std::vector<float> previousX;
+    std::vector<float> previousZ;
+    std::vector<float> previousYaw;
+    std::vector<float> health;
+    std::vector<Color> bodyColor;
+    std::vector<Color> headColor;
+    std::vector<float> separationX;  // last separation push, reused between scans
+    std::vector<float> separationZ;
+    std::vector<uint32_t> memberId;
+    uint32_t nextId;
+    uint32_t stepCount;
+
+    // Members sorted by bucket: bucketStart[b] .. bucketStart[b + 1] index
+    // bucketMembers and the positions they had when bucketed
+    int bucketsPerSide;
+    float bucketOrigin;
+    std::vector<uint32_t> bucketStart;
+    std::vector<uint32_t> bucketMembers;
+    std::vector<float> bucketX;
+    std::vector<float> bucketZ;
+    std::vector<uint32_t> memberBucket;
+    bool bucketsValid;
+};
@@ -4,7 +4,10 @@
 #include <memory>
 #include <unordered_map>
 #include "Enemy.h"
+#include "EnemyHorde.h"
+#include "FlowField.h"
 #include "GameState.h"
+#include "Random.h"
 
 class Scene;  // Forward declaration
 class Player; // Forward declaration
@@ -19,6 +22,9 @@ public:
     // Core update - only runs when state is PLAYING
     void update(float deltaTime, GameState state, const Vector3& playerPos);
 
+    // Reseeds the spawn and wander streams; the same seed replays the same enemies
+    void setSeed(uint64_t seed);
+
     // Spawning
     void setSpawnInterval(float interval) { spawnInterval = interval; }
     void setMinSpawnRadius(float radius) { minSpawnRadius = radius; }
@@ -29,7 +35,17 @@ public:
     void setEnemySpeed(float speed) { enemySpeed = speed; }
 
     // Navigation grid for pathfinding
-    void setNavigationGrid(const NavigationGrid* grid) { navigationGrid = grid; pathInfo.clear(); }
+    void setNavigationGrid(const NavigationGrid* grid) { navigationGrid = grid; pathInfo.clear(); flowField.invalidate(); }
+
+    // Horde mode: enemies live in an EnemyHorde (contiguous arrays, one shared
+    // flow field to the player) instead of as Scene Enemy objects, for tens of
+    // thousands of them. Each spawn then adds up to the batch size at once.
+    // Switching modes clears every enemy.
+    void setHordeMode(bool enabled);
+    bool isHordeMode() const { return hordeMode; }
+    void setHordeSpawnBatch(int count) { hordeSpawnBatch = count; }
+    const EnemyHorde& getHorde() const { return horde; }
+    const FlowField& getFlowField() const { return flowField; }
 
     // Obstacle avoidance tuning
     void setAvoidanceLookAhead(float distance) { avoidanceLookAhead = distance; }
@@ -41,7 +57,7 @@ public:
     float checkPlayerCollision(Player* player, float deltaTime);
 
     // Get enemy count for debugging
-    int getEnemyCount() const { return static_cast<int>(managedEnemies.size()); }
+    int getEnemyCount() const { return hordeMode ? static_cast<int>(horde.size()) : static_cast<int>(managedEnemies.size()); }
 
     // Clear all managed enemies
     void clear();
@@ -50,10 +66,26 @@ public:
     void reset();
 
 private:
+    struct EnemyPathInfo;
+
+    // One enemy's share of a movement tick. Everything random is drawn
+    // beforehand in enemy order, so results do not depend on thread count.
+    struct MoveTask {
+        Enemy* enemy;
+        EnemyPathInfo* info;
+        bool replanWander;     // pick up wanderTarget as the new destination
+        Vector3 wanderTarget;
+    };
+
     void spawnEnemy(const Vector3& playerPos);
+    void updateHorde(float deltaTime, const Vector3& playerPos);
+    // Adds up to count members on free cells that can reach the player
+    void spawnHorde(int count, const Vector3& playerPos);
     void updateEnemyMovement(float deltaTime, const Vector3& playerPos);
+    // Steers one enemy along its path; only touches task.enemy and task.info
+    void moveEnemy(const MoveTask& task, float deltaTime, const Vector3& playerPos, bool playerInSafeZone) const;
     void removeDeadEnemies();
-    bool hasPathToPlayer(const Vector3& spawnPos, const Vector3& playerPos) const;
+    bool hasPath(const Vector3& from, const Vector3& to) const;
 
     // Check if spawn position is valid (not inside geometry)
     bool isValidSpawnPosition(const Vector3& pos) const;
@@ -67,6 +99,7 @@ private:
 
     Scene* scene;
     std::vector<Enemy*> managedEnemies;  // Enemies this manager spawned and controls
+    uint32_t nextEnemyId;                // given to the next spawn, never reused
 
     // Spawn parameters
     float spawnTimer;
@@ -78,9 +111,13 @@ private:
     // Enemy properties
     float enemySpeed;
 
+    Random spawnRandom;
+    Random wanderRandom;  // wander targets, for roaming enemies and for spawn path checks
+
     static constexpr float ENEMY_RADIUS = 1.1f;
     static constexpr float ENEMY_COLLISION_HEIGHT = 3.0f;
     static constexpr float ENEMY_STEP_HEIGHT = 1.0f;
+    static constexpr float PLAYER_RADIUS = 0.35f;  // matches Player::update()
 
     // Obstacle avoidance parameters (tunable)
     float avoidanceLookAhead;   // How far ahead to check for obstacles (default: 3.0)
@@ -90,6 +127,10 @@ private:
 
     const NavigationGrid* navigationGrid;
 
+    // Enemies per movement job; each may run A*, so keep chunks small
+    static constexpr size_t MOVE_GRAIN = 4;
+    std::vector<MoveTask> moveTasks;  // reused every tick
+
     struct EnemyPathInfo {
         std::vector<Vector3> path;
         size_t nextIndex = 0;
@@ -102,6 +143,12 @@ private:
     };
     std::unordered_map<Enemy*, EnemyPathInfo> pathInfo;
 
+    // Horde mode
+    bool hordeMode;
+    int hordeSpawnBatch;
+    EnemyHorde horde;
+    FlowField flowField;  // toward the player, rebuilt when they change cell
+
     // Player damage tracking
     float damageCooldown;     // Time until player can be damaged again
     float damagePerHit;       // Damage dealt per hit
@@ -0,0 +1,99 @@
+#pragma once
+#include "Matrix4.h"
+#include "ShaderProgram.h"
+#include "GameObject.h"
+#include "LevelOfDetail.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class Enemy;
+class GpuMesh;
+
+// Draws every snowman with one instanced call per part and detail level
+// (at most 12 * LevelOfDetail::LEVEL_COUNT calls, independent of enemy count).
+// Per-enemy position, yaw and body/head colors go into a per-instance vertex
+// buffer, sorted so enemies sharing a part's level are contiguous; the part
+// layout comes from prototype Enemies so it always matches drawImmediate().
+class EnemyRenderer {
+public:
+    // Matches the per-instance vertex attributes in the shader
+    struct Instance {
+        float position[3];
+        float yaw;           // radians, same convention as Enemy::getYaw()
+        float bodyColor[3];
+        float headColor[3];
+    };
+
+    EnemyRenderer();
+    ~EnemyRenderer();
+
+    // Needs a current GL context. Returns false when instancing or GLSL is not
+    // available; callers should then keep using drawImmediate().
+    bool initialize();
+    bool isSupported() const { return supported; }
+
+    static Instance makeInstance(Enemy& enemy);
+
+    // One enemy through the fixed-function path, health bar included
+    static void drawImmediate(Enemy& enemy);
+    // Queues the screen-space bar into HudBatch; it is drawn when the HUD is flushed
+    static void drawHealthBar(const Enemy& enemy);
+    // Re-selects every part's tessellation level from its size at the enemy's
+    // distance (the draw paths do this themselves)
+    static void updateLod(Enemy& enemy);
+
+    // lightingEnabled mirrors the Lighting on/off state (the shader reads
+    // GL_LIGHT0 parameters from the fixed-function state).
+    // Raw instances are drawn at full detail; the Enemy* overload updates each
+    // enemy's level of detail first.
+    void draw(const std::vector<Instance>& instances, bool lightingEnabled);
+    void draw(const std::vector<Enemy*>& enemies, bool lightingEnabled);
+    // Crowds kept without Enemy objects (EnemyHorde): each snowman gets one
+    // detail level for all its parts, from its whole projected size. ids are
+    // the members' EnemyHorde ids, parallel to instances and ascending; a
+    // member drawn last frame starts from its last level, for hysteresis.
+    void drawCrowd(const std::vector<Instance>& instances, const std::vector<uint32_t>& ids, bool lightingEnabled);
+
+    int getLastDrawCalls() const { return lastDrawCalls; }
+
+private:
+    struct Part {
+        GpuMesh* meshes[LevelOfDetail::LEVEL_COUNT];  // owned by MeshLibrary, kept alive by prototypes
+        Matrix4 model;        // part -> enemy-local space
+        float normalMatrix[9];
+        Color color;
+        int colorSource;      // 0 = part color, 1 = per-enemy body, 2 = per-enemy head
+    };
+
+    // Two bits per part, body in the highest bits, so sorting by key groups each part's levels
+    static int partLevel(uint32_t lodKey, int partIndex);
+
+    // Sorts frameSortBuffer by LOD key and draws it
+    void drawSorted(bool lightingEnabled);
+    void uploadInstances(const std::vector<Instance>& instances);
+    void drawBatches(const std::vector<Instance>& instances, const std::vector<uint32_t>* lodKeys, bool lightingEnabled);
+    void drawPartRange(const Part& part, int level, size_t first, size_t count);
+
+    std::unique_ptr<Enemy> prototypes[LevelOfDetail::LEVEL_COUNT];
+    std::vector<Part> parts;
+
+    // Reused by the Enemy* overload and drawCrowd()
+    std::vector<std::pair<uint32_t, Instance>> frameSortBuffer;
+    std::vector<Instance> frameInstances;
+    std::vector<uint32_t> frameLodKeys;
+    // Level per crowd member drawn last frame and this frame, ascending by id
+    std::vector<std::pair<uint32_t, int>> crowdLevels;
+    std::vector<std::pair<uint32_t, int>> previousCrowdLevels;
+    ShaderProgram program;
+    GLuint instanceBuffer;      // fallback when the stream ring is unavailable
+    size_t instanceCapacity;
+    GLuint drawInstanceBuffer;  // where this frame's instances live ...
+    size_t drawInstanceOffset;  // ... and at which byte offset
+    bool supported;
+    int lastDrawCalls;
+
+    GLint partMatrixLoc, partNormalMatrixLoc, partColorLoc, colorSourceLoc, lightingEnabledLoc;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include "NavigationGrid.h"
+#include <cstdint>
+#include <vector>
+
+// Shared pathing for a crowd heading to one goal: a single Dijkstra pass over
+// the NavigationGrid from the goal outwards gives every free cell its travel
+// cost and the direction of its cheapest neighbour. Any number of agents then
+// steer by one lookup each, instead of an A* search per agent.
+//
+// Moves are 8-way (diagonals cost sqrt 2) and never cut a blocked corner,
+// matching NavigationGrid::findPath(). The goal cell itself is seeded even
+// when blocked, so a player standing against a wall still draws the crowd.
+class FlowField {
+public:
+    FlowField();
+
+    // Recomputes the field for the goal's cell; a no-op when neither the grid
+    // nor the goal cell changed since the last build (call invalidate() after
+    // editing the grid in place). Returns whether anything was rebuilt.
+    bool build(const NavigationGrid& grid, float goalX, float goalZ);
+    void invalidate() { valid = false; }
+    bool isValid() const { return valid; }
+
+    // Unit direction (x, z) of travel from the cell holding (x, z). False in the
+    // goal cell and in cells that are blocked or cannot reach the goal; callers
+    // then head for the goal directly.
+    bool sample(float x, float z, float& outX, float& outZ) const;
+    bool isReachable(float x, float z) const;
+    // Path length in cells from (x, z) to the goal, or a negative value when unreachable
+    float distanceAt(float x, float z) const;
+
+    int getGoalX() const { return goalX; }
+    int getGoalZ() const { return goalZ; }
+    int getBuildCount() const { return buildCount; }
+
+private:
+    static constexpr int SIZE = NavigationGrid::GRID_SIZE;
+    static constexpr int CELL_COUNT = SIZE * SIZE;
+
+    int cellIndex(float x, float z) const;  // -1 outside the grid
+
+    const NavigationGrid* grid;
+    std::vector<float> distance;  // per cell, infinity when unreachable
+    std::vector<float> directionX;
+    std::vector<float> directionZ;
+    int goalX;
+    int goalZ;
+    bool valid;
+    int buildCount;
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <GL/glew.h>
+#include <memory>
+#include <vector>
+
+// One texture holding the printable ASCII glyphs of every GLUT bitmap font
+// in use. Each font is baked on first request by rendering its glyphs with
+// glutBitmapCharacter into the texture through a framebuffer object, so text
+// can then be drawn as textured quads instead of one raster call per glyph.
+//
+// The atlas also keeps a small solid-white block, so untextured quads can
+// share the same texture and draw call as text.
+class FontAtlas {
+public:
+    static constexpr int SIZE = 512;
+    static constexpr int FIRST_CHAR = 32;
+    static constexpr int LAST_CHAR = 126;
+    static constexpr int PADDING = 2;  // empty pixels around each glyph cell's pen box
+
+    // Atlas cell of one glyph. The pen origin sits PADDING pixels in from the
+    // cell's left edge and PADDING + descent pixels up from its bottom edge.
+    struct Glyph {
+        float u0, v0, u1, v1;
+        int width, height;  // cell size in pixels
+        int advance;        // pen advance in pixels
+    };
+
+    struct Font {
+        void* handle;
+        bool baked;
+        int descent;
+        int lineHeight;
+        Glyph glyphs[LAST_CHAR - FIRST_CHAR + 1];
+    };
+
+    FontAtlas();
+    ~FontAtlas();
+
+    FontAtlas(const FontAtlas&) = delete;
+    FontAtlas& operator=(const FontAtlas&) = delete;
+
+    // Bakes the font if needed. Needs a current GL context; returns nullptr
+    // (with a message the first time) without framebuffer object support or
+    // when the atlas is full, and callers then fall back to bitmap text.
+    const Font* getFont(void* font);
+
+    // Characters outside the baked range map to '?'
+    static const Glyph& glyphFor(const Font& font, char c);
+
+    GLuint getTexture() const { return texture; }
+    bool isReady() const { return texture != 0; }
+    void getWhiteTexel(float& u, float& v) const;
+
+
+private:
+    bool initialize();
+    bool bake(Font& font);
+
+    GLuint texture;
+    GLuint framebuffer;
+    bool failed;
+
+    // Shelf packer state
+    int shelfX;
+    int shelfY;
+    int shelfHeight;
+
+    std::vector<std::unique_ptr<Font>> fonts;
+};
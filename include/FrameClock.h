@@ -0,0 +1,53 @@
+#pragma once
+#include <chrono>
+
+// Fixed-step simulation clock.
+//
+// Each rendered frame, advance() adds the elapsed wall time to an
+// accumulator and returns how many whole FIXED_STEP ticks to simulate; the
+// leftover fraction of a tick is getAlpha(), which the renderer uses to
+// blend between the previous and the current simulation state. Simulation
+// speed is therefore independent of frame rate: slow frames run more ticks,
+// fast frames run none and only re-interpolate.
+//
+// At most MAX_STEPS_PER_FRAME ticks run per frame. Time beyond that is
+// dropped, so a long stall (window drag, breakpoint) slows the game down
+// for a moment instead of spiralling into ever longer catch-up frames.
+class FrameClock {
+public:
+    static constexpr float FIXED_STEP = 1.0f / 60.0f;  // seconds per simulation tick
+    static constexpr int MAX_STEPS_PER_FRAME = 5;
+
+    // VSYNC lets the swap wait for the display; UNCAPPED renders as fast as possible
+    enum class Pacing { VSYNC, UNCAPPED };
+
+    FrameClock();
+
+    // Restarts timing from now with an empty accumulator
+    void reset();
+
+    // Number of ticks to simulate this frame (0 .. MAX_STEPS_PER_FRAME)
+    int advance();
+
+    // Fraction of a tick the render state lies past the last simulated tick, in [0, 1)
+    float getAlpha() const { return static_cast<float>(accumulator / FIXED_STEP); }
+
+    long long getTotalSteps() const { return totalSteps; }
+    long long getTotalFrames() const { return totalFrames; }
+    double getDroppedSeconds() const { return droppedSeconds; }
+
+    // Sets the swap interval of the current GL context; false (with a
+    // message) when the platform offers no control, leaving the driver default
+    static bool setPacing(Pacing pacing);
+
+    void printStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point lastTime;
+    double accumulator;  // seconds not yet simulated
+    long long totalSteps;
+    long long totalFrames;
+    double droppedSeconds;
+};
@@ -0,0 +1,128 @@
+#pragma once
+#include <GL/glew.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Per-frame render pass graph. Each frame the passes are declared in
+// execution order with the targets they read and write; execute() then
+//   1. culls every pass whose outputs nothing consumes (walking back from
+//      the targets marked as outputs, plus passes with side effects),
+//   2. allocates the transient targets the survivors touch from a pool,
+//      holding each only from its first to its last use,
+//   3. runs the passes, binding the written target as draw framebuffer,
+//      the first read target as read framebuffer, and setting the pass's
+//      depth/blend/lighting state before it runs.
+class FrameGraph {
+public:
+    typedef int Resource;
+    typedef int PassId;
+
+    // Offscreen RGBA8 color texture, optionally with a 24-bit depth renderbuffer
+    struct TargetDesc {
+        int width;
+        int height;
+        bool depth;
+    };
+
+    // Fixed-function state established before a pass runs
+    struct PassState {
+        bool depthTest = true;
+        bool depthWrite = true;
+        bool blend = false;     // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+        bool lighting = true;   // false forces GL_LIGHTING off; true leaves it to Lighting::apply()
+        GLbitfield clear = 0;   // glClear mask applied to the written target first
+    };
+
+    struct Stats {
+        int passes;            // declared
+        int culled;            // skipped for lack of consumers
+        int transientTargets;  // pooled targets in use at the peak
+    };
+
+    // Frames a pooled target may go unused (e.g. after a resize) before it is freed
+    static constexpr unsigned int POOL_IDLE_FRAMES = 120;
+
+    FrameGraph();
+    ~FrameGraph();
+
+    FrameGraph(const FrameGraph&) = delete;
+    FrameGraph& operator=(const FrameGraph&) = delete;
+
+    // Framebuffer objects are needed for transient targets; without them only
+    // imported targets (the window) can be used
+    bool supportsTransientTargets() const;
+    // The draw framebuffer currently bound (0 = window), for importTarget()
+    static GLuint getBoundFramebuffer();
+
+    // Starts declaring a new frame
+    void reset();
+
+    Resource importTarget(const std::string& name, GLuint framebuffer, int width, int height);
+    Resource createTarget(const std::string& name, const TargetDesc& desc);
+    // Resources that must be produced this frame, e.g. the back buffer
+    void markOutput(Resource resource);
+
+    PassId addPass(const std::string& name, const PassState& state, std::function<void()> run);
+    void read(PassId pass, Resource resource);
+    void write(PassId pass, Resource resource);
+    // Passes with effects outside the graph (capture to file) are never culled
+    void setSideEffect(PassId pass, bool sideEffect = true);
+
+    void execute();
+
+    // Valid while the frame's passes run
+    GLuint getTexture(Resource resource) const;
+    GLuint getFramebuffer(Resource resource) const;
+
+    const Stats& getLastStats() const { return stats; }
+    // Pass list of the last frame, culled passes marked
+    void printStats() const;
+
+private:
+    struct ResourceEntry {
+        std::string name;
+        bool imported;
+        GLuint framebuffer;  // imported target, or the pooled one while allocated
+        int width;
+        int height;
+        TargetDesc desc;
+        int pooled;          // index into pool, -1 when not allocated
+        bool needed;
+        int firstUse;
+        int lastUse;
+    };
+
+    struct PassEntry {
+        std::string name;
+        PassState state;
+        std::function<void()> run;
+        std::vector<Resource> reads;
+        std::vector<Resource> writes;
+        bool sideEffect;
+        bool culled;
+    };
+
+    struct PooledTarget {
+        TargetDesc desc;
+        GLuint framebuffer;
+        GLuint color;
+        GLuint depth;
+        bool inUse;
+        unsigned int lastUsedFrame;
+    };
+
+    void cull();
+    int acquireTarget(const TargetDesc& desc);
+    void releaseTarget(int pooled);
+    void bindTargets(const PassEntry& pass);
+    void applyState(const PassState& state);
+    void trimPool();
+
+    std::vector<ResourceEntry> resources;
+    std::vector<PassEntry> passes;
+    std::vector<PooledTarget> pool;
+    std::vector<std::string> lastPassNames;  // culled ones prefixed with '-'
+    unsigned int frameIndex;
+    Stats stats;
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include "Vector3.h"
+#include "Matrix4.h"
+#include "GameState.h"
+#include <cstdint>
+#include <vector>
+
+class Scene;
+class EnemyHorde;
+class Player;
+class Camera;
+class CameraController;
+
+// Everything the renderer reads from the simulation for one frame: poses
+// (both ends of the last step, blended at alpha when drawn), colors, health
+// and HUD state. The simulation thread fills one with capture() after its
+// steps; from then on it is read-only until the main thread has drawn it, so
+// two of them are enough to let frame N render while frame N+1 simulates.
+// The vectors keep their capacity, so capturing allocates only as the world grows.
+struct FrameSnapshot {
+    struct EnemyState {
+        uint32_t id;  // Enemy::getId(), or EnemyHorde::getId() for horde members
+        Vector3 previousPosition;
+        Vector3 position;
+        float previousYaw;
+        float yaw;
+        Color bodyColor;
+        Color headColor;
+        float health;
+    };
+
+    struct BulletState {
+        Vector3 previousPosition;
+        Vector3 position;
+        Color color;
+    };
+
+    struct PlayerState {
+        Vector3 previousPosition;
+        Vector3 position;
+        Vector3 visionDirection;
+        Color bodyColor;
+        Color headColor;
+        float health;
+        bool visible;
+        bool testDraw;
+    };
+
+    uint32_t tick = 0;   // simulation steps completed when captured
+    float alpha = 1.0f;  // blend between the previous and current pose
+    GameState gameState = GameState::PLAYING;
+    bool playerInsideSafeZone = false;
+
+    std::vector<EnemyState> enemies;
+    std::vector<EnemyState> horde;  // EnemyManager's horde mode, in horde order
+    std::vector<BulletState> bullets;
+    std::vector<float> targetHealth;  // health fraction, parallel to Scene::getTargets()
+    PlayerState player = {};
+
+    // First- and third-person cameras, already interpolated at alpha. The
+    // free camera is driven by input alone and is read live instead.
+    Matrix4 firstPersonView;
+    Matrix4 firstPersonProjection;
+    Vector3 firstPersonEye;
+    Vector3 firstPersonLook;
+    Matrix4 thirdPersonView;
+    Matrix4 thirdPersonProjection;
+
+    void capture(Scene& scene, const EnemyHorde& liveHorde, Player& livePlayer, const Camera& camera,
+                 const CameraController& cameraController, GameState state, uint32_t simulationTick, float blend);
+};
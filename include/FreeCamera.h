@@ -2,6 +2,7 @@
 #include <GL/glew.h>
 #include <GL/glut.h>
 #include "GameObject.h"
+#include "CameraView.h"
 
 // Free Camera / Spectator Mode (Photo Mode)
 // Game-style detached camera for scene exploration
@@ -11,8 +12,12 @@ public:
     FreeCamera(float startX, float startY, float startZ);
     ~FreeCamera();
 
-    // Apply camera transformation to OpenGL
+    // Apply camera transformation to OpenGL (projection and view)
     void applyView();
+    Matrix4 getViewMatrix() const;
+    Matrix4 getProjectionMatrix() const { return perspective.matrix(); }
+    Matrix4 getViewProjectionMatrix() const { return getProjectionMatrix() * getViewMatrix(); }
+    void setPerspective(const Perspective& p) { perspective = p; }
 
     // Camera movement controls
     void orbit(float deltaAzimuth, float deltaElevation);
@@ -32,6 +37,7 @@ private:
     float azimuth;        // Horizontal angle (radians)
     float elevation;      // Vertical angle (radians)
     float distance;       // Distance from orbit target
+    Perspective perspective;
 
     // Update camera position from spherical coordinates
     void updatePosition();
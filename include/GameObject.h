@@ -14,8 +14,6 @@ public:
     GameObject(const Vector3& position, const Vector3& size, const Color& color);
     virtual ~GameObject() = default;  // Make GameObject polymorphic
 
-    virtual void draw() const;  // Make draw virtual so derived classes can override
-
     // Getters
     Vector3 getPosition() const { return position; }
     Vector3 getSize() const { return size; }
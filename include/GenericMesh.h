@@ -1,8 +1,6 @@
 #pragma once
 #include "Shapes.h"
 #include <vector>
-#include <GL/glew.h>
-#include <GL/glut.h>
 
 class GenericMesh : public Shape {
 public:
@@ -19,8 +17,15 @@ public:
     GenericMesh(Vector3 pos = Vector3(), Color col = Color());
     virtual ~GenericMesh();
 
-    // Render the mesh using immediate mode
-    void draw() override;
+    void accept(ShapeVisitor& visitor) override;
+    Matrix4 getModelMatrix() const override;
+    float getBoundingRadius() const override;
+
+    // Expose vertex data through the common Shape interface (GPU cache, OBJ export)
+    void tessellate(std::vector<Vector3>& positions,
+                    std::vector<Vector3>& normals,
+                    std::vector<int>& indices) const override;
+    void tessellateTexCoords(std::vector<Vector3>& texCoords) const override;
 
     // Set mesh data
     void setVertices(const std::vector<Vertex>& verts);
@@ -38,7 +43,6 @@ public:
 
     void bindTexture(Texture* texture, PartType type) {}
 
-    std::string getTextureName(PartType type = BOTH) {return "";}
     bool isValidPartType(PartType type) {return type == BOTH; }
 private:
     std::vector<Vertex> vertices;
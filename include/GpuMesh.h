@@ -0,0 +1,52 @@
+#pragma once
+#include "Vector3.h"
+#include <GL/glew.h>
+#include <vector>
+#include <cstddef>
+
+// Indexed triangle mesh resident in GPU buffer objects (VBO + IBO).
+// Vertices are interleaved (position, normal, texcoord) so a whole mesh, or a
+// contiguous range of its indices, is submitted with a single glDrawElements.
+class GpuMesh {
+public:
+    struct Vertex {
+        float position[3];
+        float normal[3];
+        float texCoord[2];
+    };
+
+    GpuMesh();
+    ~GpuMesh();
+
+    // Owns GL buffer names, so it must not be copied
+    GpuMesh(const GpuMesh&) = delete;
+    GpuMesh& operator=(const GpuMesh&) = delete;
+
+    // Upload tessellated geometry (replaces any previous contents).
+    // texCoords may be empty, in which case (0, 0) is used for every vertex.
+    void upload(const std::vector<Vector3>& positions,
+                const std::vector<Vector3>& normals,
+                const std::vector<Vector3>& texCoords,
+                const std::vector<int>& indices);
+    void release();
+
+    // bind() sets up the vertex arrays; drawRange() may then be called several
+    // times (e.g. caps and sides in different colors) before unbind().
+    void bind() const;
+    void drawRange(int firstIndex, int count) const;
+    void unbind() const;
+
+    // Convenience: bind, draw every index, unbind
+    void draw() const;
+
+    bool isValid() const { return vbo != 0 && ibo != 0; }
+    int getVertexCount() const { return vertexCount; }
+    int getIndexCount() const { return indexCount; }
+    size_t getMemoryBytes() const;
+
+private:
+    GLuint vbo;
+    GLuint ibo;
+    int vertexCount;
+    int indexCount;
+};
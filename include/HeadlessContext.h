@@ -0,0 +1,26 @@
+#pragma once
+
+// OpenGL context without a window or display server, for --benchmark on
+// machines that have neither (e.g. CI runners with Mesa's llvmpipe). It is
+// made current through EGL with no surface, so everything it draws must go
+// to a framebuffer object.
+//
+// Only built with EGL (FIRSTOGL_HEADLESS_EGL); elsewhere create() simply
+// fails and the caller falls back to a hidden GLUT window.
+class HeadlessContext {
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Creates a compatibility-profile context (the renderer still uses the
+    // fixed-function pipeline) and makes it current; false on failure
+    bool create();
+
+private:
+    // EGLDisplay and EGLContext, opaque so this header needs no EGL
+    void* display;
+    void* context;
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include "CameraView.h"
+#include "FontAtlas.h"
+#include "Vector3.h"
+#include <GL/glew.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Collects every screen-space HUD element of a frame (health bars, borders,
+// overlay panels, text) into one vertex stream and draws it with a single call
+// at the end of the frame. World anchors are projected on the CPU from camera
+// matrices handed over once per frame, so no GL state is read per element.
+//
+// Text is laid out from a FontAtlas into glyph quads that share the stream
+// (untextured quads sample the atlas's white texels). Laid-out strings are
+// cached by text, font and scale, so unchanged labels cost one lookup and a
+// copy per frame.
+//
+// Window coordinates have their origin at the bottom-left, like glOrtho(0, w, 0, h).
+class HudBatch {
+public:
+    static HudBatch& instance();
+
+    // Caches the camera for project(); call once per frame before queuing elements
+    void beginFrame(const CameraView& camera);
+
+    // False when the point is behind the camera
+    bool project(const Vector3& world, float& winX, float& winY) const;
+
+    int getViewportWidth() const { return camera.viewportWidth; }
+    int getViewportHeight() const { return camera.viewportHeight; }
+
+    void addQuad(float x0, float y0, float x1, float y1, const Color& color, float alpha = 1.0f);
+    // Vertical gradient from the bottom edge (y0) to the top edge (y1)
+    void addGradientQuad(float x0, float y0, float x1, float y1,
+                         const Color& bottom, float bottomAlpha, const Color& top, float topAlpha);
+    // Border centered on the rectangle's edges, built from four quads
+    void addRectOutline(float x0, float y0, float x1, float y1, float thickness,
+                        const Color& color, float alpha = 1.0f);
+    void addLine(float x0, float y0, float x1, float y1, float thickness, const Color& color, float alpha = 1.0f);
+
+    // Text in a GLUT bitmap font with its baseline starting at (x, y). Drawn
+    // in submission order with the quads; without framebuffer object support
+    // it falls back to glutBitmapCharacter after the quads.
+    void addText(float x, float y, void* font, const std::string& text, const Color& color, float scale = 1.0f);
+
+    // Draws everything queued this frame and clears the batch
+    void flush();
+
+    int getLastQuadCount() const { return lastQuadCount; }
+    int getCachedTextCount() const { return static_cast<int>(textCache.size()); }
+
+private:
+    struct Vertex {
+        GLfloat x, y;
+        GLfloat u, v;
+        GLubyte color[4];
+    };
+
+    // One glyph relative to the text origin, in pixels at the cached scale
+    struct GlyphQuad {
+        float x0, y0, x1, y1;
+        float u0, v0, u1, v1;
+    };
+
+    struct TextKey {
+        std::string text;
+        void* font;
+        float scale;
+        bool operator==(const TextKey& other) const {
+            return font == other.font && scale == other.scale && text == other.text;
+        }
+    };
+
+    struct TextKeyHash {
+        size_t operator()(const TextKey& key) const {
+            size_t h = std::hash<std::string>()(key.text);
+            h ^= std::hash<void*>()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<float>()(key.scale) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    struct TextMesh {
+        std::vector<GlyphQuad> quads;
+        unsigned int lastUsedFrame;
+    };
+
+    struct TextItem {
+        float x, y;
+        void* font;
+        std::string text;
+        Color color;
+    };
+
+    HudBatch();
+    void addVertex(float x, float y, float u, float v, const Color& color, float alpha);
+    TextMesh& layoutText(const FontAtlas::Font& font, const TextKey& key);
+    void evictUnusedText();
+
+    CameraView camera;
+    FontAtlas atlas;
+    float whiteU, whiteV;
+
+    std::vector<Vertex> vertices;
+    std::vector<TextItem> texts;  // fallback bitmap text
+    std::unordered_map<TextKey, TextMesh, TextKeyHash> textCache;
+    unsigned int frameIndex;
+    int lastQuadCount;
+};
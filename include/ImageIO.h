@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Decoded image, 8-bit RGBA, rows bottom to top as glTexImage2D expects
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+namespace ImageIO {
+    // Load an uncompressed 24- or 32-bit Windows bitmap.
+    // Byte-level parsing, so no platform headers are involved.
+    // Returns false (with a message) on failure
+    bool loadBMP(const std::string& filepath, Image& image);
+
+    // Load by extension; currently only .bmp
+    bool load(const std::string& filepath, Image& image);
+}
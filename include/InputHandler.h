@@ -8,6 +8,7 @@
 #include "Scene.h"
 
 class Lighting; // Forward declaration
+class SceneRenderer;
 
 class InputHandler {
 public:
@@ -17,13 +18,16 @@ public:
     void handleKeyRelease(unsigned char key);
     void handleSpecialKey(int key, int x, int y);  // For arrow keys, PageUp/PageDown
     void handleMouseClick(int button, int state, int x, int y);
+    // GLUT_ACTIVE_* keys held during the next click (captured by the caller, so replays carry them)
+    void setModifiers(int activeModifiers) { modifiers = activeModifiers; }
     void handleMouseWheel(int button, int state, int x, int y);
 
     // 鼠标移动的处理
     void handleMouseMotion(int x, int y);
 
     // 更新方法，处理移动和摄像机操作
-    void update();
+    // Runs once per fixed simulation step; deltaTime is the step length
+    void update(float deltaTime);
 
     void setMouseSensitivity(float sensitivity) { mouseSensitivity = sensitivity; }
     void setWindowSize(int width, int height);
@@ -36,6 +40,9 @@ public:
 
     // Lighting control
     void setLighting(Lighting* light) { lighting = light; }
+
+    // Render toggles (texture switch, batching, occlusion culling, stats)
+    void setSceneRenderer(SceneRenderer* renderer) { sceneRenderer = renderer; }
     
     // Edit mode related
     void toggleEditMode();  // Add this method declaration
@@ -43,7 +50,6 @@ public:
 
 private:
     void toggleMouseCapture();
-    float lastTime = 0.0f;
     float mouseX, mouseY; // 当前鼠标位置（窗口坐标）
     Camera* camera = nullptr;                  // 第一人称摄像机
     CameraController* camera_controller = nullptr;  // 第三人称摄像机
@@ -66,6 +72,8 @@ private:
     int dragStartX, dragStartY;
 
     Lighting* lighting;  // Not owned by InputHandler, just a reference
+    SceneRenderer* sceneRenderer;  // Not owned either
+    int modifiers;
     
     // Edit mode related members
     bool editMode = false;
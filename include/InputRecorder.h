@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// One window-system input, stamped with the simulation tick it was applied
+// before. Events between two ticks keep their arrival order.
+struct InputEvent {
+    enum Type : uint8_t {
+        KEY_DOWN = 1,      // code = ASCII key
+        KEY_UP = 2,        // code = ASCII key
+        SPECIAL_KEY = 3,   // code = GLUT_KEY_*
+        MOUSE_BUTTON = 4,  // code = button (3/4 are wheel up/down), state = GLUT_DOWN/UP
+        MOUSE_MOTION = 5,
+        RESIZE = 6         // x, y = new window width and height
+    };
+
+    uint32_t tick = 0;
+    uint8_t type = 0;
+    uint8_t code = 0;
+    uint8_t state = 0;
+    uint8_t modifiers = 0;  // GLUT_ACTIVE_* at the time of the event
+    int16_t x = 0;
+    int16_t y = 0;
+};
+
+// Session input log (.inputs) for reproducible runs:
+//   header  "INPR", version (uint32 LE), session seed (uint64 LE)
+//   events  12 bytes each: tick (uint32 LE), type, code, state, modifiers,
+//           x, y (int16 LE)
+// The simulation steps at a fixed rate and all randomness derives from the
+// seed, so feeding the events back at their ticks replays the session.
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    // Starts writing a new log; returns false (with a message) on failure
+    bool startRecording(const std::string& path, uint64_t seed);
+    void record(const InputEvent& event);
+    void stopRecording();
+    bool isRecording() const { return output.is_open(); }
+
+    // Reads a whole log for playback; returns false (with a message) on failure
+    bool loadReplay(const std::string& path);
+    bool isReplaying() const { return replayIndex < replayEvents.size(); }
+    uint64_t getReplaySeed() const { return replaySeed; }
+    // Next event due at or before tick, in recorded order; false once none is due
+    bool nextDue(uint32_t tick, InputEvent& event);
+    // Tick of the next event still to replay; false once the replay is over
+    bool peekTick(uint32_t& tick) const;
+
+private:
+    std::ofstream output;
+    std::string outputPath;
+    size_t recordedCount;
+
+    std::vector<InputEvent> replayEvents;
+    size_t replayIndex;
+    uint64_t replaySeed;
+};
@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+// Work-stealing job system for per-tick gameplay work.
+//
+// Each worker owns a Chase-Lev deque: it pushes and pops its own jobs at the
+// bottom (LIFO, cache-warm) while idle workers steal from the top of others'
+// (FIFO, the biggest remaining pieces). Threads outside the pool (the game's
+// simulation thread, sim_runner's main thread) get a deque of their own on
+// first use, up to MAX_EXTERNAL_THREADS of them, and help run jobs while
+// they wait. Work is grouped by Counter: run() raises it, finishing the job
+// lowers it, and wait() returns once it is zero, so a later phase can depend
+// on an earlier one without a lock.
+//
+// Jobs are plain function pointers over an index range, so queuing one never
+// allocates. A thread may have at most DEQUE_CAPACITY jobs queued; past that
+// run() executes the job on the spot.
+class JobSystem {
+public:
+    static constexpr int MAX_EXTERNAL_THREADS = 2;
+    static constexpr size_t DEQUE_CAPACITY = 1024;  // power of two
+
+    // Jobs still queued or running under it; zero means the group is done
+    class Counter {
+    public:
+        Counter() : pending(0) {}
+        bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+    private:
+        friend class JobSystem;
+        std::atomic<int> pending;
+    };
+
+    using Task = void (*)(const void* context, size_t begin, size_t end);
+
+    struct Stats {
+        long long jobs;    // jobs run, by workers and helping callers
+        long long steals;  // of those, taken from another thread's deque
+    };
+
+    static JobSystem& instance();
+
+    // Restarts the pool with this many worker threads besides the calling
+    // ones; 0 runs every job on the thread that waits for it. Only call
+    // while no jobs are in flight.
+    void setWorkerCount(int count);
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+    // Threads that share a parallelFor(): the workers plus the caller
+    int getThreadCount() const { return getWorkerCount() + 1; }
+
+    // Queues task(context, begin, end) under counter
+    void run(Task task, const void* context, size_t begin, size_t end, Counter& counter);
+    // Runs queued jobs on this thread until counter reaches zero
+    void wait(Counter& counter);
+
+    // Calls body(begin, end) over [0, count) in chunks of at least grain
+    // items (a few chunks per thread when count allows) and returns when all
+    // are done. The caller runs the first chunk itself.
+    template <typename Body>
+    void parallelFor(size_t count, size_t grain, const Body& body);
+
+    const Stats& getStats() const;
+    void resetStats();
+    void printStats() const;
+
+private:
+    struct Job {
+        Task task;
+        const void* context;
+        size_t begin;
+        size_t end;
+        Counter* counter;
+    };
+    struct Slot;  // one thread's deque and job storage (JobSystem.cpp)
+
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void startWorkers(int count);
+    void stopWorkers();
+    void workerLoop(int slotIndex);
+    Slot* currentSlot();
+    bool tryRunOne(Slot* own);
+    static void execute(const Job& job);
+
+    template <typename Body>
+    static void invokeBody(const void* context, size_t begin, size_t end) {
+        (*static_cast<const Body*>(context))(begin, end);
+    }
+
+    std::vector<std::unique_ptr<Slot>> slots;  // workers first, then external threads
+    std::vector<std::thread> workers;
+    std::atomic<int> externalSlotsUsed;
+    unsigned generation;  // bumped by setWorkerCount(), invalidates threads' cached slots
+
+    // Idle workers sleep here until run() queues something
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs;
+    std::atomic<int> sleepingWorkers;
+    bool stopping;
+
+    mutable Stats stats;
+};
+
+template <typename Body>
+void JobSystem::parallelFor(size_t count, size_t grain, const Body& body) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+    if (workers.empty() || count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    // Enough chunks to balance uneven items, never smaller than grain
+    size_t maxChunks = static_cast<size_t>(getThreadCount()) * 4;
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks > maxChunks) chunks = maxChunks;
+    size_t chunkSize = (count + chunks - 1) / chunks;
+
+    Counter counter;
+    for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        run(&JobSystem::invokeBody<Body>, &body, begin, end, counter);
+    }
+    body(0, chunkSize);
+    wait(counter);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "CameraView.h"
+#include "Vector3.h"
+
+// Picks a tessellation level for curved primitives (spheres, cylinders, cones)
+// from how large they appear on screen. Level 0 is full detail; each further
+// level cuts the slice count, down to MIN_SLICES for specks like bullets.
+class LevelOfDetail {
+public:
+    static constexpr int LEVEL_COUNT = 3;
+    static constexpr int MIN_SLICES = 6;
+
+    static LevelOfDetail& instance();
+
+    // Takes the camera position and pixel scale from the frame's camera and
+    // resets the per-frame counters. Call once per frame; until the first call
+    // every select() returns 0.
+    void beginFrame(const CameraView& camera);
+
+    // Approximate on-screen diameter, in pixels, of a world-space sphere
+    float projectedDiameter(const Vector3& center, float radius) const;
+
+    // Level for a sphere of the given size. The result only moves away from
+    // previousLevel once the size clears a level boundary by HYSTERESIS, so
+    // objects hovering near a boundary don't pop back and forth.
+    int select(const Vector3& center, float radius, int previousLevel) const;
+    int selectForSize(float pixelDiameter, int previousLevel) const;
+
+    // Slice (or stack) count for a level, given the full-detail count
+    static int slicesForLevel(int baseSlices, int level);
+
+    // Per-frame throughput, recorded by whoever issues the draw
+    void recordDraw(int level, int triangles, int instances = 1);
+    void printStats() const;
+
+private:
+    LevelOfDetail();
+    LevelOfDetail(const LevelOfDetail&) = delete;
+    LevelOfDetail& operator=(const LevelOfDetail&) = delete;
+
+    Vector3 cameraPosition;
+    float pixelsPerUnitAtDistanceOne;  // viewport height / (2 tan(fovy / 2))
+    bool frameValid;
+
+    int drawCounts[LEVEL_COUNT];
+    int triangleCounts[LEVEL_COUNT];
+};
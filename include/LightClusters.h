@@ -0,0 +1,86 @@
+#pragma once
+#include "Matrix4.h"
+#include "Vector3.h"
+#include <GL/glew.h>
+#include <vector>
+
+struct PointLight {
+    Vector3 position;  // world space
+    float radius;      // no contribution beyond this distance
+    Color color;
+    float intensity;
+};
+
+// Bins point lights into a view-space cluster grid (screen tiles x
+// exponential depth slices) on the CPU each frame, and hands the lit shader
+// compact per-cluster light lists through three texture buffers:
+//   light data     RGBA32F, two texels per light: (position, radius), (color * intensity)
+//   cluster grid   RG32UI, one texel per cluster: (first index, light count)
+//   light indices  R32UI, the concatenated per-cluster lists
+// A fragment then only loops over the lights of its own cluster.
+class LightClusters {
+public:
+    static constexpr int TILES_X = 16;
+    static constexpr int TILES_Y = 9;
+    static constexpr int SLICES = 24;
+    static constexpr int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+    static constexpr int MAX_LIGHTS = 512;
+
+    LightClusters();
+    ~LightClusters();
+
+    LightClusters(const LightClusters&) = delete;
+    LightClusters& operator=(const LightClusters&) = delete;
+
+    // Creates the buffers; false (with a message) without texture buffer support.
+    // Lights can be added before or after.
+    bool initialize();
+    bool isReady() const { return ready; }
+
+    // Returns the light's index, or -1 once MAX_LIGHTS is reached
+    int addLight(const PointLight& light);
+    void clearLights();
+    int getLightCount() const { return static_cast<int>(lights.size()); }
+
+    // Re-bins every light for this frame's camera and uploads the lists
+    void update(const Matrix4& view, const Matrix4& projection);
+
+    // Binds light data, cluster grid and light indices to firstUnit, +1, +2;
+    // leaves GL_TEXTURE0 active
+    void bindTextures(GLuint firstUnit) const;
+
+    // Near plane and slices per unit of log(depth / near), for the shader's slice lookup
+    float getNearPlane() const { return nearPlane; }
+    float getSliceScale() const { return sliceScale; }
+
+    void printStats() const;
+
+private:
+    struct ClusterRange {
+        int x0, x1, y0, y1, z0, z1;
+    };
+
+    bool binLight(const PointLight& light, const Matrix4& view, const Matrix4& projection,
+                  ClusterRange& range) const;
+    void uploadLights();
+
+    std::vector<PointLight> lights;
+    bool lightsDirty;
+
+    // Per-frame binning scratch, kept to avoid reallocating
+    std::vector<ClusterRange> ranges;
+    std::vector<char> rangeValid;
+    std::vector<GLuint> grid;     // (offset, count) pairs
+    std::vector<GLuint> indices;
+
+    GLuint buffers[3];
+    GLuint textures[3];
+    bool ready;
+
+    float nearPlane;
+    float farPlane;
+    float sliceScale;
+
+    int visibleLights;   // lights touching at least one cluster last frame
+    int maxPerCluster;
+};
@@ -1,14 +1,36 @@
 #pragma once
 #include <GL/glew.h>
 #include <GL/glut.h>
+#include "CameraView.h"
+#include "LightClusters.h"
+#include "Matrix4.h"
+#include "ShaderProgram.h"
 
 class Lighting {
 public:
+    // Uniform buffer binding point of the LightBlock shared by lit shaders
+    static constexpr GLuint LIGHT_BLOCK_BINDING = 0;
+
     Lighting();
     ~Lighting();
 
-    // Apply lighting state to OpenGL (call at start of each frame)
-    void apply();
+    // Builds the per-pixel lighting program and its uniform buffer. Needs a
+    // current GL context; on failure lit geometry stays on fixed-function GL_LIGHT0.
+    bool initializeShader();
+    bool isShaderReady() const { return shaderReady; }
+
+    // Apply lighting state to OpenGL (call at start of each frame, after the
+    // camera view is loaded). Light and material values are only re-uploaded
+    // when they changed.
+    void apply(const CameraView& camera);
+
+    // Binds the per-pixel lighting program for mesh drawing. Returns false
+    // (and binds nothing) when lighting is off or the shader is unavailable,
+    // in which case the caller draws through the fixed-function state as before.
+    bool beginShading(bool textured);
+    // Call whenever GL_TEXTURE_2D is toggled between beginShading() and endShading()
+    void setTextured(bool textured);
+    void endShading();
 
     // Update light position to follow camera (headlight mode)
     void updateHeadlight(float camX, float camY, float camZ, float lookX, float lookY, float lookZ);
@@ -31,7 +53,7 @@ public:
     // Light type: directional (w=0) vs point light (w=1)
     void setLightType(bool isPointLight);
     bool isPointLight() const { return pointLight; }
-    void toggleLightType() { pointLight = !pointLight; }
+    void toggleLightType() { pointLight = !pointLight; paramsDirty = true; }
 
     // Headlight mode (light follows camera)
     void setHeadlightMode(bool enable) { headlightMode = enable; }
@@ -40,6 +62,12 @@ public:
     // Attenuation parameters (for point lights)
     void setAttenuation(float constant, float linear, float quadratic);
 
+    // Extra point lights, shaded per pixel through LightClusters when the
+    // shader path supports it. Returns the light's index, or -1 when full.
+    int addPointLight(const Vector3& position, const Color& color, float radius, float intensity = 1.0f);
+    int getPointLightCount() const { return clusters.getLightCount(); }
+    void printClusterStats() const;
+
     // Print current lighting state to console
     void printStatus() const;
 
@@ -66,4 +94,24 @@ private:
 
     // Update OpenGL light parameters
     void updateLight();
+    void uploadLightBlock();
+    void uploadLightPosition(const GLfloat position[4]);
+
+    // GLSL path
+    ShaderProgram program;
+    GLuint lightBuffer;
+    GLint viewMatrixLoc;
+    GLint texturedLoc;
+    GLint clusterTileSizeLoc;
+    GLint clusterDepthLoc;
+    bool shaderReady;
+    bool clustersEnabled;  // shader was built with the cluster loop
+    bool shading;        // between beginShading() and endShading()
+    bool paramsDirty;    // light/material values changed since the last upload
+    bool positionDirty;  // only the light moved (headlight); rewrites just the block's position
+    Matrix4 viewMatrix;  // camera view passed to apply(); moves the light into eye space
+    int viewportWidth;   // for the shader's screen-tile lookup
+    int viewportHeight;
+
+    LightClusters clusters;
 };
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap, or MapViewOfFile on Windows)
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Returns false (with a message) when the file is missing, empty or cannot be mapped
+    bool open(const std::string& filepath);
+    void close();
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // Touches every page so later readers (e.g. a GL upload on the main
+    // thread) do not stall on page faults
+    void prefetch() const;
+
+private:
+    const unsigned char* bytes;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
@@ -0,0 +1,132 @@
+#pragma once
+#include "Vector3.h"
+#include <cmath>
+#include <cstddef>
+
+// 4x4 transform matrix stored column-major, matching glLoadMatrixf/glMultMatrixf.
+// Element (row r, column c) lives at m[c * 4 + r].
+// Multiplication and batch transforms use SSE where the target has it (Matrix4.cpp).
+struct Matrix4 {
+    float m[16];
+
+    Matrix4() { setIdentity(); }
+
+    void setIdentity() {
+        for (int i = 0; i < 16; i++) m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+
+    const float* data() const { return m; }
+    float& at(int row, int col) { return m[col * 4 + row]; }
+    float at(int row, int col) const { return m[col * 4 + row]; }
+
+    static Matrix4 identity() { return Matrix4(); }
+
+    static Matrix4 translation(const Vector3& t) {
+        Matrix4 r;
+        r.m[12] = t.x;
+        r.m[13] = t.y;
+        r.m[14] = t.z;
+        return r;
+    }
+
+    static Matrix4 scale(const Vector3& s) {
+        Matrix4 r;
+        r.m[0] = s.x;
+        r.m[5] = s.y;
+        r.m[10] = s.z;
+        return r;
+    }
+
+    // Same convention as glRotatef: angle in degrees, axis need not be normalized
+    static Matrix4 rotation(float angleDegrees, const Vector3& axis) {
+        Matrix4 r;
+        Vector3 a = axis.normalized();
+        float rad = angleDegrees * 3.14159265358979f / 180.0f;
+        float c = std::cos(rad);
+        float s = std::sin(rad);
+        float t = 1.0f - c;
+
+        r.at(0, 0) = a.x * a.x * t + c;
+        r.at(0, 1) = a.x * a.y * t - a.z * s;
+        r.at(0, 2) = a.x * a.z * t + a.y * s;
+        r.at(1, 0) = a.y * a.x * t + a.z * s;
+        r.at(1, 1) = a.y * a.y * t + c;
+        r.at(1, 2) = a.y * a.z * t - a.x * s;
+        r.at(2, 0) = a.z * a.x * t - a.y * s;
+        r.at(2, 1) = a.z * a.y * t + a.x * s;
+        r.at(2, 2) = a.z * a.z * t + c;
+        return r;
+    }
+
+    // Same matrix gluPerspective builds: vertical field of view in degrees
+    static Matrix4 perspective(float fovyDegrees, float aspect, float zNear, float zFar) {
+        Matrix4 r;
+        float f = 1.0f / std::tan(fovyDegrees * 3.14159265358979f / 360.0f);
+        r.at(0, 0) = f / aspect;
+        r.at(1, 1) = f;
+        r.at(2, 2) = (zFar + zNear) / (zNear - zFar);
+        r.at(2, 3) = 2.0f * zFar * zNear / (zNear - zFar);
+        r.at(3, 2) = -1.0f;
+        r.at(3, 3) = 0.0f;
+        return r;
+    }
+
+    // Same matrix gluLookAt builds
+    static Matrix4 lookAt(const Vector3& eye, const Vector3& center, const Vector3& up) {
+        Vector3 f = (center - eye).normalized();
+        Vector3 s = f.cross(up).normalized();
+        Vector3 u = s.cross(f);
+
+        Matrix4 r;
+        r.at(0, 0) = s.x;  r.at(0, 1) = s.y;  r.at(0, 2) = s.z;
+        r.at(1, 0) = u.x;  r.at(1, 1) = u.y;  r.at(1, 2) = u.z;
+        r.at(2, 0) = -f.x; r.at(2, 1) = -f.y; r.at(2, 2) = -f.z;
+        r.at(0, 3) = -s.dot(eye);
+        r.at(1, 3) = -u.dot(eye);
+        r.at(2, 3) = f.dot(eye);
+        return r;
+    }
+
+    Matrix4 operator*(const Matrix4& other) const;
+
+    // transformPoint() over an array; in and out may alias
+    void transformPoints(const Vector3* in, Vector3* out, size_t count) const;
+
+    Vector3 transformPoint(const Vector3& p) const {
+        return Vector3(
+            m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+            m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+            m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]
+        );
+    }
+
+    Vector3 transformDirection(const Vector3& d) const {
+        return Vector3(
+            m[0] * d.x + m[4] * d.y + m[8] * d.z,
+            m[1] * d.x + m[5] * d.y + m[9] * d.z,
+            m[2] * d.x + m[6] * d.y + m[10] * d.z
+        );
+    }
+
+    // Inverse transpose of the upper 3x3 (column-major, for glUniformMatrix3fv).
+    // Transforms normals correctly under non-uniform scale.
+    void normalMatrix(float out[9]) const {
+        float a = at(0, 0), b = at(0, 1), c = at(0, 2);
+        float d = at(1, 0), e = at(1, 1), f = at(1, 2);
+        float g = at(2, 0), h = at(2, 1), i = at(2, 2);
+
+        float det = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+        float invDet = std::fabs(det) > 1e-12f ? 1.0f / det : 0.0f;
+
+        // Transpose of the inverse is the cofactor matrix divided by det
+        out[0] = (e * i - f * h) * invDet;
+        out[1] = -(b * i - c * h) * invDet;
+        out[2] = (b * f - c * e) * invDet;
+        out[3] = -(d * i - f * g) * invDet;
+        out[4] = (a * i - c * g) * invDet;
+        out[5] = -(a * f - c * d) * invDet;
+        out[6] = (d * h - e * g) * invDet;
+        out[7] = -(a * h - b * g) * invDet;
+        out[8] = (a * e - b * d) * invDet;
+    }
+};
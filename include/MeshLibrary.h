@@ -0,0 +1,50 @@
+#pragma once
+#include "GpuMesh.h"
+#include <map>
+#include <memory>
+#include <functional>
+#include <vector>
+
+// Process-wide cache of unit-space primitive meshes.
+// Every sphere with the same slices/stacks is the same mesh once scaled, so shapes
+// hold shared references to one GpuMesh per key instead of owning their own buffers.
+class MeshLibrary {
+public:
+    enum MeshKind { CYLINDER_MESH, SPHERE_MESH, CUBE_MESH, CONE_MESH, PRISM_MESH, FRUSTUM_MESH };
+
+    struct Key {
+        MeshKind kind;
+        int slices;   // slices or polygon sides
+        int stacks;   // sphere stacks, 0 otherwise
+        int variant;  // shape-specific extra parameter (frustum top/bottom ratio * 1000)
+
+        Key(MeshKind k, int sl, int st = 0, int var = 0) : kind(k), slices(sl), stacks(st), variant(var) {}
+        bool operator<(const Key& other) const;
+    };
+
+    // Fills unit-space geometry for a key on first use
+    using Builder = std::function<void(std::vector<Vector3>& positions,
+                                       std::vector<Vector3>& normals,
+                                       std::vector<Vector3>& texCoords,
+                                       std::vector<int>& indices)>;
+
+    static MeshLibrary& instance();
+
+    // Returns the shared mesh for key, building and uploading it if not resident
+    std::shared_ptr<GpuMesh> acquire(const Key& key, const Builder& build);
+
+    // Free meshes no shape references any more; returns how many were released
+    int releaseUnused();
+    void clear();
+
+    int getMeshCount() const { return static_cast<int>(meshes.size()); }
+    size_t getMemoryBytes() const;
+    void printStats() const;
+
+private:
+    MeshLibrary() = default;
+    MeshLibrary(const MeshLibrary&) = delete;
+    MeshLibrary& operator=(const MeshLibrary&) = delete;
+
+    std::map<Key, std::shared_ptr<GpuMesh>> meshes;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include "Shapes.h"
+#include "ViewFrustum.h"
+#include <GL/glew.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Hardware occlusion culling behind a few large occluders (barn, house walls,
+// water tower). Each frame:
+//   1. beginFrame() collects the results of last frame's queries without
+//      stalling; a result that is not ready yet counts as visible.
+//   2. renderOccluders() lays the occluders down depth-only.
+//   3. query() draws a candidate's bounding box against that depth with an
+//      asynchronous GL_SAMPLES_PASSED query.
+//   4. endFrame() clears depth again so the real frame draws normally.
+// isOccluded() then answers from last frame's query: a candidate is skipped
+// only when its box produced no samples one frame ago, so anything new,
+// unknown or still pending is drawn (conservative temporal reuse).
+class OcclusionCuller {
+public:
+    // Boxes are grown by this much so an occluder never hides its own batch
+    static constexpr float BOX_MARGIN = 0.25f;
+    // Query objects of candidates not seen for this many frames are released
+    static constexpr unsigned int STALE_FRAMES = 60;
+    // Verdicts from queries older than this many frames are ignored
+    static constexpr unsigned int MAX_RESULT_AGE = 2;
+
+    struct Stats {
+        int occluders;  // drawn into the depth pre-pass
+        int queries;    // issued this frame
+        int occluded;   // candidates skipped this frame
+    };
+
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+    // Needs a current GL context; false (with a message) without occlusion queries
+    bool initialize();
+    bool isSupported() const { return supported; }
+
+    // Shapes large enough to hide others; picked from the scene's static shapes
+    static bool isOccluder(const Shape& shape);
+
+    void beginFrame(const Vector3& cameraPosition);
+    void renderOccluders(const std::vector<std::shared_ptr<Shape>>& occluders, const ViewFrustum& frustum);
+    void query(const void* key, const Vector3& boundsMin, const Vector3& boundsMax);
+    void endFrame();
+
+    // Last frame's verdict for key; counts towards getStats().occluded when true
+    bool isOccluded(const void* key);
+    // Drops key's slot, for a key that now stands for a different object
+    void forget(const void* key);
+
+    const Stats& getStats() const { return stats; }
+    int getTrackedCount() const { return static_cast<int>(slots.size()); }
+
+private:
+    struct Slot {
+        GLuint query = 0;
+        bool pending = false;   // issued, result not read yet
+        bool occluded = false;  // verdict of the last completed query
+        unsigned int issuedFrame = 0;
+        unsigned int verdictFrame = 0;  // issuedFrame of the query behind `occluded`
+        unsigned int lastSeenFrame = 0;
+    };
+
+    GLuint acquireQuery();
+    void drawBox(const Vector3& boundsMin, const Vector3& boundsMax) const;
+
+    std::unordered_map<const void*, Slot> slots;
+    std::vector<GLuint> freeQueries;
+    Vector3 cameraPosition;
+    unsigned int frameIndex;
+    bool supported;
+    bool inPrePass;
+    Stats stats;
+};
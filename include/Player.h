@@ -10,8 +10,6 @@ class Player
 public:
     enum PartType {BODY, HEAD};
     Player(Scene* scene) : scene(scene) {init();}
-    void draw();
-    void drawCoordinateAxes();
 
     void setPosition(Vector3 ipos) {position = ipos; updatePos();}
     void setColor(Color icolor, PartType part);
@@ -20,8 +18,14 @@ public:
     void setTestDraw(bool val) {testDraw = val;}
 
     Vector3 getPosition() {return position;}
+    Vector3 getRenderPosition() {return renderPosition;}
     Color getColor(PartType part) {return part == BODY ? body->getColor() : head->getColor();}
     Vector3 getVisionDirection() {return visionDirection;}
+    bool isVisible() const {return visible;}
+    bool isTestDraw() const {return testDraw;}
+    // Collision/draw parts at the simulated position
+    Shape* getBodyShape() {return body;}
+    Shape* getHeadShape() {return head;}
 
     void moveAbsolute(float dx, float dy, float dz);
     void updateVisionDirection(Vector3 dir) {visionDirection = dir.normalized();}
@@ -31,10 +35,17 @@ public:
     void update(float deltaTime);  // Update physics (gravity, jumping)
     void jump();  // Trigger jump
 
+    // Fixed-step interpolation: storePreviousState() before each simulation
+    // step, interpolate() once per rendered frame; drawing uses the blended position
+    void storePreviousState() {previousPosition = position;}
+    void interpolate(float alpha) {renderPosition = previousPosition + (position - previousPosition) * alpha;}
+    Vector3 getPreviousPosition() const {return previousPosition;}
+
     // Health system
     void takeDamage(float damage);
     void heal(float amount);
     void resetHealth();
+    void setHealth(float health) { currentHealth = health; }  // the renderer's stand-in mirrors a snapshot
     float getHealth() const { return currentHealth; }
     float getMaxHealth() const { return maxHealth; }
     float getHealthPercent() const { return currentHealth / maxHealth; }
@@ -49,14 +60,14 @@ private:
     Scene* scene;
 
     Vector3 position;
+    Vector3 previousPosition;  // position at the start of the current simulation step
+    Vector3 renderPosition;    // where the last interpolate() placed the drawn body
     Vector3 visionDirection;
     bool visible;
     bool testDraw;
 
     void init();
     void updatePos();
-    void drawDirection();
-    void drawHealthBar();  // Draw player health bar on screen
 
     bool checkCollision(const std::vector<std::shared_ptr<Shape>>& objects);
     friend class Enemy;
@@ -0,0 +1,82 @@
+#pragma once
+#include "Matrix4.h"
+#include "Vector3.h"
+#include <cmath>
+
+// Unit quaternion rotation (w + xi + yj + zk). Angles are in degrees to
+// match Matrix4::rotation and glRotatef.
+struct Quaternion {
+    float w, x, y, z;
+
+    Quaternion(float w = 1.0f, float x = 0.0f, float y = 0.0f, float z = 0.0f) : w(w), x(x), y(y), z(z) {}
+
+    static Quaternion identity() { return Quaternion(); }
+
+    static Quaternion fromAxisAngle(float angleDegrees, const Vector3& axis) {
+        Vector3 a = axis.normalized();
+        float half = angleDegrees * 3.14159265358979f / 360.0f;
+        float s = std::sin(half);
+        return Quaternion(std::cos(half), a.x * s, a.y * s, a.z * s);
+    }
+
+    // Applies other first, then this
+    Quaternion operator*(const Quaternion& o) const {
+        return Quaternion(w * o.w - x * o.x - y * o.y - z * o.z,
+                          w * o.x + x * o.w + y * o.z - z * o.y,
+                          w * o.y - x * o.z + y * o.w + z * o.x,
+                          w * o.z + x * o.y - y * o.x + z * o.w);
+    }
+
+    Quaternion conjugate() const { return Quaternion(w, -x, -y, -z); }
+
+    Quaternion normalized() const {
+        float len = std::sqrt(w * w + x * x + y * y + z * z);
+        if (len < 1e-12f) return Quaternion();
+        return Quaternion(w / len, x / len, y / len, z / len);
+    }
+
+    Vector3 rotate(const Vector3& v) const {
+        // v + 2w(q x v) + 2 q x (q x v), with q the vector part
+        Vector3 q(x, y, z);
+        Vector3 t = q.cross(v) * 2.0f;
+        return v + t * w + q.cross(t);
+    }
+
+    Matrix4 toMatrix() const {
+        Matrix4 r;
+        r.at(0, 0) = 1.0f - 2.0f * (y * y + z * z);
+        r.at(0, 1) = 2.0f * (x * y - w * z);
+        r.at(0, 2) = 2.0f * (x * z + w * y);
+        r.at(1, 0) = 2.0f * (x * y + w * z);
+        r.at(1, 1) = 1.0f - 2.0f * (x * x + z * z);
+        r.at(1, 2) = 2.0f * (y * z - w * x);
+        r.at(2, 0) = 2.0f * (x * z - w * y);
+        r.at(2, 1) = 2.0f * (y * z + w * x);
+        r.at(2, 2) = 1.0f - 2.0f * (x * x + y * y);
+        return r;
+    }
+
+    // Shortest-arc interpolation, t in [0, 1]
+    static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t) {
+        float cosTheta = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+        Quaternion end = b;
+        if (cosTheta < 0.0f) {
+            cosTheta = -cosTheta;
+            end = Quaternion(-b.w, -b.x, -b.y, -b.z);
+        }
+
+        float wa, wb;
+        if (cosTheta > 0.9995f) {
+            // Nearly parallel: lerp avoids dividing by a tiny sine
+            wa = 1.0f - t;
+            wb = t;
+        } else {
+            float theta = std::acos(cosTheta);
+            float sinTheta = std::sin(theta);
+            wa = std::sin((1.0f - t) * theta) / sinTheta;
+            wb = std::sin(t * theta) / sinTheta;
+        }
+        return Quaternion(a.w * wa + end.w * wb, a.x * wa + end.x * wb,
+                          a.y * wa + end.y * wb, a.z * wa + end.z * wb).normalized();
+    }
+};
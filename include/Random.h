@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+// Seedable PCG32 generator (XSH-RR output, 64-bit LCG state). Each system
+// owns its own Random on its own stream, so a session seed reproduces every
+// system's draws regardless of how many numbers the others consume.
+class Random {
+public:
+    // Stream ids; a (seed, stream) pair selects an independent sequence
+    enum Stream : uint64_t {
+        ENEMY_SPAWN = 1,   // spawn positions and colors
+        ENEMY_WANDER = 2,  // wander targets while the player hides in the safe zone
+        SIM_OBSTACLES = 3  // sim_runner's random obstacle layout
+    };
+
+    explicit Random(uint64_t seed = 0, uint64_t stream = 0) { reseed(seed, stream); }
+
+    void reseed(uint64_t seed, uint64_t stream = 0) {
+        state = 0;
+        increment = (stream << 1) | 1u;  // must be odd
+        nextU32();
+        state += seed;
+        nextU32();
+    }
+
+    uint32_t nextU32() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // Uniform in [0, 1), from the top 24 bits so every value is exact in a float
+    float nextFloat() {
+        return (nextU32() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Uniform in [minVal, maxVal)
+    float range(float minVal, float maxVal) {
+        return minVal + nextFloat() * (maxVal - minVal);
+    }
+
+private:
+    uint64_t state;
+    uint64_t increment;
+};
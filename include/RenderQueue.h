@@ -0,0 +1,83 @@
+#pragma once
+#include "GpuMesh.h"
+#include "Matrix4.h"
+#include "GameObject.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+class Lighting;
+
+// Collects draw packets for a frame, sorts them so packets sharing a texture,
+// color and mesh are adjacent, and only touches GL state that actually
+// changes between consecutive packets.
+//
+// Opaque packets are meshes sorted by (texture, material, mesh). Transparent
+// packets are callbacks sorted back to front and drawn with blending on and
+// depth writes off.
+class RenderQueue {
+public:
+    enum Pass { OPAQUE_PASS = 0, TRANSPARENT_PASS = 1 };
+
+    using DrawCallback = std::function<void()>;
+
+    struct Stats {
+        int packets;
+        int drawCalls;
+        int stateChangesUnsorted;  // what submission order would have needed
+        int stateChangesSorted;    // what was actually issued
+    };
+
+    RenderQueue();
+
+    // Drops last frame's packets and resets the stats
+    void begin(const Vector3& cameraPosition);
+
+    // indexCount indices starting at firstIndex, drawn with the model matrix
+    // multiplied onto the current modelview. texture 0 means untextured.
+    void submit(const GpuMesh& mesh, int firstIndex, int indexCount, const Matrix4& model,
+                GLuint texture, const Color& color);
+    void submitTransparent(const Vector3& center, DrawCallback draw);
+
+    // Sorts and draws every packet queued for pass, then clears them. Opaque
+    // packets go through lighting's per-pixel shader when one is given and active.
+    void execute(Pass pass, Lighting* lighting = nullptr);
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Packet {
+        uint64_t sortKey;
+        const GpuMesh* mesh;  // null for callback packets
+        int firstIndex;
+        int indexCount;
+        Matrix4 model;
+        GLuint texture;
+        Color color;
+        DrawCallback callback;
+    };
+
+    // What the GL currently has set, as far as the queue knows
+    struct TrackedState {
+        bool known;
+        bool textureEnabled;
+        GLuint texture;
+        Color color;
+        const GpuMesh* mesh;
+    };
+
+    uint64_t makeOpaqueKey(const GpuMesh& mesh, GLuint texture, const Color& color);
+    // Counts (and with issueGL, issues) the changes needed to draw packet.
+    // lighting, if set, is told about texture enable changes.
+    static int applyState(TrackedState& state, const Packet& packet, bool issueGL, Lighting* lighting);
+    static int countStateChanges(const std::vector<Packet>& packets);
+    void executeOpaque(Lighting* lighting);
+    void executeTransparent();
+
+    std::vector<Packet> packets[2];
+    std::map<const GpuMesh*, uint32_t> meshIds;  // stable small ids for sort keys
+    Vector3 cameraPosition;
+    Stats stats;
+};
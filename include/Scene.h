@@ -2,6 +2,7 @@
 #include "GameObject.h"
 #include "CollisionGrid.h"
 #include "NavigationGrid.h"
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -9,25 +10,51 @@ class Bullet; // Forward declaration
 class Target; // Forward declaration
 class Shape;
 class Enemy;
-class Texture;
-class Lighting; // Forward declaration
 
+// The game world: level geometry, enemies, bullets and targets plus the
+// collision and navigation queries gameplay runs against them. Contains no
+// GL; SceneRenderer draws it, and the headless sim_runner ticks it directly.
 class Scene {
 public:
+    // Translucent window glass, drawn in the renderer's transparent pass
+    struct GlassPanel {
+        Vector3 center;
+        float width;
+        float height;
+        bool facingX;
+        float normalSign;
+    };
+
+    // A level shape that wears one of getTexturePaths(); the renderer loads
+    // the images and binds them, so the simulation never touches image data
+    struct TextureBinding {
+        std::shared_ptr<Shape> shape;
+        int textureIndex;
+    };
+
+    static constexpr float SAFE_ZONE_RADIUS = 4.0f;
+
     Scene();
     ~Scene();
 
+    // Builds the level and its collision/navigation grids
     void initialize();
-    void draw() const;
     void update(float deltaTime);
+    // Fixed-step interpolation of the moving objects (enemies, bullets):
+    // storePreviousState() before each update(); FrameSnapshot copies both
+    // poses out and the renderer blends them
+    void storePreviousState();
     void addGameObject(GameObject* obj);
     void clearGameObjects();
+    // Appends level geometry; rebuild the collision and navigation grids once done
     void addShape(std::shared_ptr<Shape> shape);
-    void addTexture(Texture* texture);
     void addEnemy(Enemy* enemy);
 
     void setGroundSize(float size) { groundSize = size; }
     void setGroundColor(const Color& color) { groundColor = color; }
+    Color getGroundColor() const { return groundColor; }
+    float getWallHeight() const { return wallHeight; }
+    float getWallThickness() const { return wallThickness; }
 
     // Collision detection
     bool checkCollision(float x, float z, float radius) const;
@@ -45,6 +72,12 @@ public:
 
     const std::vector<std::shared_ptr<Shape>>& getObjects() const { return objects; }
     const std::vector<Enemy*>& getEnemies() const { return enemies; }
+    const std::vector<GameObject*>& getGameObjects() const { return gameObjects; }
+    const std::vector<Target*>& getTargets() const { return targets; }
+    const std::vector<Bullet*>& getBullets() const { return bullets; }
+    const std::vector<GlassPanel>& getGlassPanels() const { return glassPanels; }
+    const std::vector<std::string>& getTexturePaths() const { return texturePaths; }
+    const std::vector<TextureBinding>& getTextureBindings() const { return textureBindings; }
 
     // Grid-based collision detection for enemies
     const CollisionGrid& getCollisionGrid() const { return collisionGrid; }
@@ -58,54 +91,44 @@ public:
     void setPlayerInsideSafeZone(bool inside) { playerInsideSafeZone = inside; }
     bool isPlayerInsideSafeZone() const { return playerInsideSafeZone; }
 
-    // Lighting system
-    void setLighting(Lighting* light) { lighting = light; }
-    Lighting* getLighting() const { return lighting; }
-
     // Scene bounds calculation for camera zoom-to-fit
     void calculateSceneBounds(Vector3& center, float& radius) const;
 
-    void switchTexture();
-
 private:
-    void drawGround() const;
-    void drawBoundaryWalls() const;
-    void drawSafeZoneIndicator() const;
-    void drawGlassPanels() const;
     // void updateBullets(float deltaTime);
     void checkBulletCollisions();
 
+    // First thing a bullet hits, tested in the order walls, targets, enemies, shapes
+    struct BulletHit {
+        enum Type { NONE, WALL, TARGET, ENEMY, SHAPE } type;
+        size_t index;  // into targets or enemies
+    };
+    BulletHit findBulletHit(Bullet& bullet) const;
+    std::vector<BulletHit> bulletHits;  // per bullet, reused every tick
+    static constexpr size_t BULLET_GRAIN = 16;  // bullets per collision job
+
     std::vector<GameObject*> gameObjects;
     std::vector<Bullet*> bullets;
-    std::vector<Texture*> textures;
     std::vector<Target*> targets;
     std::vector<std::shared_ptr<Shape>> objects;
     std::vector<Enemy*> enemies;
 
-    struct GlassPanel {
-        Vector3 center;
-        float width;
-        float height;
-        bool facingX;
-        float normalSign;
-    };
     std::vector<GlassPanel> glassPanels;
     void addGlassPanel(const Vector3& center, float width, float height, bool facingX, float normalSign);
 
+    std::vector<std::string> texturePaths;
+    std::vector<TextureBinding> textureBindings;
+    int addTexturePath(const std::string& path);
+    void bindTexture(std::shared_ptr<Shape> shape, int textureIndex);
+
     float groundSize;
     Color groundColor;
     float wallHeight;
     float wallThickness;
 
-    Lighting* lighting;  // Not owned by Scene, just a reference
-
     // Grid-based collision detection
     CollisionGrid collisionGrid;
     NavigationGrid navigationGrid;
 
-    static constexpr float SAFE_ZONE_RADIUS = 4.0f;
-    static constexpr float SAFE_ZONE_LIGHT_HEIGHT = 15.0f;
-    static constexpr int SAFE_ZONE_CIRCLE_SEGMENTS = 64;
-
     bool playerInsideSafeZone;
 };
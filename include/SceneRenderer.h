@@ -0,0 +1,144 @@
+#pragma once
+#include "Scene.h"
+#include "CullingGrid.h"
+#include "StaticBatcher.h"
+#include "RenderQueue.h"
+#include "OcclusionCuller.h"
+#include "ViewFrustum.h"
+#include "FrameSnapshot.h"
+#include "EnemyRenderer.h"
+#include <vector>
+#include <memory>
+
+class Player;
+class Enemy;
+class Sphere;
+class Target;
+class Texture;
+class Lighting;
+
+// Draws a Scene: view and occlusion culling, static batches, the render queue
+// and the instanced snowmen. Owns every GL resource derived from the scene;
+// the Scene itself stays GL-free so gameplay also runs headless.
+//
+// Moving things (enemies, bullets, the player, target health) are drawn from
+// a FrameSnapshot rather than the live objects, which the simulation thread
+// may be stepping while a frame renders. Static shapes are read from the scene.
+class SceneRenderer {
+public:
+    // View-culling results of the last drawOpaque(), summed over all culled collections
+    struct CullStats {
+        int submitted;  // objects that passed the frustum test and were drawn
+        int culled;     // objects skipped because they were entirely off screen or occluded
+        int occluded;   // the part of culled hidden behind occluders
+    };
+
+    explicit SceneRenderer(Scene& scene);
+    ~SceneRenderer();
+
+    // Needs a current GL context; call after Scene::initialize(). Requests the
+    // scene's textures and builds the culling structures.
+    void initialize();
+
+    // Points the enemy, bullet and player stand-ins at a snapshot's state,
+    // blended at its alpha; call once per frame before drawOpaque()
+    void applySnapshot(const FrameSnapshot& snapshot);
+
+    // Culls against camera and draws everything opaque (the render queue's frame starts here)
+    void drawOpaque(const CameraView& camera) const;
+    // Blended surfaces, back to front; must follow drawOpaque() in the same frame
+    void drawTransparent() const;
+    // Player model at its interpolated position plus its HUD health bar
+    void drawPlayer() const;
+
+    // Static shapes are culled through a coarse grid; rebuild after moving them.
+    // Shapes appended to the scene are picked up on the next frame.
+    void rebuildCullingGrid();
+
+    // Static shapes are merged into a few world-space batches; edits to a shape
+    // are picked up automatically and only rebuild the batch holding it
+    void rebuildStaticBatches();
+    void toggleStaticBatching();
+    bool isStaticBatchingEnabled() const { return staticBatchingEnabled; }
+    // Skips shapes, targets and enemies hidden behind large occluders
+    void toggleOcclusionCulling();
+    bool isOcclusionCullingEnabled() const { return occlusionCullingEnabled; }
+    const CullStats& getCullStats() const { return cullStats; }
+    void printRenderStats() const;
+
+    // Lighting system; also registers the scene's point lights with it
+    void setLighting(Lighting* light);
+    Lighting* getLighting() const { return lighting; }
+
+    // Cycles the texture on the first crate through the scene's textures
+    void switchTexture();
+
+private:
+    static constexpr float SAFE_ZONE_LIGHT_HEIGHT = 15.0f;
+    static constexpr int SAFE_ZONE_CIRCLE_SEGMENTS = 64;
+    static constexpr float SAFE_ZONE_GLOW_RADIUS = 9.0f;
+    static constexpr float TARGET_HEALTH_BAR_CLEARANCE = 0.7f;  // matches drawTargetHealthBar()
+
+    void drawGround() const;
+    void drawBoundaryWalls() const;
+    void drawSafeZoneIndicator() const;
+    void drawGlassPanel(const Scene::GlassPanel& panel) const;
+    void drawGameObject(const GameObject& object) const;
+    void drawTarget(const Target& target, float healthPercent) const;
+    void drawTargetHealthBar(const Target& target, float healthPercent) const;
+    void drawPlayerDirection(Player& player) const;
+    void drawPlayerAxes(Player& player) const;
+    void drawPlayerHealthBar(const Player& player) const;
+    // Frustum-culls the snapshot's horde and draws it as one instanced crowd
+    void drawHorde() const;
+    void getTargetBounds(const Target& target, Vector3& boxMin, Vector3& boxMax) const;
+    // Depth pre-pass plus one query per frustum-visible candidate
+    void issueOcclusionQueries() const;
+
+    Scene& scene;
+    std::vector<Texture*> textures;  // parallel to Scene::getTexturePaths(), owned by TextureCache
+
+    Lighting* lighting;  // Not owned, just a reference
+
+    // Render-side copies of the moving objects, synced by applySnapshot().
+    // The pools only grow; the first enemyCount/bulletCount entries are live.
+    std::vector<std::unique_ptr<Enemy>> enemyProxies;
+    size_t enemyCount;
+    std::vector<std::unique_ptr<Sphere>> bulletProxies;
+    size_t bulletCount;
+    std::unique_ptr<Player> playerProxy;
+    std::vector<float> targetHealth;  // parallel to Scene::getTargets()
+    // Horde members are too many for stand-ins: drawHorde() blends them
+    // straight from the snapshot, which stays untouched until drawn
+    const std::vector<FrameSnapshot::EnemyState>* hordeStates;
+    float hordeAlpha;
+    std::unique_ptr<Enemy> hordeProxy;  // draws them one by one without instancing
+    bool playerInsideSafeZone;
+
+    // Instanced snowman drawing (falls back to EnemyRenderer::drawImmediate when unsupported)
+    std::unique_ptr<EnemyRenderer> enemyRenderer;
+
+    // View culling, refreshed by drawOpaque(); the grid is rebuilt lazily once
+    // the scene holds more shapes than it was built from
+    mutable CullingGrid cullingGrid;
+    mutable size_t cullingGridShapes;
+    mutable ViewFrustum viewFrustum;
+    mutable CullStats cullStats;
+    mutable std::vector<int> visibleObjects;
+    mutable std::vector<Enemy*> visibleEnemies;
+    mutable std::vector<EnemyRenderer::Instance> visibleHorde;
+    mutable std::vector<uint32_t> visibleHordeIds;  // parallel to visibleHorde
+
+    // Draws the scene's shapes when enabled; otherwise they go through cullingGrid one by one
+    mutable StaticBatcher staticBatcher;
+    bool staticBatchingEnabled;
+
+    // Sorts bullets, unbatched shapes and transparent surfaces each frame
+    mutable RenderQueue renderQueue;
+
+    // Occluders are the large static shapes, re-picked when shapes are added
+    mutable OcclusionCuller occlusionCuller;
+    mutable std::vector<std::shared_ptr<Shape>> occluders;
+    mutable size_t occluderShapes;
+    bool occlusionCullingEnabled;
+};
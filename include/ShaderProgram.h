@@ -0,0 +1,39 @@
+#pragma once
+#include <GL/glew.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+// GLSL vertex + fragment program.
+// Build errors are printed to std::cerr and reported through the return value,
+// so callers can fall back to the fixed-function path.
+class ShaderProgram {
+public:
+    ShaderProgram();
+    ~ShaderProgram();
+
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+    // attributeLocations are bound before linking (generic attribute index, name)
+    bool build(const std::string& name,
+               const char* vertexSource,
+               const char* fragmentSource,
+               const std::vector<std::pair<GLuint, const char*>>& attributeLocations = {});
+    void release();
+
+    void use() const { glUseProgram(programID); }
+    static void useNone() { glUseProgram(0); }
+
+    GLint getUniformLocation(const char* uniformName) const;
+    // Points a uniform block at a GL_UNIFORM_BUFFER binding point; false if the block is missing
+    bool bindUniformBlock(const char* blockName, GLuint bindingPoint) const;
+    bool isValid() const { return programID != 0; }
+    GLuint getID() const { return programID; }
+
+private:
+    GLuint compile(GLenum stage, const char* source);
+
+    GLuint programID;
+    std::string name;
+};
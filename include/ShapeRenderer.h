@@ -0,0 +1,31 @@
+#pragma once
+#include "Shapes.h"
+
+class GpuMesh;
+class RenderQueue;
+
+// Draws the GL-free Shape hierarchy. Each function dispatches on the concrete
+// shape through Shape::accept(), so the per-type GL code lives here instead of
+// in the shapes themselves.
+namespace ShapeRenderer {
+
+// Immediate draw under the current modelview matrix
+void draw(Shape& shape);
+
+// Cube of edge 1 centered on the origin, like glutSolidCube(1.0), drawn from
+// the cube mesh Cube shapes share; needs no GLUT
+void drawUnitCube();
+
+// Queues what draw() would draw: same mesh, transform, texture and color
+void submit(Shape& shape, RenderQueue& queue);
+
+// GPU mesh for the shape's current detail level, acquired on first use or
+// after a geometry change. Primitives share a unit-space mesh through
+// MeshLibrary that getModelMatrix() scales; other shapes own their buffers.
+GpuMesh& ensureMesh(Shape& shape);
+
+// Re-selects the detail level (with hysteresis) as if the shape were centered
+// at worldCenter. draw() and submit() call this themselves for auto-LOD shapes.
+void updateLod(Shape& shape, const Vector3& worldCenter);
+
+}  // namespace ShapeRenderer
@@ -0,0 +1,37 @@
+#pragma once
+#include "Vector3.h"
+#include <vector>
+
+// Triangle meshes of the curved and polygonal primitives, shared by the
+// shapes' own tessellate() and by the renderer, which builds one unit-space
+// mesh per detail level and scales it per shape.
+namespace ShapeTessellation {
+
+// Cone with its base at y = 0 and apex at y = height
+void tessellateCone(int slices, float baseRadius, float height,
+                    std::vector<Vector3>& positions,
+                    std::vector<Vector3>& normals,
+                    std::vector<int>& indices);
+
+// Capped n-sided prism (equal radii) or frustum with its bottom at y = 0
+void tessellatePolygonalFrustum(int sides, float bottomRadius, float topRadius, float height,
+                                std::vector<Vector3>& positions,
+                                std::vector<Vector3>& normals,
+                                std::vector<int>& indices);
+
+// Unit cylinder: radius 1, y in [-0.5, 0.5]. Cap triangles come first, so
+// the first slices * 6 indices are the caps and the rest the side.
+void tessellateUnitCylinder(int slices,
+                            std::vector<Vector3>& positions,
+                            std::vector<Vector3>& normals,
+                            std::vector<int>& indices);
+void unitCylinderTexCoords(int slices, std::vector<Vector3>& texCoords);
+
+// Unit sphere around the z axis
+void tessellateUnitSphere(int slices, int stacks,
+                          std::vector<Vector3>& positions,
+                          std::vector<Vector3>& normals,
+                          std::vector<int>& indices);
+void unitSphereTexCoords(int slices, int stacks, std::vector<Vector3>& texCoords);
+
+}  // namespace ShapeTessellation
@@ -1,17 +1,45 @@
 #pragma once
 #include "GameObject.h"
-#include <GL/glew.h>
 #include <string>
 #include <sstream>
 #include <variant>
 #include <vector>
-#include "Texture.h"
+#include <memory>
+#include "Matrix4.h"
+
+// Shapes are pure geometry and material data so the simulation builds without
+// GL. Drawing lives in ShapeRenderer, which reaches the concrete type through
+// accept(); textures and GPU meshes are only carried as opaque pointers.
+class Texture;
+class GpuMesh;
+class ShapeVisitor;
 
 class Shape {
 public:
     enum ShapeType {CYLINDER, SPHERE, CUBE, GENERIC_MESH};
     Shape(Vector3 ipos = Vector3(), Vector3 isize = Vector3(), Color icol = Color());
-    virtual void draw() = 0;
+    virtual ~Shape();
+    // Calls the visitor's overload for the concrete shape type
+    virtual void accept(ShapeVisitor& visitor) = 0;
+
+    // GPU mesh slot owned by the renderer (see ShapeRenderer::ensureMesh). The
+    // shape only marks it stale when its geometry or detail level changes.
+    struct MeshCache {
+        std::shared_ptr<GpuMesh> mesh;
+        bool dirty = true;
+    };
+    MeshCache& getMeshCache() { return meshCache; }
+
+    // Maps the renderer's mesh into world space. Primitives share a unit-space
+    // mesh per detail level, so this includes their scale.
+    virtual Matrix4 getModelMatrix() const { return Matrix4::translation(pos); }
+    // Radius of a sphere around getPosition() that encloses the drawn shape (for culling).
+    // size holds full extents for most shapes, so half its diagonal is enough.
+    virtual float getBoundingRadius() const { return 0.5f * size.length(); }
+
+    // Maps tessellate() output into world space. Same as getModelMatrix() unless
+    // the renderer scales a differently sized shared mesh.
+    virtual Matrix4 getTessellationMatrix() const { return getModelMatrix(); }
 
     // Tessellate shape into vertices, normals, and triangle indices (local space)
     virtual void tessellate(std::vector<Vector3>& positions,
@@ -23,10 +51,37 @@ public:
         indices.clear();
     }
 
-    void setColor(Color icolor) {color = icolor;}
-    void setPosition(Vector3 ipos) {pos = ipos;}
-    void setSize(Vector3 isize) {size = isize;}
-    void setAxis(Vector3 iaxis, float iaxisAngle) { axis = iaxis; axisAngle = iaxisAngle; }
+    // Texture coordinates (u, v, 0) matching the vertex order of tessellate().
+    // Empty for shapes that are never textured.
+    virtual void tessellateTexCoords(std::vector<Vector3>& texCoords) const {
+        texCoords.clear();
+    }
+
+    // Per-vertex colors matching tessellate(), as the renderer would apply them
+    virtual void tessellateColors(std::vector<Color>& colors, size_t vertexCount) const {
+        colors.assign(vertexCount, color);
+    }
+
+    // Texture the shape is drawn with, or nullptr when it is drawn untextured
+    virtual Texture* getActiveTexture() const { return nullptr; }
+
+    // Bumped by every setter that changes how the shape looks, so data built
+    // from it (static batches) can tell when it is stale
+    unsigned int getRevision() const { return revision; }
+
+    // Tessellation level (0 = full detail, see LevelOfDetail). Curved primitives
+    // have the renderer re-select it from their projected size unless a level is fixed.
+    void setLodLevel(int level);  // fixes the level and turns automatic selection off
+    void setAutoLod(bool enabled) { autoLod = enabled; }
+    bool isAutoLod() const { return autoLod; }
+    int getLodLevel() const { return lodLevel; }
+    // Stores a level picked by automatic selection, which stays on
+    void selectLodLevel(int level);
+
+    void setColor(Color icolor) {color = icolor; markChanged();}
+    void setPosition(Vector3 ipos) {pos = ipos; markChanged();}
+    void setSize(Vector3 isize) {size = isize; invalidateMesh();}
+    void setAxis(Vector3 iaxis, float iaxisAngle) { axis = iaxis; axisAngle = iaxisAngle; markChanged(); }
 
     Color getColor() const {return color;}
     Vector3 getPosition() const {return pos;}
@@ -37,10 +92,15 @@ public:
 
     enum PartType {SIDE=0, CAP=1, BOTH=2};
     virtual void bindTexture(Texture* texture, PartType type = BOTH) = 0;
-    void setTextureMode(bool enabled) { textureEnabled = enabled; }
-    virtual std::string getTextureName(PartType type = BOTH) = 0;
+    void setTextureMode(bool enabled) { textureEnabled = enabled; markChanged(); }
+    // Texture bound to a part, whether or not texturing is switched on
+    virtual Texture* getBoundTexture(PartType type = BOTH) const { return nullptr; }
     virtual bool isValidPartType(PartType type) = 0;
 protected:
+    // Cached GPU geometry, re-acquired only after invalidateMesh()
+    void invalidateMesh() { meshCache.dirty = true; markChanged(); }
+    void markChanged() { revision++; }
+
     ShapeType type;
     Vector3 pos, size;
     Vector3 axis;
@@ -49,6 +109,13 @@ protected:
     CollisionType collisionType;
 
     bool textureEnabled;
+
+    int lodLevel;
+    bool autoLod;
+
+private:
+    MeshCache meshCache;
+    unsigned int revision;
 };
 
 class Cylinder : public Shape {
@@ -57,22 +124,29 @@ public:
     Cylinder(Vector3 ipos, float ih, float idiameter, Color icol = Color());
     Cylinder(Vector3 ipos, float ih, float idiameter, Color icolSide, Color icolCap);
     Cylinder(Vector3 ipos, float ih, float idiameter, Vector3 iaxis, float iaxisAngle);
-    void draw();
+    void accept(ShapeVisitor& visitor) override;
+    Matrix4 getModelMatrix() const override;
     void tessellate(std::vector<Vector3>& positions,
                    std::vector<Vector3>& normals,
                    std::vector<int>& indices) const override;
+    void tessellateTexCoords(std::vector<Vector3>& texCoords) const override;
+    void tessellateColors(std::vector<Color>& colors, size_t vertexCount) const override;
+    Texture* getActiveTexture() const override;
 
-    void setSlices(int s) { slices = s;}
+    void setSlices(int s) { slices = s; invalidateMesh(); }
+    int getSlices() const { return slices; }
     void bindTexture(Texture* texture, enum PartType type);
     void setColor(Color icolor, enum PartType type = BOTH);
     // void setTextureMode(bool enabled) { textureEnabled = enabled; }
 
     Vector3 getPosition() {return pos;}
     Vector3 getSize() {return size;}
+    Color getSideColor() const {return colorSide;}
+    Color getCapColor() const {return colorCap;}
     Vector3 getTopCenter() {return pos + axis * (height / 2.0f);}
     Vector3 getBottomCenter() {return pos - axis * (height / 2.0f);}
     float getBoundingSphereRadius() {return std::sqrt(radius * radius + height * height / 4.0f);}
-    std::string getTextureName(enum PartType type);
+    Texture* getBoundTexture(PartType type = BOTH) const override;
     bool isValidPartType(PartType type);
 private:
     Vector3 axis;
@@ -88,20 +162,26 @@ class Sphere : public Shape {
 public:
     Sphere(Vector3 ipos, float idiameter, Color icol = Color());
     Sphere(Vector3 ipos, float idiameter, Vector3 iRotationAxis, float iRotationAngle, Color icol);
-    void draw();
+    void accept(ShapeVisitor& visitor) override;
+    Matrix4 getModelMatrix() const override;
     void tessellate(std::vector<Vector3>& positions,
                    std::vector<Vector3>& normals,
                    std::vector<int>& indices) const override;
+    void tessellateTexCoords(std::vector<Vector3>& texCoords) const override;
+    void tessellateColors(std::vector<Color>& colors, size_t vertexCount) const override;
+    Texture* getActiveTexture() const override;
 
-    void setSlices(int slice, int snack) { slices = slice; stacks = snack; }
+    void setSlices(int slice, int snack) { slices = slice; stacks = snack; invalidateMesh(); }
+    int getSlices() const { return slices; }
+    int getStacks() const { return stacks; }
     void bindTexture(Texture* itexture, PartType type) { texture = itexture; setTextureMode(true); }
-    void setColor(Color icolor) {color = icolor;}
+    void setColor(Color icolor) {color = icolor; markChanged();}
     // void setTextureMode(bool enabled) { textureEnabled = enabled; }
-    void setRotation(Vector3 iRotationAxis, float iRotationAngle) { axis = iRotationAxis; axisAngle = iRotationAngle; }
+    void setRotation(Vector3 iRotationAxis, float iRotationAngle) { axis = iRotationAxis; axisAngle = iRotationAngle; markChanged(); }
 
     Vector3 getPosition() {return pos;}
     float getRadius() {return radius;}
-    std::string getTextureName(PartType type = BOTH);
+    Texture* getBoundTexture(PartType type = BOTH) const override { return texture; }
     bool isValidPartType(PartType type);
 private:
     Vector3 axis;
@@ -115,18 +195,23 @@ private:
 class Cube : public Shape {
 public:
     Cube(Vector3 ipos, Vector3 isize, Color icol = Color());
-    void draw();
+    void accept(ShapeVisitor& visitor) override;
+    Matrix4 getModelMatrix() const override;
+    float getBoundingRadius() const override { return size.length(); }  // size holds half extents
     void tessellate(std::vector<Vector3>& positions,
                    std::vector<Vector3>& normals,
                    std::vector<int>& indices) const override;
+    void tessellateTexCoords(std::vector<Vector3>& texCoords) const override;
+    void tessellateColors(std::vector<Color>& colors, size_t vertexCount) const override;
+    Texture* getActiveTexture() const override;
 
-    void setColor(Color icolor) {color = icolor;}
+    void setColor(Color icolor) {color = icolor; markChanged();}
     void bindTexture(Texture* itexture, PartType type) {texture = itexture; setTextureMode(true);}
     // void setTextureMode(bool enabled) { textureEnabled = enabled;}
 
     Vector3 getPosition() {return pos;}
     Vector3 getSize() {return size;}
-    std::string getTextureName(PartType type = BOTH);
+    Texture* getBoundTexture(PartType type = BOTH) const override { return texture; }
     bool isValidPartType(PartType type);
 private:
     Texture *texture;
@@ -137,19 +222,21 @@ private:
 class Cone : public Shape {
 public:
     Cone(Vector3 ipos, float height, float baseDiameter, Color icol = Color());
-    void draw();
+    void accept(ShapeVisitor& visitor) override;
+    Matrix4 getModelMatrix() const override;
+    Matrix4 getTessellationMatrix() const override;
     void tessellate(std::vector<Vector3>& positions,
                    std::vector<Vector3>& normals,
                    std::vector<int>& indices) const override;
 
-    void setSlices(int s) { slices = s; }
-    void setColor(Color icolor) { color = icolor; }
+    void setSlices(int s) { slices = s; invalidateMesh(); }
+    int getSlices() const { return slices; }
+    void setColor(Color icolor) { color = icolor; markChanged(); }
 
     Vector3 getPosition() { return pos; }
     Vector3 getSize() { return size; }
 
     void bindTexture(Texture* texture, PartType type) {}
-    std::string getTextureName(PartType type = BOTH) {return "";}
     bool isValidPartType(PartType type) {return type == BOTH; }
 private:
     float height, baseRadius;
@@ -160,19 +247,21 @@ private:
 class Prism : public Shape {
 public:
     Prism(Vector3 ipos, float height, float diameter, int sides = 6, Color icol = Color());
-    void draw();
+    void accept(ShapeVisitor& visitor) override;
+    Matrix4 getModelMatrix() const override;
+    Matrix4 getTessellationMatrix() const override;
     void tessellate(std::vector<Vector3>& positions,
                    std::vector<Vector3>& normals,
                    std::vector<int>& indices) const override;
 
-    void setSides(int s) { if (s >= 3) sides = s; }
-    void setColor(Color icolor) { color = icolor; }
+    void setSides(int s) { if (s >= 3) { sides = s; invalidateMesh(); } }
+    int getSides() const { return sides; }
+    void setColor(Color icolor) { color = icolor; markChanged(); }
 
     Vector3 getPosition() { return pos; }
     Vector3 getSize() { return size; }
 
     void bindTexture(Texture* texture, PartType type) {}
-    std::string getTextureName(PartType type = BOTH) {return "";}
     bool isValidPartType(PartType type) { return type == BOTH; }
 private:
     float height, radius;
@@ -183,22 +272,42 @@ private:
 class Frustum : public Shape {
 public:
     Frustum(Vector3 ipos, float height, float bottomDiameter, float topDiameter, int sides = 4, Color icol = Color());
-    void draw();
+    void accept(ShapeVisitor& visitor) override;
+    Matrix4 getModelMatrix() const override;
+    Matrix4 getTessellationMatrix() const override;
+    float getBoundingRadius() const override;
     void tessellate(std::vector<Vector3>& positions,
                    std::vector<Vector3>& normals,
                    std::vector<int>& indices) const override;
 
-    void setSides(int s) { if (s >= 3) sides = s; }
-    void setColor(Color icolor) { color = icolor; }
+    void setSides(int s) { if (s >= 3) { sides = s; invalidateMesh(); } }
+    int getSides() const { return sides; }
+    float getBottomRadius() const { return bottomRadius; }
+    float getTopRadius() const { return topRadius; }
+    void setColor(Color icolor) { color = icolor; markChanged(); }
 
     Vector3 getPosition() { return pos; }
     Vector3 getSize() { return size; }
     
     void bindTexture(Texture* texture, PartType type) {}
-    std::string getTextureName(PartType type = BOTH) {return "";}
     bool isValidPartType(PartType type) {return type == BOTH; }
 private:
     float height, bottomRadius, topRadius;
     int sides;
     void init();
 };
+
+class GenericMesh;
+
+// One overload per concrete shape; see Shape::accept()
+class ShapeVisitor {
+public:
+    virtual ~ShapeVisitor() = default;
+    virtual void visit(Cylinder& shape) = 0;
+    virtual void visit(Sphere& shape) = 0;
+    virtual void visit(Cube& shape) = 0;
+    virtual void visit(Cone& shape) = 0;
+    virtual void visit(Prism& shape) = 0;
+    virtual void visit(Frustum& shape) = 0;
+    virtual void visit(GenericMesh& shape) = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Persistent worker that runs the simulation half of a frame while the main
+// thread, which owns the GL context, renders the other half. The main thread
+// hands over one job per frame with launch() and collects it with wait();
+// that handoff is the only synchronisation, so neither side takes a lock
+// while it works. Between wait() and the next launch() the worker is idle and
+// the main thread may touch simulation state freely (input callbacks).
+class SimulationThread {
+public:
+    SimulationThread();
+    ~SimulationThread();  // finishes the running job, then joins
+
+    // Starts job on the worker; the previous job must have been waited for
+    void launch(std::function<void()> job);
+    // Blocks until the launched job has finished (returns at once when none is running)
+    void wait();
+
+    void printStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;      // worker: a job or stop request arrived
+    std::condition_variable finished;  // main thread: the job is done
+    std::function<void()> job;
+    bool pending;   // job launched and not yet waited for
+    bool running;   // job handed to the worker and not yet finished
+    bool stopping;
+
+    // Written by the worker before it signals finished, read after wait()
+    double lastJobSeconds;
+    double totalJobSeconds;
+    double totalWaitSeconds;  // main thread blocked in wait(): simulation outlasted rendering
+    long long jobCount;
+};
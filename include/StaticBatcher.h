@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Shapes.h"
+#include "GpuMesh.h"
+#include "ViewFrustum.h"
+#include "OcclusionCuller.h"
+#include <GL/glew.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+class Lighting;
+
+// Merges static scene shapes into a few world-space meshes, one per
+// (texture, coarse XZ cell) pair, so they draw with a handful of calls
+// instead of one per shape. Colors are baked per vertex. Shapes report edits
+// through Shape::getRevision(); update() rebuilds only the batches that hold
+// a changed shape.
+class StaticBatcher {
+public:
+    static constexpr float CELL_SIZE = 25.0f;
+
+    StaticBatcher();
+
+    // Drops every batch and rebuilds them from shapes
+    void build(const std::vector<std::shared_ptr<Shape>>& shapes);
+
+    // Picks up shapes appended or edited since the last build()/update().
+    // Returns how many batches were rebuilt.
+    int update(const std::vector<std::shared_ptr<Shape>>& shapes);
+
+    // Draws batches that intersect the frustum and adds their shape counts to
+    // submitted or culled. Shaded per pixel when lighting's shader is active.
+    // With occlusion, batches it reports as occluded are culled too.
+    void draw(const ViewFrustum& frustum, int& submitted, int& culled, Lighting* lighting = nullptr,
+              OcclusionCuller* occlusion = nullptr);
+
+    // Issues an occlusion query for the bounds of every batch in the frustum
+    void queryOcclusion(const ViewFrustum& frustum, OcclusionCuller& occlusion) const;
+
+    int getBatchCount() const { return static_cast<int>(batches.size()); }
+    int getLastDrawCalls() const { return lastDrawCalls; }
+    int getLastOccludedShapes() const { return lastOccludedShapes; }
+    size_t getMemoryBytes() const;
+
+private:
+    struct BatchKey {
+        Texture* texture;  // nullptr for untextured shapes
+        int cellX;
+        int cellZ;
+        bool operator<(const BatchKey& other) const;
+    };
+
+    struct Batch {
+        std::vector<int> members;  // indices into the shape vector
+        GpuMesh mesh;
+        GLuint colorBuffer = 0;
+        Vector3 boundsMin, boundsMax;
+        bool dirty = true;
+
+        Batch() = default;
+        ~Batch();
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+    };
+
+    struct ShapeRecord {
+        BatchKey key;
+        unsigned int revision;
+    };
+
+    static BatchKey keyFor(const Shape& shape);
+    void addToBatch(int shapeIndex, const BatchKey& key);
+    void removeFromBatch(int shapeIndex, const BatchKey& key);
+    void rebuildBatch(Batch& batch, const std::vector<std::shared_ptr<Shape>>& shapes);
+
+    std::map<BatchKey, std::unique_ptr<Batch>> batches;
+    std::vector<ShapeRecord> records;  // parallel to the shape vector
+    int lastDrawCalls;
+    int lastOccludedShapes;
+};
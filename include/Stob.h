@@ -1,5 +1,6 @@
 #pragma once
 #include <GL/glew.h>
+#include <string>
 #include <vector>
 #include "Texture.h"
 #include "GameObject.h"
@@ -13,7 +14,7 @@ public:
     void draw();
     bool testCollision(Vector3 posBullet, float rBullet);
     void setSlices(int s) { slices = s;}
-    void rebindTexture(enum PartType type, char* bmpFile);
+    void rebindTexture(enum PartType type, const std::string& bmpFile);
     void setTextureMode(bool enabled) { textureEnabled = enabled; }
     void setColor(enum PartType type, Color icolor);
     void move_absolute(float dx, float dy, float dz);
@@ -46,8 +47,7 @@ private:
     float diameter;
     int slices;
     Color colorSide, colorCap, color;
-    std::vector<Texture> textures;
-    GLubyte image[imageheight][imageweight][1];
+    std::vector<Texture*> textures;  // SIDE, CAP; owned by TextureCache
     bool textureEnabled;
     Scene* scene;  // Scene reference for collision detection
 
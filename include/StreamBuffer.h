@@ -0,0 +1,72 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+// Ring buffer for per-frame vertex and instance data (enemy instances, HUD
+// quads, the safe-zone indicator).
+//
+// One GL buffer is split into FRAME_COUNT segments; frame N writes only
+// segment N % FRAME_COUNT. With ARB_buffer_storage the whole buffer is
+// mapped once, persistently and coherently, so writes land directly in GPU
+// visible memory with no glBufferData reallocation and no driver sync.
+// A fence placed at the end of each frame guards its segment: beginFrame()
+// waits on it only if the GPU is still FRAME_COUNT frames behind.
+//
+// Without buffer storage, allocations are written to a CPU shadow and
+// copied with glBufferSubData into the fenced segment by commit().
+// Without fences (pre-3.2) nothing is allocated and callers keep their
+// previous upload path.
+class StreamBuffer {
+public:
+    static constexpr int FRAME_COUNT = 3;
+    static constexpr size_t SEGMENT_SIZE = 2 * 1024 * 1024;  // bytes per frame
+    static constexpr size_t ALIGNMENT = 16;
+
+    struct Allocation {
+        void* data = nullptr;  // write here; nullptr when the allocation failed
+        GLuint buffer = 0;     // bind as GL_ARRAY_BUFFER ...
+        size_t offset = 0;     // ... and point attributes at this offset
+        size_t size = 0;
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    static StreamBuffer& instance();
+
+    // Needs a current GL context; false (with a message) when unsupported
+    bool initialize();
+    bool isSupported() const { return supported; }
+
+    // Bracket every frame; the fence for the frame's segment is placed in endFrame()
+    void beginFrame();
+    void endFrame();
+
+    // Space for this frame's data. Fails when the segment is full (reported
+    // on the first overflow only, then counted) or outside beginFrame()/endFrame()
+    Allocation allocate(size_t bytes);
+    // Makes the written data visible to the GPU; call before drawing from it
+    void commit(const Allocation& allocation);
+
+    size_t getLastFrameBytes() const { return lastFrameBytes; }
+    int getStallCount() const { return stallCount; }  // frames that had to wait on a fence
+    int getOverflowCount() const { return overflowCount; }  // allocations refused for lack of space
+
+private:
+    StreamBuffer();
+    ~StreamBuffer();
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    GLuint buffer;
+    unsigned char* mapped;   // persistent mapping, or the CPU shadow
+    bool persistent;
+    GLsync fences[FRAME_COUNT];
+    int segment;
+    size_t segmentUsed;
+    size_t lastFrameBytes;
+    int stallCount;
+    int overflowCount;
+    bool supported;
+    bool initialized;
+    bool inFrame;
+    bool overflowReported;
+};
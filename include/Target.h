@@ -15,11 +15,7 @@ public:
     float getMaxHealth() const { return maxHealth; }
     float getHealthPercentage() const { return currentHealth / maxHealth; }
 
-    // Override draw to show health bar
-    void draw() const;
-
 private:
     float maxHealth;
     float currentHealth;
-    void drawHealthBar() const;
 };
@@ -1,19 +1,56 @@
 #pragma once
-#include <windows.h>
+#include <GL/glew.h>
 #include <string>
-#define BITMAP_ID 0x4D42
-#define imageweight 128
-#define imageheight 128
 
+struct CookedTexture;
+
+// A GL texture loaded from an image file, with a full mip chain and
+// trilinear (plus anisotropic, where supported) filtering.
+// Textures are shared and streamed in the background: get them from
+// TextureCache rather than creating them directly. The GL name exists from
+// the start and keeps showing a placeholder until the image arrives.
 class Texture {
 public:
-    Texture(char *filename) { texload(ID, filename);}
-    void rebind(char *filename) { texload(ID, filename); }
-    unsigned int getID() { return ID; }
-    std::string getName() { return name; }
+    // Anisotropy requested when EXT_texture_filter_anisotropic is present
+    static constexpr float MAX_ANISOTROPY = 8.0f;
+
+    enum class State { LOADING, READY, MISSING };
+
+    explicit Texture(const std::string& filepath);
+    ~Texture();
+
+    Texture(const Texture&) = delete;
+    Texture& operator=(const Texture&) = delete;
+
+    // Main thread only. Grey while loading; a checkerboard once the file is
+    // known to be missing or unreadable, so it stays visible instead of crashing
+    void uploadPlaceholder(State state);
+    // Main thread only. pixels is RGBA8, or an offset into the bound
+    // GL_PIXEL_UNPACK_BUFFER when one is bound
+    void upload(const void* pixels, int imageWidth, int imageHeight);
+    // Main thread only. Uploads the cooked BC1/BC3 mip chain as is
+    // (needs EXT_texture_compression_s3tc)
+    void uploadCompressed(const CookedTexture& cooked);
+
+    GLuint getID() const { return ID; }
+    // File name without directory or extension, shown in the editor
+    const std::string& getName() const { return name; }
+    const std::string& getPath() const { return path; }
+    State getState() const { return state; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // GPU memory of the whole mip chain
+    size_t getResidentBytes() const { return residentBytes; }
+
 private:
-    unsigned int ID;
-    std::string name;
-    unsigned char *LoadBitmapFile(char *filename, BITMAPINFOHEADER *bitmapInfoHeader);
-    void texload(unsigned int textureID, char *filename);
+    void bindWithSampling(int levelCount);
+
+    GLuint ID;
+    const std::string path;
+    const std::string name;
+    State state;
+    int width;
+    int height;
+    size_t residentBytes;
 };
\ No newline at end of file
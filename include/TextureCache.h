@@ -0,0 +1,98 @@
+#pragma once
+#include "ImageIO.h"
+#include "MappedFile.h"
+#include "Texture.h"
+#include "TextureCooker.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Owns every Texture, keyed by normalized file path, so an image used by
+// several shapes (the barn and the crates share WoodSide) is read and
+// uploaded once.
+//
+// Loading is asynchronous: get() returns at once with a placeholder, a
+// worker thread prepares the file, and update() uploads finished images on
+// the main thread, at most getUploadBudget() bytes per frame (but always at
+// least one image, so oversized ones still arrive).
+//
+// With S3TC support the worker cooks each source into a compressed .ctex
+// container on first run (see TextureCooker) and afterwards only maps it;
+// the mip levels go to glCompressedTexImage2D straight from the mapping.
+// Otherwise it decodes the source image and uploads it through a pixel
+// buffer object.
+class TextureCache {
+public:
+    static constexpr size_t DEFAULT_UPLOAD_BUDGET = 4 * 1024 * 1024;
+
+    static TextureCache& instance();
+
+    // Queues the file on first use; never returns nullptr. Main thread only.
+    Texture* get(const std::string& filepath);
+
+    // Once per frame on the main thread, with a current GL context
+    void update();
+    // Blocks until every queued texture is decoded and uploaded
+    void finishLoading();
+
+    void setUploadBudget(size_t bytesPerFrame) { uploadBudget = bytesPerFrame; }
+    size_t getUploadBudget() const { return uploadBudget; }
+
+    // Drops every texture; pointers handed out earlier become invalid
+    void clear();
+    // clear() plus the upload buffer, for shutdown while the GL context is
+    // still current (the cache itself outlives it)
+    void release();
+
+    int getTextureCount() const { return static_cast<int>(textures.size()); }
+    int getPendingCount() const { return pendingCount; }
+    size_t getResidentBytes() const;
+    void printStats() const;
+
+private:
+    struct Decoded {
+        Texture* texture;
+        unsigned int generation;  // clear() count when it was queued
+        bool ok;
+        Image image;                        // uncompressed fallback
+        std::unique_ptr<MappedFile> file;   // cooked container, when compressed
+        CookedTexture cooked;               // views into file
+
+        size_t getUploadBytes() const { return file ? cooked.getDataBytes() : image.pixels.size(); }
+    };
+
+    TextureCache();
+    ~TextureCache();
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    void workerLoop();
+    // Worker thread: maps the cooked container, cooking it first when stale
+    bool loadCooked(const std::string& path, Decoded& item);
+    // Uploads decoded images until budget bytes have gone out; returns how many
+    int uploadDecoded(size_t budget);
+    void upload(Decoded& decoded);
+
+    std::unordered_map<std::string, std::unique_ptr<Texture>> textures;
+
+    // Shared with the worker, guarded by mutex
+    std::mutex mutex;
+    std::condition_variable requestReady;
+    std::condition_variable decodeReady;
+    std::deque<std::pair<Texture*, unsigned int>> requests;
+    std::deque<Decoded> decoded;
+    unsigned int generation;
+    bool stopping;
+    bool compressionSupported;  // fixed before the worker starts
+
+    std::thread worker;
+    GLuint pixelBuffer;
+    bool pixelBufferChecked;
+    size_t uploadBudget;
+    int pendingCount;              // queued and not yet uploaded
+    size_t uploadedLastFrame;
+};
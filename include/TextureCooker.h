@@ -0,0 +1,42 @@
+#pragma once
+#include "ImageIO.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Cooked texture container (.ctex), written next to the source image:
+//   header  "CTEX", version, format, width, height, levelCount (uint32 LE each)
+//   table   levelCount x {offset, size} (uint32 LE), offsets from file start
+//   data    the compressed mip levels, largest first
+// Levels are S3TC blocks ready for glCompressedTexImage2D: BC1 (DXT1) for
+// opaque images, BC3 (DXT5) when any texel has alpha below 255.
+struct CookedTexture {
+    enum Format : uint32_t { BC1 = 1, BC3 = 3 };
+    static constexpr int MAX_LEVELS = 16;
+
+    uint32_t format = BC1;
+    int width = 0;
+    int height = 0;
+    int levelCount = 0;
+    // Views into the container's memory (e.g. a MappedFile); nothing is owned
+    const unsigned char* levels[MAX_LEVELS] = {};
+    size_t levelSizes[MAX_LEVELS] = {};
+
+    size_t getDataBytes() const;
+};
+
+namespace TextureCooker {
+    // resources/textures/WoodSide.bmp -> resources/textures/WoodSide.ctex
+    std::string cookedPathFor(const std::string& sourcePath);
+
+    // True when the cooked file exists and is not older than its source
+    bool isUpToDate(const std::string& sourcePath, const std::string& cookedPath);
+
+    // Builds the mip chain, compresses every level on the CPU and writes the
+    // container (via a temporary file, so a half-written one is never read).
+    // Returns false (with a message) on failure
+    bool cook(const Image& image, const std::string& cookedPath);
+
+    // Validates a container in memory and fills in views of its levels
+    bool parse(const unsigned char* data, size_t size, CookedTexture& texture);
+}
@@ -33,6 +33,7 @@ public:
     void setCrossPosition(float x, float y);
 
     // 绘制准星（在 display 中 3D 场景绘制完之后调用）
+    // drawCross() and drawEditorUI() expect depth test and lighting off (the frame graph's overlay passes)
     void drawCross() const;
 
     // Edit mode related methods
@@ -58,6 +59,7 @@ private:
     // Edit mode related
     EditModeState editModeState = EditModeState::INACTIVE;
     std::vector<std::shared_ptr<Shape>> sceneObjects;
+    std::vector<std::string> objectLabels;  // "Object i: Type", built by updateObjectList()
     int selectedObjectIndex = -1;
     Color currentColor;
     std::string currentTextureName;
@@ -74,7 +76,9 @@ private:
     bool isDraggingSliderB = false;
 
     // UI drawing helper methods
-    void drawText(const std::string& text, float x, float y, float scale = 1.0f) const;
+    // Queues text into the HUD batch; it appears when the batch is flushed at frame end
+    void drawText(const std::string& text, float x, float y, const Color& color, float scale = 1.0f) const;
+    static const char* shapeTypeName(const Shape& shape);
     void drawRect(float x, float y, float width, float height, float r, float g, float b, float a = 1.0f) const;
     void drawButton(const std::string& text, float x, float y, float width, float height) const;
     void drawSlider(float x, float y, float width, float height, float value, float min, float max, const std::string& label) const;
@@ -0,0 +1,29 @@
+#pragma once
+#include "CameraView.h"
+#include "Matrix4.h"
+
+// The six clip planes of the current camera, used to skip objects that
+// cannot be on screen. Planes point inward; a point p is inside plane i when
+// dot(normal, p) + d >= 0.
+class ViewFrustum {
+public:
+    ViewFrustum();
+
+    // World-space planes from the frame's camera matrices; call once per frame
+    void extract(const CameraView& camera);
+    void extract(const Matrix4& viewProjection);
+
+    bool intersectsSphere(const Vector3& center, float radius) const;
+    bool intersectsAABB(const Vector3& min, const Vector3& max) const;
+
+    // World-space eye position; only set by extract(const CameraView&)
+    const Vector3& getCameraPosition() const { return cameraPosition; }
+
+private:
+    struct Plane {
+        Vector3 normal;
+        float d;
+    };
+    Plane planes[6];
+    Vector3 cameraPosition;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "GameObject.h"  // For Vector3
+#include "CameraView.h"
 
 
 class CameraController {
@@ -9,7 +10,15 @@ public:
     void movePlayerAbsolute(float dx, float dy);
     void setPlayerPosition(float x, float y); // Set absolute position
     void updateRotation(int mouseX, int mouseY);
+    // Loads getProjectionMatrix() and getViewMatrix() into GL
     void applyView();
+    Matrix4 getViewMatrix() const;
+    Matrix4 getProjectionMatrix() const { return perspective.matrix(); }
+    Matrix4 getViewProjectionMatrix() const { return getProjectionMatrix() * getViewMatrix(); }
+    // View over the player position blended alpha of the way from the previous simulation step
+    Matrix4 getInterpolatedViewMatrix(float alpha) const;
+    // Called before each fixed simulation step, and after teleports so they are not blended
+    void storePreviousState() { prevPlayerX = playerX; prevPlayerY = playerY; }
     void getPlayerPosition(float* x, float* y, float* rotation) const;
     void reset();
 
@@ -22,7 +31,10 @@ private:
     float cameraAngle;
     float playerX;
     float playerY;
+    float prevPlayerX;  // player position at the start of the current simulation step
+    float prevPlayerY;
     float playerRotation;
     int windowWidth;
     int windowHeight;
+    Perspective perspective;
 };
\ No newline at end of file
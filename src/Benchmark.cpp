@@ -0,0 +1,258 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+// Fly-through keyframes (eye, look-at target); the path loops back to the first.
+// It passes behind the barn, circles the water tower and crosses the open field.
+const float PATH[][6] = {
+    {  0.0f, 6.0f,  46.0f,    0.0f, 2.0f,   0.0f},
+    { 30.0f, 4.0f,  30.0f,    0.0f, 2.0f,   0.0f},
+    { 44.0f, 5.0f,  -6.0f,   38.0f, 4.0f,  22.0f},
+    { 10.0f, 3.0f, -42.0f,    0.0f, 2.0f,   0.0f},
+    {-36.0f, 4.0f, -20.0f,    0.0f, 2.0f,   0.0f},
+    {-30.0f, 8.0f,  30.0f,    0.0f, 2.0f,  35.0f},
+};
+constexpr int PATH_KEYS = sizeof(PATH) / sizeof(PATH[0]);
+
+double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct Summary {
+    double average, median, p95, max;
+};
+
+Summary summarize(std::vector<double> values) {
+    Summary s = {0.0, 0.0, 0.0, 0.0};
+    if (values.empty()) return s;
+    std::sort(values.begin(), values.end());
+    for (double v : values) s.average += v;
+    s.average /= values.size();
+    s.median = values[values.size() / 2];
+    s.p95 = values[std::min(values.size() - 1, static_cast<size_t>(values.size() * 0.95))];
+    s.max = values.back();
+    return s;
+}
+
+void writeSummary(std::ofstream& out, const char* name, const Summary& s) {
+    out << "    \"" << name << "\": {\"avg\": " << s.average << ", \"p50\": " << s.median
+        << ", \"p95\": " << s.p95 << ", \"max\": " << s.max << "}";
+}
+
+// GL strings may contain quotes or backslashes
+std::string jsonEscape(const char* text) {
+    std::string escaped;
+    for (const char* c = text ? text : ""; *c; c++) {
+        if (*c == '"' || *c == '\\') escaped += '\\';
+        escaped += *c;
+    }
+    return escaped;
+}
+
+}  // namespace
+
+bool Benchmark::parseArgs(int argc, char** argv, BenchmarkOptions& options) {
+    bool enabled = false;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--benchmark") == 0) {
+            enabled = true;
+        } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--enemies") == 0 && hasValue) {
+            options.enemies = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+            options.outputPath = argv[++i];
+        } else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            int w = 0, h = 0;
+            const char* size = argv[++i];
+            const char* x = std::strchr(size, 'x');
+            if (x) {
+                w = std::atoi(size);
+                h = std::atoi(x + 1);
+            }
+            if (w > 0 && h > 0) {
+                options.width = w;
+                options.height = h;
+            } else {
+                std::cerr << "Benchmark: ignoring --size " << size << " (expected WxH)" << std::endl;
+            }
+        }
+    }
+    return enabled;
+}
+
+Benchmark::Benchmark()
+    : framebuffer(0), colorBuffer(0), depthBuffer(0), timerQueries{}, gpuTimers(false),
+      currentFrame(0), frameStart(0.0), previousFrameStart(0.0) {
+}
+
+Benchmark::~Benchmark() {
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+    if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+    if (gpuTimers) glDeleteQueries(QUERY_RING, timerQueries);
+}
+
+bool Benchmark::initialize(const BenchmarkOptions& benchmarkOptions) {
+    options = benchmarkOptions;
+    if (!(GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object)) {
+        std::cerr << "Benchmark: framebuffer objects are required for offscreen rendering" << std::endl;
+        return false;
+    }
+
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, options.width, options.height);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, options.width, options.height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Benchmark: offscreen framebuffer incomplete (0x" << std::hex << status << std::dec << ")"
+                  << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return false;
+    }
+
+    // GPU timings are optional; CPU timings are always recorded
+    gpuTimers = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    if (gpuTimers) {
+        glGenQueries(QUERY_RING, timerQueries);
+    } else {
+        std::cerr << "Benchmark: no timer queries, GPU times will be omitted" << std::endl;
+    }
+
+    records.assign(options.frames, FrameRecord{0.0, 0.0, 0.0, -1.0, 0, 0, 0});
+    std::cout << "Benchmark: " << options.frames << " frames at " << options.width << "x" << options.height
+              << " on " << glGetString(GL_RENDERER) << std::endl;
+    return true;
+}
+
+void Benchmark::getEyeAndTarget(float t, Vector3& eye, Vector3& target) const {
+    float position = (t - std::floor(t)) * PATH_KEYS;
+    int key = static_cast<int>(position) % PATH_KEYS;
+    int next = (key + 1) % PATH_KEYS;
+    float f = position - std::floor(position);
+    f = f * f * (3.0f - 2.0f * f);  // ease in and out of each keyframe
+
+    const float* a = PATH[key];
+    const float* b = PATH[next];
+    eye = Vector3(a[0] + (b[0] - a[0]) * f, a[1] + (b[1] - a[1]) * f, a[2] + (b[2] - a[2]) * f);
+    target = Vector3(a[3] + (b[3] - a[3]) * f, a[4] + (b[4] - a[4]) * f, a[5] + (b[5] - a[5]) * f);
+}
+
+CameraView Benchmark::getCameraView() const {
+    Vector3 eye, target;
+    getEyeAndTarget(static_cast<float>(currentFrame) / options.frames, eye, target);
+    Perspective perspective(60.0f, static_cast<float>(options.width) / options.height, 0.1f, 100.0f);
+    return CameraView(Matrix4::lookAt(eye, target, Vector3(0.0f, 1.0f, 0.0f)), perspective.matrix(),
+                      options.width, options.height);
+}
+
+void Benchmark::beginFrame() {
+    previousFrameStart = frameStart;
+    frameStart = nowMs();
+    records[currentFrame].startMs = frameStart;
+    if (currentFrame > 0) records[currentFrame - 1].frameMs = frameStart - previousFrameStart;
+
+    // The ring slot is about to be reused; its old result must be read first
+    if (gpuTimers && currentFrame >= QUERY_RING) collectGpuTime(currentFrame - QUERY_RING);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, options.width, options.height);
+    if (gpuTimers) glBeginQuery(GL_TIME_ELAPSED, timerQueries[currentFrame % QUERY_RING]);
+}
+
+void Benchmark::endFrame(int objectsDrawn, int objectsCulled, int objectsOccluded) {
+    if (gpuTimers) glEndQuery(GL_TIME_ELAPSED);
+    // Hand the frame to the driver the way a buffer swap would
+    glFlush();
+
+    FrameRecord& record = records[currentFrame];
+    record.cpuMs = nowMs() - frameStart;
+    record.drawn = objectsDrawn;
+    record.culled = objectsCulled;
+    record.occluded = objectsOccluded;
+    currentFrame++;
+}
+
+void Benchmark::collectGpuTime(int frame) {
+    // QUERY_RING frames old, so this rarely has to wait
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(timerQueries[frame % QUERY_RING], GL_QUERY_RESULT, &elapsedNs);
+    // llvmpipe may report a bare timestamp instead of a duration (seen on the
+    // first frame); no frame can have taken longer than the time since it began
+    double gpuMs = elapsedNs / 1.0e6;
+    if (gpuMs <= nowMs() - records[frame].startMs) records[frame].gpuMs = gpuMs;
+}
+
+bool Benchmark::writeReport() {
+    glFinish();
+    if (gpuTimers) {
+        for (int frame = std::max(0, currentFrame - QUERY_RING); frame < currentFrame; frame++) {
+            collectGpuTime(frame);
+        }
+    }
+    if (currentFrame > 0) records[currentFrame - 1].frameMs = nowMs() - frameStart;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    std::ofstream out(options.outputPath);
+    if (!out) {
+        std::cerr << "Benchmark: cannot write " << options.outputPath << std::endl;
+        return false;
+    }
+
+    std::vector<double> cpu, frame, gpu;
+    for (int i = 0; i < currentFrame; i++) {
+        cpu.push_back(records[i].cpuMs);
+        frame.push_back(records[i].frameMs);
+        if (records[i].gpuMs >= 0.0) gpu.push_back(records[i].gpuMs);
+    }
+
+    out << "{\n";
+    out << "  \"renderer\": \"" << jsonEscape(reinterpret_cast<const char*>(glGetString(GL_RENDERER))) << "\",\n";
+    out << "  \"gl_version\": \"" << jsonEscape(reinterpret_cast<const char*>(glGetString(GL_VERSION))) << "\",\n";
+    out << "  \"width\": " << options.width << ",\n";
+    out << "  \"height\": " << options.height << ",\n";
+    out << "  \"frames\": " << currentFrame << ",\n";
+    out << "  \"gpu_timers\": " << (gpuTimers ? "true" : "false") << ",\n";
+    out << "  \"summary_ms\": {\n";
+    writeSummary(out, "cpu", summarize(cpu));
+    out << ",\n";
+    writeSummary(out, "frame", summarize(frame));
+    if (!gpu.empty()) {
+        out << ",\n";
+        writeSummary(out, "gpu", summarize(gpu));
+    }
+    out << "\n  },\n";
+    out << "  \"per_frame\": [\n";
+    for (int i = 0; i < currentFrame; i++) {
+        const FrameRecord& r = records[i];
+        out << "    {\"frame\": " << i << ", \"cpu_ms\": " << r.cpuMs << ", \"frame_ms\": " << r.frameMs;
+        if (r.gpuMs >= 0.0) out << ", \"gpu_ms\": " << r.gpuMs;
+        out << ", \"drawn\": " << r.drawn << ", \"culled\": " << r.culled << ", \"occluded\": " << r.occluded
+            << "}" << (i + 1 < currentFrame ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+
+    Summary cpuSummary = summarize(cpu);
+    std::cout << "Benchmark: " << currentFrame << " frames, CPU avg " << cpuSummary.average << " ms (p95 "
+              << cpuSummary.p95 << " ms), report written to " << options.outputPath << std::endl;
+    return true;
+}
@@ -5,7 +5,7 @@
 #include <cmath>
 //第一人称摄像头
 Camera::Camera(float x, float y, float z)
-    : x(x), y(y), z(z), yaw(0.0f), pitch(0.0f), moveSpeed(0.2f),
+    : x(x), y(y), z(z), prevX(x), prevY(y), prevZ(z), yaw(0.0f), pitch(0.0f), moveSpeed(0.2f),
       collisionRadius(0.5f), scene(nullptr), verticalVelocity(0.0f),
       groundLevel(1.5f), isOnGround(true) {
     updateVectors();
@@ -18,9 +18,32 @@ void Camera::updateVectors() {
 }
 
 void Camera::applyView() const {
-    gluLookAt(x, y, z,           // Camera position
-              lookX, lookY, lookZ, // Look at point
-              0.0f, 1.0f, 0.0f);  // Up vector
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(getProjectionMatrix().data());
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(getViewMatrix().data());
+}
+
+Quaternion Camera::getOrientation() const {
+    return Quaternion::fromAxisAngle(-yaw, Vector3(0.0f, 1.0f, 0.0f)) *
+           Quaternion::fromAxisAngle(pitch, Vector3(1.0f, 0.0f, 0.0f));
+}
+
+Matrix4 Camera::getViewMatrix() const {
+    // Inverse of the camera's rigid transform: transpose the rotation, then undo the position.
+    // Matches gluLookAt toward (lookX, lookY, lookZ) with +Y up while |pitch| < 90.
+    Matrix4 rotation = getOrientation().conjugate().toMatrix();
+    return rotation * Matrix4::translation(Vector3(-x, -y, -z));
+}
+
+Vector3 Camera::getInterpolatedPosition(float alpha) const {
+    return Vector3(prevX + (x - prevX) * alpha, prevY + (y - prevY) * alpha, prevZ + (z - prevZ) * alpha);
+}
+
+Matrix4 Camera::getInterpolatedViewMatrix(float alpha) const {
+    // Only the position is blended; mouse look is applied immediately and stays responsive
+    Matrix4 rotation = getOrientation().conjugate().toMatrix();
+    return rotation * Matrix4::translation(-getInterpolatedPosition(alpha));
 }
 
 void Camera::move(float forward, float right) {
@@ -59,6 +82,7 @@ void Camera::setPosition(float x, float y, float z) {
     this->x = x;
     this->y = y;
     this->z = z;
+    storePreviousState();
     updateVectors();
 }
 
@@ -0,0 +1,46 @@
+#include "CameraView.h"
+#include <GL/glew.h>
+#include <algorithm>
+
+namespace {
+
+// Homogeneous transform of (p, 1); returns w
+float transformHomogeneous(const Matrix4& m, const Vector3& p, Vector3& out) {
+    out = m.transformPoint(p);
+    return m.at(3, 0) * p.x + m.at(3, 1) * p.y + m.at(3, 2) * p.z + m.at(3, 3);
+}
+
+}  // namespace
+
+CameraView::CameraView() : viewportWidth(1), viewportHeight(1) {
+}
+
+CameraView::CameraView(const Matrix4& viewMatrix, const Matrix4& projectionMatrix, int width, int height)
+    : view(viewMatrix), projection(projectionMatrix), viewportWidth(std::max(width, 1)),
+      viewportHeight(std::max(height, 1)) {
+    viewProjection = projection * view;
+
+    // Camera position = -R^T * t for the rigid view matrix
+    const float* v = view.m;
+    position = Vector3(-(v[0] * v[12] + v[1] * v[13] + v[2] * v[14]),
+                       -(v[4] * v[12] + v[5] * v[13] + v[6] * v[14]),
+                       -(v[8] * v[12] + v[9] * v[13] + v[10] * v[14]));
+}
+
+void CameraView::apply() const {
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(projection.data());
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(view.data());
+}
+
+bool CameraView::project(const Vector3& world, float& winX, float& winY) const {
+    Vector3 clip;
+    float w = transformHomogeneous(viewProjection, world, clip);
+    if (w <= 1e-6f) return false;
+
+    // Same mapping as gluProject with a viewport at the origin
+    winX = (clip.x / w * 0.5f + 0.5f) * viewportWidth;
+    winY = (clip.y / w * 0.5f + 0.5f) * viewportHeight;
+    return true;
+}
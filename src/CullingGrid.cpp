@@ -0,0 +1,76 @@
+#include "CullingGrid.h"
+#include <algorithm>
+#include <cmath>
+
+CullingGrid::CullingGrid() : cellsX(0), cellsZ(0) {
+}
+
+void CullingGrid::build(const std::vector<std::shared_ptr<Shape>>& shapes) {
+    cells.clear();
+    centers.clear();
+    radii.clear();
+    cellsX = 0;
+    cellsZ = 0;
+    if (shapes.empty()) return;
+
+    // Size the grid from the shapes themselves rather than the arena
+    centers.reserve(shapes.size());
+    radii.reserve(shapes.size());
+    float minX = 0.0f, maxX = 0.0f, minZ = 0.0f, maxZ = 0.0f;
+    for (size_t i = 0; i < shapes.size(); i++) {
+        Vector3 center = shapes[i] ? shapes[i]->getPosition() : Vector3();
+        float radius = shapes[i] ? shapes[i]->getBoundingRadius() : 0.0f;
+        centers.push_back(center);
+        radii.push_back(radius);
+
+        if (i == 0 || center.x < minX) minX = center.x;
+        if (i == 0 || center.x > maxX) maxX = center.x;
+        if (i == 0 || center.z < minZ) minZ = center.z;
+        if (i == 0 || center.z > maxZ) maxZ = center.z;
+    }
+
+    cellsX = static_cast<int>(std::floor((maxX - minX) / CELL_SIZE)) + 1;
+    cellsZ = static_cast<int>(std::floor((maxZ - minZ) / CELL_SIZE)) + 1;
+    cells.resize(cellsX * cellsZ);
+
+    for (size_t i = 0; i < shapes.size(); i++) {
+        if (!shapes[i]) continue;
+
+        int cx = std::min(static_cast<int>((centers[i].x - minX) / CELL_SIZE), cellsX - 1);
+        int cz = std::min(static_cast<int>((centers[i].z - minZ) / CELL_SIZE), cellsZ - 1);
+        Cell& cell = cells[cz * cellsX + cx];
+
+        Vector3 extent(radii[i], radii[i], radii[i]);
+        Vector3 shapeMin = centers[i] - extent;
+        Vector3 shapeMax = centers[i] + extent;
+        if (cell.members.empty()) {
+            cell.min = shapeMin;
+            cell.max = shapeMax;
+        } else {
+            cell.min = Vector3(std::min(cell.min.x, shapeMin.x), std::min(cell.min.y, shapeMin.y), std::min(cell.min.z, shapeMin.z));
+            cell.max = Vector3(std::max(cell.max.x, shapeMax.x), std::max(cell.max.y, shapeMax.y), std::max(cell.max.z, shapeMax.z));
+        }
+        cell.members.push_back(static_cast<int>(i));
+    }
+}
+
+int CullingGrid::collectVisible(const ViewFrustum& frustum, std::vector<int>& visible) const {
+    int culled = 0;
+    for (const Cell& cell : cells) {
+        if (cell.members.empty()) continue;
+
+        if (!frustum.intersectsAABB(cell.min, cell.max)) {
+            culled += static_cast<int>(cell.members.size());
+            continue;
+        }
+
+        for (int index : cell.members) {
+            if (frustum.intersectsSphere(centers[index], radii[index])) {
+                visible.push_back(index);
+            } else {
+                culled++;
+            }
+        }
+    }
+    return culled;
+}
@@ -1,6 +1,7 @@
 #include "Enemy.h"
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 namespace {
     constexpr float ENEMY_SCALE = 0.6f;
@@ -31,79 +32,65 @@ namespace {
     constexpr float EYE_Y_OFFSET = 3.3f * ENEMY_SCALE;
     constexpr float EYE_DIAMETER = 0.2f * ENEMY_SCALE;
     constexpr float HEALTH_BAR_Y_OFFSET = 5.2f * ENEMY_SCALE;
+    // Feet to health bar spans about 5.4 units and the arms reach 2.55 from the center
+    constexpr float BOUNDS_Y_OFFSET = 2.6f * ENEMY_SCALE;
+    constexpr float BOUNDS_RADIUS = 3.6f * ENEMY_SCALE;
 }
 
-Enemy::Enemy(Vector3 ipos, Color icol) : position(ipos), yaw(0.0f), currentHealth(5.0f), maxHealth(5.0f), alive(true) {
-    // Main body spheres (white)
+Enemy::Enemy(Vector3 ipos, Color icol) : position(ipos), yaw(0.0f),
+    previousPosition(ipos), previousYaw(0.0f), renderPosition(ipos), renderYaw(0.0f), currentHealth(5.0f), maxHealth(5.0f), alive(true), id(0) {
+    createParts();
+}
+
+Enemy::Enemy(Vector3 ipos, Color icolHead, Color icolBody) : position(ipos), yaw(0.0f),
+    previousPosition(ipos), previousYaw(0.0f), renderPosition(ipos), renderYaw(0.0f), currentHealth(5.0f), maxHealth(5.0f), alive(true), id(0) {
+    // Snowman should always be white; colors can still be changed with setColor()
+    createParts();
+}
+
+void Enemy::createParts() {
+    // Main body spheres (white) - world space, also used for collision
     Color white(1.0f, 1.0f, 1.0f);
-    bodyLower = new Sphere(ipos + Vector3(0.0f, BODY_Y_OFFSET, 0.0f), BODY_DIAMETER, white);
-    head = new Sphere(ipos + Vector3(0.0f, HEAD_Y_OFFSET, 0.0f), HEAD_DIAMETER, white);
+    bodyLower = new Sphere(position + Vector3(0.0f, BODY_Y_OFFSET, 0.0f), BODY_DIAMETER, white);
+    head = new Sphere(position + Vector3(0.0f, HEAD_Y_OFFSET, 0.0f), HEAD_DIAMETER, white);
+
+    // Decorations are kept in enemy-local space (feet at origin, facing +Z);
+    // the renderer places them with the enemy's position and yaw
 
     // Stick arms (brown) - use constructor with axis to angle outward
     Color brown(0.4f, 0.25f, 0.1f);
-    leftArm = new Cylinder(ipos + Vector3(-ARM_OFFSET_X, ARM_OFFSET_Y, 0.0f), ARM_LENGTH, ARM_DIAMETER,
+    leftArm = new Cylinder(Vector3(-ARM_OFFSET_X, ARM_OFFSET_Y, 0.0f), ARM_LENGTH, ARM_DIAMETER,
                            Vector3(-1.0f, 0.2f, 0.0f), 0.0f);  // Point left and slightly up
     leftArm->setColor(brown);
-    rightArm = new Cylinder(ipos + Vector3(ARM_OFFSET_X, ARM_OFFSET_Y, 0.0f), ARM_LENGTH, ARM_DIAMETER,
+    rightArm = new Cylinder(Vector3(ARM_OFFSET_X, ARM_OFFSET_Y, 0.0f), ARM_LENGTH, ARM_DIAMETER,
                             Vector3(1.0f, 0.2f, 0.0f), 0.0f);   // Point right and slightly up
     rightArm->setColor(brown);
 
     // Carrot nose (orange) - using Cylinder since Cone doesn't support rotation
     Color orange(1.0f, 0.5f, 0.0f);
     // Use Cylinder constructor with axis parameter to point forward (Z direction)
-    nose = new Cylinder(ipos + Vector3(0.0f, HEAD_Y_OFFSET, NOSE_OFFSET_Z), NOSE_LENGTH, NOSE_DIAMETER,
+    nose = new Cylinder(Vector3(0.0f, HEAD_Y_OFFSET, NOSE_OFFSET_Z), NOSE_LENGTH, NOSE_DIAMETER,
                         Vector3(0.0f, 0.0f, 1.0f), 0.0f);
     nose->setColor(orange);
 
     // Coal buttons (black)
     Color black(0.1f, 0.1f, 0.1f);
-    button1 = new Sphere(ipos + Vector3(0.0f, BUTTON1_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
-    button2 = new Sphere(ipos + Vector3(0.0f, BUTTON2_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
-    button3 = new Sphere(ipos + Vector3(0.0f, BUTTON3_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
+    button1 = new Sphere(Vector3(0.0f, BUTTON1_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
+    button2 = new Sphere(Vector3(0.0f, BUTTON2_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
+    button3 = new Sphere(Vector3(0.0f, BUTTON3_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
 
     // Hat (black)
-    hatBrim = new Cylinder(ipos + Vector3(0.0f, HAT_BRIM_Y_OFFSET, 0.0f), HAT_BRIM_HEIGHT, HAT_BRIM_DIAMETER, black);
-    hatTop = new Cylinder(ipos + Vector3(0.0f, HAT_TOP_Y_OFFSET, 0.0f), HAT_TOP_HEIGHT, HAT_TOP_DIAMETER, black);
+    hatBrim = new Cylinder(Vector3(0.0f, HAT_BRIM_Y_OFFSET, 0.0f), HAT_BRIM_HEIGHT, HAT_BRIM_DIAMETER, black);
+    hatTop = new Cylinder(Vector3(0.0f, HAT_TOP_Y_OFFSET, 0.0f), HAT_TOP_HEIGHT, HAT_TOP_DIAMETER, black);
 
     // Eyes (black)
-    leftEye = new Sphere(ipos + Vector3(-EYE_OFFSET_X, EYE_Y_OFFSET, EYE_OFFSET_Z), EYE_DIAMETER, black);
-    rightEye = new Sphere(ipos + Vector3(EYE_OFFSET_X, EYE_Y_OFFSET, EYE_OFFSET_Z), EYE_DIAMETER, black);
-}
+    leftEye = new Sphere(Vector3(-EYE_OFFSET_X, EYE_Y_OFFSET, EYE_OFFSET_Z), EYE_DIAMETER, black);
+    rightEye = new Sphere(Vector3(EYE_OFFSET_X, EYE_Y_OFFSET, EYE_OFFSET_Z), EYE_DIAMETER, black);
 
-Enemy::Enemy(Vector3 ipos, Color icolHead, Color icolBody) : position(ipos), yaw(0.0f), currentHealth(5.0f), maxHealth(5.0f), alive(true) {
-    // Main body spheres (white - snowman should always be white)
-    Color white(1.0f, 1.0f, 1.0f);
-    bodyLower = new Sphere(ipos + Vector3(0.0f, BODY_Y_OFFSET, 0.0f), BODY_DIAMETER, white);
-    head = new Sphere(ipos + Vector3(0.0f, HEAD_Y_OFFSET, 0.0f), HEAD_DIAMETER, white);
-
-    // Stick arms (brown)
-    Color brown(0.4f, 0.25f, 0.1f);
-    leftArm = new Cylinder(ipos + Vector3(-ARM_OFFSET_X, ARM_OFFSET_Y, 0.0f), ARM_LENGTH, ARM_DIAMETER,
-                           Vector3(-1.0f, 0.2f, 0.0f), 0.0f);
-    leftArm->setColor(brown);
-    rightArm = new Cylinder(ipos + Vector3(ARM_OFFSET_X, ARM_OFFSET_Y, 0.0f), ARM_LENGTH, ARM_DIAMETER,
-                            Vector3(1.0f, 0.2f, 0.0f), 0.0f);
-    rightArm->setColor(brown);
-
-    // Carrot nose (orange)
-    Color orange(1.0f, 0.5f, 0.0f);
-    nose = new Cylinder(ipos + Vector3(0.0f, HEAD_Y_OFFSET, NOSE_OFFSET_Z), NOSE_LENGTH, NOSE_DIAMETER,
-                        Vector3(0.0f, 0.0f, 1.0f), 0.0f);
-    nose->setColor(orange);
-
-    // Coal buttons (black)
-    Color black(0.1f, 0.1f, 0.1f);
-    button1 = new Sphere(ipos + Vector3(0.0f, BUTTON1_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
-    button2 = new Sphere(ipos + Vector3(0.0f, BUTTON2_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
-    button3 = new Sphere(ipos + Vector3(0.0f, BUTTON3_Y_OFFSET, BUTTON_OFFSET_Z), BUTTON_DIAMETER, black);
-
-    // Hat (black)
-    hatBrim = new Cylinder(ipos + Vector3(0.0f, HAT_BRIM_Y_OFFSET, 0.0f), HAT_BRIM_HEIGHT, HAT_BRIM_DIAMETER, black);
-    hatTop = new Cylinder(ipos + Vector3(0.0f, HAT_TOP_Y_OFFSET, 0.0f), HAT_TOP_HEIGHT, HAT_TOP_DIAMETER, black);
-
-    // Eyes (black)
-    leftEye = new Sphere(ipos + Vector3(-EYE_OFFSET_X, EYE_Y_OFFSET, EYE_OFFSET_Z), EYE_DIAMETER, black);
-    rightEye = new Sphere(ipos + Vector3(EYE_OFFSET_X, EYE_Y_OFFSET, EYE_OFFSET_Z), EYE_DIAMETER, black);
+    // Level of detail is chosen per enemy (EnemyRenderer::updateLod), not from each part's own position
+    for (Shape* part : getParts()) {
+        part->setAutoLod(false);
+    }
 }
 
 Enemy::~Enemy() {
@@ -122,25 +109,40 @@ Enemy::~Enemy() {
     delete rightEye;
 }
 
-void Enemy::draw() {
-    // Main body structure
-    bodyLower->draw();
-    head->draw();
+std::vector<Shape*> Enemy::getParts() const {
+    Shape* parts[PART_COUNT];
+    collectParts(parts);
+    return std::vector<Shape*>(parts, parts + PART_COUNT);
+}
+
+void Enemy::collectParts(Shape* parts[PART_COUNT]) const {
+    Shape* ordered[PART_COUNT] = {bodyLower, head, leftArm, rightArm, nose, button1, button2, button3,
+                                  hatBrim, hatTop, leftEye, rightEye};
+    std::copy(ordered, ordered + PART_COUNT, parts);
+}
 
-    // Decorations
-    leftArm->draw();
-    rightArm->draw();
-    nose->draw();
-    button1->draw();
-    button2->draw();
-    button3->draw();
-    hatBrim->draw();
-    hatTop->draw();
-    leftEye->draw();
-    rightEye->draw();
+void Enemy::getPartLodLevels(int levels[PART_COUNT]) const {
+    Shape* parts[PART_COUNT];
+    collectParts(parts);
+    for (int i = 0; i < PART_COUNT; i++) {
+        levels[i] = parts[i]->getLodLevel();
+    }
+}
 
-    // Health bar (rendered last for proper overlay)
-    drawHealthBar();
+void Enemy::getBoundingSphere(Vector3& center, float& radius) const {
+    boundingSphereAt(renderPosition, center, radius);
+}
+
+void Enemy::boundingSphereAt(const Vector3& position, Vector3& center, float& radius) {
+    center = position + Vector3(0.0f, BOUNDS_Y_OFFSET, 0.0f);
+    radius = BOUNDS_RADIUS;
+}
+
+void Enemy::hitSpheresAt(const Vector3& position, Vector3 centers[HIT_SPHERE_COUNT], float radii[HIT_SPHERE_COUNT]) {
+    centers[0] = position + Vector3(0.0f, BODY_Y_OFFSET, 0.0f);
+    radii[0] = BODY_DIAMETER * 0.5f;
+    centers[1] = position + Vector3(0.0f, HEAD_Y_OFFSET, 0.0f);
+    radii[1] = HEAD_DIAMETER * 0.5f;
 }
 
 void Enemy::setColor(Color icolor, PartType part) {
@@ -155,159 +157,24 @@ void Enemy::setColor(Color icolor, PartType part) {
 }
 
 void Enemy::updatePos() {
-    // Calculate rotation matrix components
-    float cosYaw = cos(yaw);
-    float sinYaw = sin(yaw);
-
-    // Helper lambda to rotate a 2D offset around origin
-    auto rotateOffset = [cosYaw, sinYaw](float x, float z) -> Vector3 {
-        return Vector3(x * cosYaw - z * sinYaw, 0.0f, x * sinYaw + z * cosYaw);
-    };
-
-    // Main body (spheres, no rotation needed for position, but stays centered)
+    // Only the body spheres live in world space (collision); decorations are
+    // positioned by the enemy transform at draw time
     bodyLower->setPosition(position + Vector3(0.0f, BODY_Y_OFFSET, 0.0f));
     head->setPosition(position + Vector3(0.0f, HEAD_Y_OFFSET, 0.0f));
+}
 
-    // Arms (rotate positions and axes)
-    Vector3 leftArmOffset = rotateOffset(-ARM_OFFSET_X, 0.0f);
-    leftArm->setPosition(position + leftArmOffset + Vector3(0.0f, ARM_OFFSET_Y, 0.0f));
-
-    Vector3 rightArmOffset = rotateOffset(ARM_OFFSET_X, 0.0f);
-    rightArm->setPosition(position + rightArmOffset + Vector3(0.0f, ARM_OFFSET_Y, 0.0f));
-
-    // Nose (rotate position)
-    Vector3 noseOffset = rotateOffset(0.0f, NOSE_OFFSET_Z);
-    nose->setPosition(position + noseOffset + Vector3(0.0f, HEAD_Y_OFFSET, 0.0f));
-
-    // Buttons (rotate positions)
-    Vector3 buttonOffset = rotateOffset(0.0f, BUTTON_OFFSET_Z);
-    button1->setPosition(position + buttonOffset + Vector3(0.0f, BUTTON1_Y_OFFSET, 0.0f));
-    button2->setPosition(position + buttonOffset + Vector3(0.0f, BUTTON2_Y_OFFSET, 0.0f));
-    button3->setPosition(position + buttonOffset + Vector3(0.0f, BUTTON3_Y_OFFSET, 0.0f));
-
-    // Hat (centered, no XZ offset)
-    hatBrim->setPosition(position + Vector3(0.0f, HAT_BRIM_Y_OFFSET, 0.0f));
-    hatTop->setPosition(position + Vector3(0.0f, HAT_TOP_Y_OFFSET, 0.0f));
-
-    // Eyes (rotate positions)
-    Vector3 leftEyeOffset = rotateOffset(-EYE_OFFSET_X, EYE_OFFSET_Z);
-    leftEye->setPosition(position + leftEyeOffset + Vector3(0.0f, EYE_Y_OFFSET, 0.0f));
-
-    Vector3 rightEyeOffset = rotateOffset(EYE_OFFSET_X, EYE_OFFSET_Z);
-    rightEye->setPosition(position + rightEyeOffset + Vector3(0.0f, EYE_Y_OFFSET, 0.0f));
+void Enemy::interpolate(float alpha) {
+    renderPosition = previousPosition + (position - previousPosition) * alpha;
+    // Turn the short way round when the heading wraps past +-pi
+    float turn = std::remainder(yaw - previousYaw, 2.0f * 3.14159265f);
+    renderYaw = previousYaw + turn * alpha;
 }
 
 void Enemy::takeDamage(float damage) {
     if (alive) currentHealth -= damage;
     if (currentHealth <= 0.0f) alive = false;
 }
-void Enemy::drawHealthBar() {
-    // Get current matrix
-    GLdouble modelview[16], projection[16];
-    GLint view[4];
-    glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
-    glGetDoublev(GL_PROJECTION_MATRIX, projection);
-    glGetIntegerv(GL_VIEWPORT, view);
-    
-    // Get forward vector
-    Vector3 forward(-static_cast<GLfloat>(modelview[2]), -static_cast<GLfloat>(modelview[6]), -static_cast<GLfloat>(modelview[10]));
-    
-    // Correctly calculate camera position from view matrix
-    // The view matrix is organized as:
-    // [Rx  Ry  Rz  Tx]
-    // [Ux  Uy  Uz  Ty]
-    // [Dx  Dy  Dz  Tz]
-    // [0   0   0   1 ]
-    // Where R=Right, U=Up, D=Direction, T=Translation
-    // Camera position = -R*Tx - U*Ty - D*Tz
-    Vector3 cameraPos(
-        static_cast<GLfloat>(-(modelview[0]*modelview[12] + modelview[1]*modelview[13] + modelview[2]*modelview[14])),
-        static_cast<GLfloat>(-(modelview[4]*modelview[12] + modelview[5]*modelview[13] + modelview[6]*modelview[14])),
-        static_cast<GLfloat>(-(modelview[8]*modelview[12] + modelview[9]*modelview[13] + modelview[10]*modelview[14]))
-    );
-    
-    // Get enemy direction
-    Vector3 toEnemy = position - cameraPos;
-    float length = sqrt(toEnemy.x*toEnemy.x + toEnemy.y*toEnemy.y + toEnemy.z*toEnemy.z);
-    if (length > 0) {
-        toEnemy.x /= length;
-        toEnemy.y /= length;
-        toEnemy.z /= length;
-    }
-    
-    // Check if enemy is facing camera
-    float dotProduct = forward.x * toEnemy.x + forward.y * toEnemy.y + forward.z * toEnemy.z;
-    if (dotProduct <= 0) {
-        return;
-    }
-    
-    // Project enemy position (above hat at Y +5.2)
-    GLdouble winX, winY, winZ;
-    gluProject(position.x, position.y + HEALTH_BAR_Y_OFFSET, position.z,
-               modelview, projection, view,
-               &winX, &winY, &winZ);
-    
-    // Save current matrix
-    glPushMatrix();
-    
-    // Switch to projection matrix
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    // Set orthographic projection
-    GLint viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
-    glOrtho(0, viewport[2], 0, viewport[3], -1, 1);
-    
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_LIGHTING);
-    
-    float barWidth = 100.0f;
-    float barHeight = 10.0f;
-    
-    // Draw red background
-    glColor3f(0.5f, 0.5f, 0.5f);
-    glBegin(GL_QUADS);
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2), static_cast<GLfloat>(winY));
-    glVertex2f(static_cast<GLfloat>(winX + barWidth/2), static_cast<GLfloat>(winY));
-    glVertex2f(static_cast<GLfloat>(winX + barWidth/2), static_cast<GLfloat>(winY + barHeight));
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2), static_cast<GLfloat>(winY + barHeight));
-    glEnd();
-    
-    // Draw health
-    float healthRatio = currentHealth / maxHealth;
-    if(healthRatio > 0.3f) glColor3f(0.0f, 1.0f, 0.0f);
-    else glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_QUADS);
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2), static_cast<GLfloat>(winY));
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2 + barWidth * healthRatio), static_cast<GLfloat>(winY));
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2 + barWidth * healthRatio), static_cast<GLfloat>(winY + barHeight));
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2), static_cast<GLfloat>(winY + barHeight));
-    glEnd();
-    
-    // Draw black border
-    glColor3f(0.0f, 0.0f, 0.0f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2), static_cast<GLfloat>(winY));
-    glVertex2f(static_cast<GLfloat>(winX + barWidth/2), static_cast<GLfloat>(winY));
-    glVertex2f(static_cast<GLfloat>(winX + barWidth/2), static_cast<GLfloat>(winY + barHeight));
-    glVertex2f(static_cast<GLfloat>(winX - barWidth/2), static_cast<GLfloat>(winY + barHeight));
-    glEnd();
-    
-    // Restore matrix
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-    glLineWidth(1.0f);
-    
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
+
+Vector3 Enemy::getHealthBarAnchor() const {
+    return renderPosition + Vector3(0.0f, HEALTH_BAR_Y_OFFSET, 0.0f);
 }
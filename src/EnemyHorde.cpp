@@ -0,0 +1,351 @@
+#define _USE_MATH_DEFINES
+#include "EnemyHorde.h"
+#include "Scene.h"
+#include "Bullet.h"
+#include "NavigationGrid.h"
+#include "FlowField.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+EnemyHorde::EnemyHorde(const Scene* scene)
+    : scene(scene),
+      nextId(1),
+      stepCount(0),
+      bucketsPerSide(0),
+      bucketOrigin(0.0f),
+      bucketsValid(false) {
+}
+
+void EnemyHorde::reserve(size_t count) {
+    positionX.reserve(count);
+    positionZ.reserve(count);
+    yaw.reserve(count);
+    previousX.reserve(count);
+    previousZ.reserve(count);
+    previousYaw.reserve(count);
+    health.reserve(count);
+    bodyColor.reserve(count);
+    headColor.reserve(count);
+    separationX.reserve(count);
+    separationZ.reserve(count);
+    memberId.reserve(count);
+    bucketMembers.reserve(count);
+    bucketX.reserve(count);
+    bucketZ.reserve(count);
+    memberBucket.reserve(count);
+}
+
+void EnemyHorde::add(const Vector3& position, float memberYaw, const Color& body, const Color& head) {
+    positionX.push_back(position.x);
+    positionZ.push_back(position.z);
+    yaw.push_back(memberYaw);
+    previousX.push_back(position.x);
+    previousZ.push_back(position.z);
+    previousYaw.push_back(memberYaw);
+    health.push_back(MAX_HEALTH);
+    bodyColor.push_back(body);
+    headColor.push_back(head);
+    separationX.push_back(0.0f);
+    separationZ.push_back(0.0f);
+    memberId.push_back(nextId++);
+    bucketsValid = false;
+}
+
+void EnemyHorde::clear() {
+    positionX.clear();
+    positionZ.clear();
+    yaw.clear();
+    previousX.clear();
+    previousZ.clear();
+    previousYaw.clear();
+    health.clear();
+    bodyColor.clear();
+    headColor.clear();
+    separationX.clear();
+    separationZ.clear();
+    memberId.clear();
+    bucketsValid = false;
+}
+
+int EnemyHorde::bucketOf(float x, float z) const {
+    int bx = static_cast<int>(std::floor((x - bucketOrigin) / BUCKET_SIZE));
+    int bz = static_cast<int>(std::floor((z - bucketOrigin) / BUCKET_SIZE));
+    bx = std::min(std::max(bx, 0), bucketsPerSide - 1);
+    bz = std::min(std::max(bz, 0), bucketsPerSide - 1);
+    return bz * bucketsPerSide + bx;
+}
+
+void EnemyHorde::rebuildBuckets() {
+    float groundSize = scene ? scene->getGroundSize() : NavigationGrid::GRID_OFFSET;
+    bucketOrigin = -groundSize;
+    bucketsPerSide = std::max(1, static_cast<int>(std::ceil(2.0f * groundSize / BUCKET_SIZE)));
+
+    // Counting sort by bucket; members stay in index order within a bucket
+    size_t count = size();
+    bucketStart.assign(static_cast<size_t>(bucketsPerSide) * bucketsPerSide + 1, 0);
+    memberBucket.resize(count);
+    bucketMembers.resize(count);
+    bucketX.resize(count);
+    bucketZ.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        int bucket = bucketOf(positionX[i], positionZ[i]);
+        memberBucket[i] = static_cast<uint32_t>(bucket);
+        bucketStart[bucket + 1]++;
+    }
+    for (size_t b = 1; b < bucketStart.size(); b++) {
+        bucketStart[b] += bucketStart[b - 1];
+    }
+    // Filling advances each start to its bucket's end, i.e. the next one's start ...
+    for (size_t i = 0; i < count; i++) {
+        uint32_t slot = bucketStart[memberBucket[i]]++;
+        bucketMembers[slot] = static_cast<uint32_t>(i);
+        bucketX[slot] = positionX[i];
+        bucketZ[slot] = positionZ[i];
+    }
+    // ... so shift them back by one bucket
+    for (size_t b = bucketStart.size() - 1; b > 0; b--) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+    bucketsValid = true;
+}
+
+template <typename Visit>
+void EnemyHorde::forEachNear(float x, float z, float reach, const Visit& visit) const {
+    if (!bucketsValid) {
+        for (size_t i = 0; i < size(); i++) {
+            if (!visit(static_cast<uint32_t>(i), positionX[i], positionZ[i])) return;
+        }
+        return;
+    }
+    int rings = static_cast<int>(std::ceil(reach / BUCKET_SIZE));
+    int center = bucketOf(x, z);
+    int centerX = center % bucketsPerSide;
+    int centerZ = center / bucketsPerSide;
+    int minX = std::max(centerX - rings, 0);
+    int maxX = std::min(centerX + rings, bucketsPerSide - 1);
+    for (int bz = std::max(centerZ - rings, 0); bz <= std::min(centerZ + rings, bucketsPerSide - 1); bz++) {
+        // A row of neighbouring buckets is one contiguous run
+        uint32_t first = bucketStart[bz * bucketsPerSide + minX];
+        uint32_t last = bucketStart[bz * bucketsPerSide + maxX + 1];
+        for (uint32_t k = first; k < last; k++) {
+            if (!visit(bucketMembers[k], bucketX[k], bucketZ[k])) return;
+        }
+    }
+}
+
+void EnemyHorde::update(float deltaTime, float speed, const NavigationGrid* grid, const FlowField& field,
+                        const Vector3& goal) {
+    // Copying into existing capacity: the previous pose costs no allocation
+    previousX = positionX;
+    previousZ = positionZ;
+    previousYaw = yaw;
+    rebuildBuckets();
+    stepCount++;
+
+    JobSystem::instance().parallelFor(size(), MOVE_GRAIN,
+        [this, deltaTime, speed, grid, &field, &goal](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                moveMember(i, deltaTime, speed, grid, field, goal);
+            }
+        });
+}
+
+void EnemyHorde::moveMember(size_t i, float deltaTime, float speed, const NavigationGrid* grid,
+                            const FlowField& field, const Vector3& goal) {
+    const float x = previousX[i];
+    const float z = previousZ[i];
+
+    // Seek: the field's direction, or straight on in the goal's own cell
+    float seekX = 0.0f;
+    float seekZ = 0.0f;
+    float toGoalX = goal.x - x;
+    float toGoalZ = goal.z - z;
+    float goalDistance = std::sqrt(toGoalX * toGoalX + toGoalZ * toGoalZ);
+    if (goalDistance > ARRIVE_DISTANCE && !field.sample(x, z, seekX, seekZ)) {
+        seekX = toGoalX / goalDistance;
+        seekZ = toGoalZ / goalDistance;
+    }
+
+    // Separation from the neighbours' starting poses, rescanned on this
+    // member's turn and carried over otherwise
+    float pushX = separationX[i];
+    float pushZ = separationZ[i];
+    if ((i + stepCount) % SEPARATION_INTERVAL == 0) {
+        pushX = 0.0f;
+        pushZ = 0.0f;
+        int neighbours = 0;
+        forEachNear(x, z, SEPARATION_DISTANCE, [&](uint32_t j, float otherX, float otherZ) {
+            if (j == i) return true;
+            float dx = x - otherX;
+            float dz = z - otherZ;
+            float distanceSq = dx * dx + dz * dz;
+            if (distanceSq >= SEPARATION_DISTANCE * SEPARATION_DISTANCE) return true;
+            float distance = std::sqrt(distanceSq);
+            if (distance > 1e-4f) {
+                float weight = (SEPARATION_DISTANCE - distance) / (SEPARATION_DISTANCE * distance);
+                pushX += dx * weight;
+                pushZ += dz * weight;
+            } else {
+                pushX += j > i ? 1.0f : -1.0f;  // stacked exactly: split the pair by index
+            }
+            return ++neighbours < MAX_NEIGHBOURS;
+        });
+        separationX[i] = pushX;
+        separationZ[i] = pushZ;
+    }
+
+    float velocityX = (seekX + pushX * SEPARATION_STRENGTH) * speed;
+    float velocityZ = (seekZ + pushZ * SEPARATION_STRENGTH) * speed;
+    float maxSpeed = speed * (1.0f + SEPARATION_STRENGTH);
+    float velocity = std::sqrt(velocityX * velocityX + velocityZ * velocityZ);
+    if (velocity > maxSpeed) {
+        velocityX *= maxSpeed / velocity;
+        velocityZ *= maxSpeed / velocity;
+    }
+
+    // Slide along whichever axis is still open, as EnemyManager::moveEnemy() does
+    float newX = x + velocityX * deltaTime;
+    float newZ = z + velocityZ * deltaTime;
+    bool fromBlocked = grid && grid->isBlocked(grid->worldToGridX(x), grid->worldToGridZ(z));
+    if (canMoveTo(grid, newX, newZ, fromBlocked)) {
+        positionX[i] = newX;
+        positionZ[i] = newZ;
+    } else if (canMoveTo(grid, newX, z, fromBlocked)) {
+        positionX[i] = newX;
+        positionZ[i] = z;
+    } else if (canMoveTo(grid, x, newZ, fromBlocked)) {
+        positionX[i] = x;
+        positionZ[i] = newZ;
+    } else {
+        positionX[i] = x;
+        positionZ[i] = z;
+    }
+
+    // Face where the crowd is heading, not where the jostling pushes
+    if (seekX != 0.0f || seekZ != 0.0f) {
+        yaw[i] = std::atan2(seekZ, seekX) - static_cast<float>(M_PI) / 2.0f;
+    } else {
+        yaw[i] = previousYaw[i];
+    }
+}
+
+bool EnemyHorde::canMoveTo(const NavigationGrid* grid, float x, float z, bool fromBlocked) const {
+    if (scene) {
+        float limit = scene->getGroundSize() - BODY_CLEARANCE;
+        if (x < -limit || x > limit || z < -limit || z > limit) return false;
+        if (scene->isInSafeZone(Vector3(x, 0.0f, z), BODY_CLEARANCE)) return false;
+    }
+    // A member that somehow ended up inside a blocked cell may walk out of it
+    return !grid || fromBlocked || !grid->isBlocked(grid->worldToGridX(x), grid->worldToGridZ(z));
+}
+
+int EnemyHorde::applyBullets(const std::vector<Bullet*>& bullets) {
+    Vector3 restCenters[Enemy::HIT_SPHERE_COUNT];
+    float radii[Enemy::HIT_SPHERE_COUNT];
+    Enemy::hitSpheresAt(Vector3(), restCenters, radii);
+    const float bodyRadius = radii[0];  // the body is the widest part
+
+    int kills = 0;
+    for (Bullet* bullet : bullets) {
+        if (!bullet->isActive()) continue;
+        Vector3 bulletPos = bullet->getPosition();
+        float bulletRadius = static_cast<Sphere*>(bullet->getShape())->getRadius();
+        float reach = bodyRadius + bulletRadius + MAX_DRIFT;
+
+        // First member hit in visiting order; the order is fixed, so replays agree
+        long long hit = -1;
+        forEachNear(bulletPos.x, bulletPos.z, reach, [&](uint32_t j, float, float) {
+            if (health[j] <= 0.0f) return true;
+            Vector3 centers[Enemy::HIT_SPHERE_COUNT];
+            Enemy::hitSpheresAt(getPosition(j), centers, radii);
+            for (int k = 0; k < Enemy::HIT_SPHERE_COUNT; k++) {
+                if ((bulletPos - centers[k]).length() <= radii[k] + bulletRadius) {
+                    hit = j;
+                    return false;
+                }
+            }
+            return true;
+        });
+        if (hit < 0) continue;
+
+        bullet->deactivate();
+        health[hit] -= bullet->getDamage();
+        if (health[hit] <= 0.0f) kills++;
+    }
+    return kills;
+}
+
+bool EnemyHorde::touches(const Vector3& position, float radius) const {
+    Vector3 centers[Enemy::HIT_SPHERE_COUNT];
+    float radii[Enemy::HIT_SPHERE_COUNT];
+    Enemy::hitSpheresAt(Vector3(), centers, radii);
+    float reach = radii[0] + radius;  // the body is the widest part
+
+    bool touching = false;
+    forEachNear(position.x, position.z, reach + MAX_DRIFT, [&](uint32_t j, float, float) {
+        if (health[j] <= 0.0f) return true;
+        float dx = positionX[j] - position.x;
+        float dz = positionZ[j] - position.z;
+        touching = dx * dx + dz * dz <= reach * reach;
+        return !touching;
+    });
+    return touching;
+}
+
+bool EnemyHorde::findNearest(const Vector3& from, Vector3& outPosition) const {
+    float bestDistanceSq = 0.0f;
+    bool found = false;
+    for (size_t i = 0; i < size(); i++) {
+        if (health[i] <= 0.0f) continue;
+        float dx = positionX[i] - from.x;
+        float dz = positionZ[i] - from.z;
+        float distanceSq = dx * dx + dz * dz;
+        if (!found || distanceSq < bestDistanceSq) {
+            bestDistanceSq = distanceSq;
+            outPosition = getPosition(i);
+            found = true;
+        }
+    }
+    return found;
+}
+
+size_t EnemyHorde::removeDead() {
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); i++) {
+        if (health[i] <= 0.0f) continue;
+        if (kept != i) {
+            positionX[kept] = positionX[i];
+            positionZ[kept] = positionZ[i];
+            yaw[kept] = yaw[i];
+            previousX[kept] = previousX[i];
+            previousZ[kept] = previousZ[i];
+            previousYaw[kept] = previousYaw[i];
+            health[kept] = health[i];
+            bodyColor[kept] = bodyColor[i];
+            headColor[kept] = headColor[i];
+            separationX[kept] = separationX[i];
+            separationZ[kept] = separationZ[i];
+            memberId[kept] = memberId[i];
+        }
+        kept++;
+    }
+    size_t removed = size() - kept;
+    if (removed == 0) return 0;
+
+    positionX.resize(kept);
+    positionZ.resize(kept);
+    yaw.resize(kept);
+    previousX.resize(kept);
+    previousZ.resize(kept);
+    previousYaw.resize(kept);
+    health.resize(kept);
+    bodyColor.resize(kept);
+    headColor.resize(kept);
+    separationX.resize(kept);
+    separationZ.resize(kept);
+    memberId.resize(kept);
+    bucketsValid = false;
+    return removed;
+}
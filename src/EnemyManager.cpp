@@ -4,18 +4,15 @@
 #include "Player.h"
 #include "NavigationGrid.h"
 #include "CollisionDetector.h"
+#include "JobSystem.h"
 #include <cmath>
-#include <cstdlib>
 #include <ctime>
 #include <iostream>
 #include <algorithm>
+#include <unordered_set>
 
 namespace {
-    float randomRange(float minVal, float maxVal) {
-        return minVal + (static_cast<float>(rand()) / static_cast<float>(RAND_MAX)) * (maxVal - minVal);
-    }
-
-    Vector3 sampleWanderTarget(const Scene* scene) {
+    Vector3 sampleWanderTarget(const Scene* scene, Random& random) {
         float worldLimit = 45.0f;
         if (scene) {
             worldLimit = scene->getGroundSize();
@@ -26,8 +23,8 @@ namespace {
         candidate.y = 0.0f;
         int attempts = 0;
         do {
-            candidate.x = randomRange(-worldLimit, worldLimit);
-            candidate.z = randomRange(-worldLimit, worldLimit);
+            candidate.x = random.range(-worldLimit, worldLimit);
+            candidate.z = random.range(-worldLimit, worldLimit);
             attempts++;
             if (attempts >= 10) break;
         } while (scene && scene->isInSafeZone(Vector3(candidate.x, 0.0f, candidate.z)));
@@ -38,6 +35,7 @@ namespace {
 
 EnemyManager::EnemyManager(Scene* scene)
     : scene(scene),
+      nextEnemyId(1),
       spawnTimer(0.0f),
       spawnInterval(3.0f),        // Spawn every 3 seconds
       minSpawnRadius(8.0f),       // At least 8 units from player
@@ -45,16 +43,20 @@ EnemyManager::EnemyManager(Scene* scene)
       maxEnemies(10),             // Maximum 10 enemies at once
       enemySpeed(3.0f),           // Enemy move speed
       navigationGrid(nullptr),
+      hordeMode(false),
+      hordeSpawnBatch(100),
+      horde(scene),
       damageCooldown(0.0f),
       damagePerHit(10.0f),        // 10 damage per hit
       hitCooldownDuration(1.0f)   // 1 second invincibility
 {
-    // Seed random number generator
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned>(time(nullptr)));
-        seeded = true;
-    }
+    // Unseeded managers differ run to run; setSeed() makes them reproducible
+    setSeed(static_cast<uint64_t>(time(nullptr)));
+}
+
+void EnemyManager::setSeed(uint64_t seed) {
+    spawnRandom.reseed(seed, Random::ENEMY_SPAWN);
+    wanderRandom.reseed(seed, Random::ENEMY_WANDER);
 }
 
 EnemyManager::~EnemyManager() {
@@ -72,6 +74,14 @@ void EnemyManager::update(float deltaTime, GameState state, const Vector3& playe
         damageCooldown -= deltaTime;
     }
 
+    if (hordeMode) {
+        updateHorde(deltaTime, playerPos);
+        return;
+    }
+
+    // Forget enemies the scene's bullets killed since last tick
+    removeDeadEnemies();
+
     // Update spawn timer
     spawnTimer += deltaTime;
     if (spawnTimer >= spawnInterval && static_cast<int>(managedEnemies.size()) < maxEnemies) {
@@ -81,37 +91,45 @@ void EnemyManager::update(float deltaTime, GameState state, const Vector3& playe
 
     // Update enemy movement
     updateEnemyMovement(deltaTime, playerPos);
-
-    // Remove dead enemies
-    removeDeadEnemies();
 }
 
 void EnemyManager::spawnEnemy(const Vector3& playerPos) {
     const int maxAttempts = 12;
-    Vector3 spawnPos(0.0f, 0.0f, 0.0f);
-    bool validSpawn = false;
-
-    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
-        float angle = (static_cast<float>(rand()) / RAND_MAX) * 2.0f * static_cast<float>(M_PI);
-        float distance = minSpawnRadius + (static_cast<float>(rand()) / RAND_MAX) * (maxSpawnRadius - minSpawnRadius);
-        float spawnX = playerPos.x + cos(angle) * distance;
-        float spawnZ = playerPos.z + sin(angle) * distance;
-        spawnPos = Vector3(spawnX, 0.0f, spawnZ);
-
-        if (!isValidSpawnPosition(spawnPos)) {
-            continue;
-        }
-        if (!hasPathToPlayer(spawnPos, playerPos)) {
-            continue;
-        }
 
-        validSpawn = true;
-        break;
+    // Every attempt is drawn up front and checked in parallel (each one runs
+    // A*); the first valid one in draw order wins, as it would serially
+    struct SpawnAttempt {
+        Vector3 position;
+        Vector3 pathGoal;  // the player, or somewhere to roam while they hide
+        bool valid;
+    };
+    SpawnAttempt attempts[maxAttempts];
+    const bool playerInSafeZone = scene && scene->isInSafeZone(playerPos);
+    for (SpawnAttempt& attempt : attempts) {
+        float angle = spawnRandom.range(0.0f, 2.0f * static_cast<float>(M_PI));
+        float distance = spawnRandom.range(minSpawnRadius, maxSpawnRadius);
+        attempt.position = Vector3(playerPos.x + cos(angle) * distance, 0.0f, playerPos.z + sin(angle) * distance);
+        attempt.pathGoal = playerInSafeZone ? sampleWanderTarget(scene, wanderRandom) : playerPos;
+        attempt.valid = false;
     }
+    JobSystem::instance().parallelFor(maxAttempts, 1, [this, &attempts](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            attempts[i].valid = isValidSpawnPosition(attempts[i].position) &&
+                                hasPath(attempts[i].position, attempts[i].pathGoal);
+        }
+    });
 
-    if (!validSpawn) {
+    const SpawnAttempt* chosen = nullptr;
+    for (const SpawnAttempt& attempt : attempts) {
+        if (attempt.valid) {
+            chosen = &attempt;
+            break;
+        }
+    }
+    if (!chosen) {
         return;
     }
+    Vector3 spawnPos = chosen->position;
 
     float spawnX = spawnPos.x;
     float spawnZ = spawnPos.z;
@@ -119,14 +137,15 @@ void EnemyManager::spawnEnemy(const Vector3& playerPos) {
                                (spawnZ - playerPos.z) * (spawnZ - playerPos.z));
 
     // Create enemy with random colors
-    float r1 = 0.3f + (static_cast<float>(rand()) / RAND_MAX) * 0.7f;
-    float g1 = 0.3f + (static_cast<float>(rand()) / RAND_MAX) * 0.7f;
-    float b1 = 0.3f + (static_cast<float>(rand()) / RAND_MAX) * 0.7f;
-    float r2 = 0.3f + (static_cast<float>(rand()) / RAND_MAX) * 0.7f;
-    float g2 = 0.3f + (static_cast<float>(rand()) / RAND_MAX) * 0.7f;
-    float b2 = 0.3f + (static_cast<float>(rand()) / RAND_MAX) * 0.7f;
+    float r1 = spawnRandom.range(0.3f, 1.0f);
+    float g1 = spawnRandom.range(0.3f, 1.0f);
+    float b1 = spawnRandom.range(0.3f, 1.0f);
+    float r2 = spawnRandom.range(0.3f, 1.0f);
+    float g2 = spawnRandom.range(0.3f, 1.0f);
+    float b2 = spawnRandom.range(0.3f, 1.0f);
 
     Enemy* enemy = new Enemy(spawnPos, Color(r1, g1, b1), Color(r2, g2, b2));
+    enemy->setId(nextEnemyId++);
 
     // Calculate initial yaw to face player, then rotate 90 degrees right
     float dx = playerPos.x - spawnX;
@@ -142,107 +161,193 @@ void EnemyManager::spawnEnemy(const Vector3& playerPos) {
               << " - total enemies: " << managedEnemies.size() << std::endl;
 }
 
+void EnemyManager::setHordeMode(bool enabled) {
+    if (enabled == hordeMode) return;
+    clear();
+    hordeMode = enabled;
+}
+
+void EnemyManager::updateHorde(float deltaTime, const Vector3& playerPos) {
+    // The scene's bullets, as its last update() left them, against the poses
+    // of the last step; the horde's own buckets make this a local search
+    if (scene) {
+        horde.applyBullets(scene->getBullets());
+    }
+    horde.removeDead();
+
+    // One Dijkstra pass serves every member; it only reruns when the player changes cell
+    if (navigationGrid) {
+        flowField.build(*navigationGrid, playerPos.x, playerPos.z);
+    }
+
+    spawnTimer += deltaTime;
+    int room = maxEnemies - static_cast<int>(horde.size());
+    if (spawnTimer >= spawnInterval && room > 0) {
+        spawnHorde((std::min)(hordeSpawnBatch, room), playerPos);
+        spawnTimer = 0.0f;
+    }
+
+    horde.update(deltaTime, enemySpeed, navigationGrid, flowField, playerPos);
+}
+
+void EnemyManager::spawnHorde(int count, const Vector3& playerPos) {
+    // Anywhere on the ground clear of the player, not just the spawn ring
+    // around them: tens of thousands would not fit in it
+    float limit = (scene ? scene->getGroundSize() : 45.0f) - 2.0f;
+    horde.reserve(static_cast<size_t>((std::max)(maxEnemies, 0)));
+
+    int added = 0;
+    for (int attempt = 0; attempt < count * 4 && added < count; attempt++) {
+        Vector3 spawnPos(spawnRandom.range(-limit, limit), 0.0f, spawnRandom.range(-limit, limit));
+        float dx = playerPos.x - spawnPos.x;
+        float dz = playerPos.z - spawnPos.z;
+        if (dx * dx + dz * dz < minSpawnRadius * minSpawnRadius) continue;
+        if (scene && scene->isInSafeZone(spawnPos, ENEMY_RADIUS)) continue;
+        // Free cells the field reaches are exactly those with a path to the player
+        if (navigationGrid && !flowField.isReachable(spawnPos.x, spawnPos.z)) continue;
+
+        // Same draws as spawnEnemy(): head color first, then body
+        float r1 = spawnRandom.range(0.3f, 1.0f);
+        float g1 = spawnRandom.range(0.3f, 1.0f);
+        float b1 = spawnRandom.range(0.3f, 1.0f);
+        float r2 = spawnRandom.range(0.3f, 1.0f);
+        float g2 = spawnRandom.range(0.3f, 1.0f);
+        float b2 = spawnRandom.range(0.3f, 1.0f);
+        float initialYaw = atan2(dz, dx) - static_cast<float>(M_PI) / 2.0f;
+        horde.add(spawnPos, initialYaw, Color(r2, g2, b2), Color(r1, g1, b1));
+        added++;
+    }
+}
+
 void EnemyManager::updateEnemyMovement(float deltaTime, const Vector3& playerPos) {
-    const float WAYPOINT_THRESHOLD = 0.5f;
-    const float REPLAN_INTERVAL = 0.5f;
-    const float SAFE_ZONE_REPLAN_INTERVAL = 1.5f;
-    const float MOVE_EPSILON = 0.01f;
     const bool playerInSafeZone = scene && scene->isInSafeZone(playerPos);
 
+    // Serial pass: path bookkeeping that touches pathInfo's layout, and the
+    // wander draws, in enemy order
+    moveTasks.clear();
     for (Enemy* enemy : managedEnemies) {
         if (!enemy || !enemy->isAlive()) continue;
 
-        Vector3 enemyPos = enemy->getPosition();
-        Vector3 targetPos = playerPos;
-
+        MoveTask task{enemy, nullptr, false, Vector3()};
         if (navigationGrid) {
-            EnemyPathInfo& info = pathInfo[enemy];
+            EnemyPathInfo& info = pathInfo[enemy];  // element references survive rehashing
             info.replanTimer -= deltaTime;
+            if (playerInSafeZone &&
+                (info.path.empty() || info.replanTimer <= 0.0f || info.nextIndex >= info.path.size())) {
+                task.replanWander = true;
+                task.wanderTarget = sampleWanderTarget(scene, wanderRandom);
+            }
+            task.info = &info;
+        }
+        moveTasks.push_back(task);
+    }
 
-            if (playerInSafeZone) {
-                info.wandering = true;
-                if (info.path.empty() || info.replanTimer <= 0.0f || info.nextIndex >= info.path.size()) {
-                    info.path.clear();
-                    Vector3 wanderTarget = sampleWanderTarget(scene);
-                    navigationGrid->findPath(enemyPos.x, enemyPos.z, wanderTarget.x, wanderTarget.z, info.path);
-                    info.nextIndex = 0;
-                    info.replanTimer = SAFE_ZONE_REPLAN_INTERVAL;
-                }
-            } else {
-                if (info.wandering) {
-                    info.wandering = false;
-                    info.nextIndex = 0;
-                    info.path.clear();
-                }
+    // Parallel pass: path requests and steering; enemies never block each other
+    JobSystem::instance().parallelFor(moveTasks.size(), MOVE_GRAIN,
+        [this, deltaTime, &playerPos, playerInSafeZone](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                moveEnemy(moveTasks[i], deltaTime, playerPos, playerInSafeZone);
+            }
+        });
+}
 
-                int startGX = navigationGrid->worldToGridX(enemyPos.x);
-                int startGZ = navigationGrid->worldToGridZ(enemyPos.z);
-                int goalGX = navigationGrid->worldToGridX(playerPos.x);
-                int goalGZ = navigationGrid->worldToGridZ(playerPos.z);
-
-                bool needReplan = info.path.empty() ||
-                                  info.replanTimer <= 0.0f ||
-                                  startGX != info.lastStartX || startGZ != info.lastStartZ ||
-                                  goalGX != info.lastGoalX || goalGZ != info.lastGoalZ ||
-                                  info.nextIndex >= info.path.size();
-
-                if (needReplan) {
-                    info.path.clear();
-                    navigationGrid->findPath(enemyPos.x, enemyPos.z, playerPos.x, playerPos.z, info.path);
-                    info.nextIndex = 0;
-                    info.replanTimer = REPLAN_INTERVAL;
-                    info.lastStartX = startGX;
-                    info.lastStartZ = startGZ;
-                    info.lastGoalX = goalGX;
-                    info.lastGoalZ = goalGZ;
-                }
+void EnemyManager::moveEnemy(const MoveTask& task, float deltaTime, const Vector3& playerPos,
+                             bool playerInSafeZone) const {
+    const float WAYPOINT_THRESHOLD = 0.5f;
+    const float REPLAN_INTERVAL = 0.5f;
+    const float SAFE_ZONE_REPLAN_INTERVAL = 1.5f;
+    const float MOVE_EPSILON = 0.01f;
+
+    Enemy* enemy = task.enemy;
+    Vector3 enemyPos = enemy->getPosition();
+    Vector3 targetPos = playerPos;
+
+    if (task.info) {
+        EnemyPathInfo& info = *task.info;
+
+        if (playerInSafeZone) {
+            info.wandering = true;
+            if (task.replanWander) {
+                info.path.clear();
+                navigationGrid->findPath(enemyPos.x, enemyPos.z, task.wanderTarget.x, task.wanderTarget.z,
+                                         info.path);
+                info.nextIndex = 0;
+                info.replanTimer = SAFE_ZONE_REPLAN_INTERVAL;
+            }
+        } else {
+            if (info.wandering) {
+                info.wandering = false;
+                info.nextIndex = 0;
+                info.path.clear();
+            }
+
+            int startGX = navigationGrid->worldToGridX(enemyPos.x);
+            int startGZ = navigationGrid->worldToGridZ(enemyPos.z);
+            int goalGX = navigationGrid->worldToGridX(playerPos.x);
+            int goalGZ = navigationGrid->worldToGridZ(playerPos.z);
+
+            bool needReplan = info.path.empty() ||
+                              info.replanTimer <= 0.0f ||
+                              startGX != info.lastStartX || startGZ != info.lastStartZ ||
+                              goalGX != info.lastGoalX || goalGZ != info.lastGoalZ ||
+                              info.nextIndex >= info.path.size();
+
+            if (needReplan) {
+                info.path.clear();
+                navigationGrid->findPath(enemyPos.x, enemyPos.z, playerPos.x, playerPos.z, info.path);
+                info.nextIndex = 0;
+                info.replanTimer = REPLAN_INTERVAL;
+                info.lastStartX = startGX;
+                info.lastStartZ = startGZ;
+                info.lastGoalX = goalGX;
+                info.lastGoalZ = goalGZ;
             }
+        }
 
-            if (info.nextIndex < info.path.size()) {
-                targetPos = info.path[info.nextIndex];
-                float dxw = targetPos.x - enemyPos.x;
-                float dzw = targetPos.z - enemyPos.z;
-                float distw = std::sqrt(dxw * dxw + dzw * dzw);
-                if (distw < WAYPOINT_THRESHOLD) {
-                    info.nextIndex++;
-                    if (info.nextIndex < info.path.size()) {
-                        targetPos = info.path[info.nextIndex];
-                    } else if (playerInSafeZone) {
-                        targetPos = enemyPos;
-                    } else {
-                        targetPos = playerPos;
-                    }
+        if (info.nextIndex < info.path.size()) {
+            targetPos = info.path[info.nextIndex];
+            float dxw = targetPos.x - enemyPos.x;
+            float dzw = targetPos.z - enemyPos.z;
+            float distw = std::sqrt(dxw * dxw + dzw * dzw);
+            if (distw < WAYPOINT_THRESHOLD) {
+                info.nextIndex++;
+                if (info.nextIndex < info.path.size()) {
+                    targetPos = info.path[info.nextIndex];
+                } else if (playerInSafeZone) {
+                    targetPos = enemyPos;
+                } else {
+                    targetPos = playerPos;
                 }
             }
         }
+    }
 
-        float dx = targetPos.x - enemyPos.x;
-        float dz = targetPos.z - enemyPos.z;
-        float distance = sqrt(dx * dx + dz * dz);
+    float dx = targetPos.x - enemyPos.x;
+    float dz = targetPos.z - enemyPos.z;
+    float distance = sqrt(dx * dx + dz * dz);
 
-        if (distance > 0.01f) {
-            float angleToTarget = atan2(dz, dx) - static_cast<float>(M_PI) / 2.0f;
-            enemy->setYaw(angleToTarget);
-        }
+    if (distance > 0.01f) {
+        float angleToTarget = atan2(dz, dx) - static_cast<float>(M_PI) / 2.0f;
+        enemy->setYaw(angleToTarget);
+    }
 
-        if (distance > 0.1f) {
-            dx /= distance;
-            dz /= distance;
+    if (distance > 0.1f) {
+        dx /= distance;
+        dz /= distance;
 
-            float step = enemySpeed * deltaTime;
-            float moveX = dx * step;
-            float moveZ = dz * step;
+        float step = enemySpeed * deltaTime;
+        float moveX = dx * step;
+        float moveZ = dz * step;
 
-            float newX = enemyPos.x + moveX;
-            float newZ = enemyPos.z + moveZ;
+        float newX = enemyPos.x + moveX;
+        float newZ = enemyPos.z + moveZ;
 
-            if (canMoveTo(newX, newZ)) {
-                enemy->setPosition(Vector3(newX, enemyPos.y, newZ));
-            } else if (std::fabs(moveX) > MOVE_EPSILON && canMoveTo(newX, enemyPos.z)) {
-                enemy->setPosition(Vector3(newX, enemyPos.y, enemyPos.z));
-            } else if (std::fabs(moveZ) > MOVE_EPSILON && canMoveTo(enemyPos.x, newZ)) {
-                enemy->setPosition(Vector3(enemyPos.x, enemyPos.y, newZ));
-            }
+        if (canMoveTo(newX, newZ)) {
+            enemy->setPosition(Vector3(newX, enemyPos.y, newZ));
+        } else if (std::fabs(moveX) > MOVE_EPSILON && canMoveTo(newX, enemyPos.z)) {
+            enemy->setPosition(Vector3(newX, enemyPos.y, enemyPos.z));
+        } else if (std::fabs(moveZ) > MOVE_EPSILON && canMoveTo(enemyPos.x, newZ)) {
+            enemy->setPosition(Vector3(enemyPos.x, enemyPos.y, newZ));
         }
     }
 }
@@ -256,8 +361,11 @@ float EnemyManager::checkPlayerCollision(Player* player, float deltaTime) {
         return 0.0f;
     }
 
-    // Use Player's existing collision check with enemies
-    if (player->checkCollision(managedEnemies)) {
+    // Use Player's existing collision check with enemies; the horde has no
+    // shapes to test, so its members are checked against the player's radius
+    bool hit = hordeMode ? horde.touches(player->getPosition(), PLAYER_RADIUS)
+                         : player->checkCollision(managedEnemies);
+    if (hit) {
         damageCooldown = hitCooldownDuration;
         std::cout << "Player hit by enemy! Damage: " << damagePerHit << std::endl;
         return damagePerHit;
@@ -266,29 +374,27 @@ float EnemyManager::checkPlayerCollision(Player* player, float deltaTime) {
     return 0.0f;
 }
 
-bool EnemyManager::hasPathToPlayer(const Vector3& spawnPos, const Vector3& playerPos) const {
+bool EnemyManager::hasPath(const Vector3& from, const Vector3& to) const {
     if (!navigationGrid || !scene) {
         return true;
     }
 
-    Vector3 targetPos = playerPos;
-    if (scene->isInSafeZone(playerPos)) {
-        targetPos = sampleWanderTarget(scene);
-    }
-
     std::vector<Vector3> path;
-    if (!navigationGrid->findPath(spawnPos.x, spawnPos.z, targetPos.x, targetPos.z, path)) {
+    if (!navigationGrid->findPath(from.x, from.z, to.x, to.z, path)) {
         return false;
     }
     return !path.empty();
 }
 
 void EnemyManager::removeDeadEnemies() {
-    // Note: Scene also removes dead enemies in checkBulletCollisions
-    // We just need to clean up our tracking list
+    // Scene deletes the enemies its bullets kill, so one it no longer lists
+    // is gone and must not be dereferenced
+    if (!scene) return;
+    const std::vector<Enemy*>& sceneEnemies = scene->getEnemies();
+    std::unordered_set<const Enemy*> alive(sceneEnemies.begin(), sceneEnemies.end());
     auto it = managedEnemies.begin();
     while (it != managedEnemies.end()) {
-        if (*it == nullptr || !(*it)->isAlive()) {
+        if (*it == nullptr || alive.count(*it) == 0) {
             pathInfo.erase(*it);
             it = managedEnemies.erase(it);
         } else {
@@ -318,6 +424,7 @@ void EnemyManager::clear() {
     // Note: Enemies are owned by Scene, so we don't delete them here
     managedEnemies.clear();
     pathInfo.clear();
+    horde.clear();
     spawnTimer = 0.0f;
     damageCooldown = 0.0f;
 }
@@ -0,0 +1,422 @@
+#include "EnemyRenderer.h"
+#include "Enemy.h"
+#include "Shapes.h"
+#include "ShapeRenderer.h"
+#include "GpuMesh.h"
+#include "HudBatch.h"
+#include "StreamBuffer.h"
+#include <algorithm>
+#include <iostream>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+// Generic attribute slots for per-instance data. 9-11 alias texture units 1-3
+// on drivers that alias conventional attributes, which the meshes never use.
+constexpr GLuint ATTRIB_INSTANCE_POSITION_YAW = 9;
+constexpr GLuint ATTRIB_INSTANCE_BODY_COLOR = 10;
+constexpr GLuint ATTRIB_INSTANCE_HEAD_COLOR = 11;
+
+constexpr int LOD_KEY_BITS = 2;
+static_assert(LevelOfDetail::LEVEL_COUNT <= (1 << LOD_KEY_BITS), "LOD level must fit in its key bits");
+static_assert(Enemy::PART_COUNT * LOD_KEY_BITS <= 32, "LOD key must fit in 32 bits");
+
+// Per-vertex lighting mirrors the fixed-function model Lighting sets up
+// (GL_LIGHT0, color material for ambient/diffuse, material specular/shininess)
+const char* ENEMY_VERTEX_SHADER = R"(
+#version 120
+attribute vec4 instancePositionYaw;
+attribute vec3 instanceBodyColor;
+attribute vec3 instanceHeadColor;
+
+uniform mat4 partMatrix;
+uniform mat3 partNormalMatrix;
+uniform vec3 partColor;
+uniform int colorSource;
+uniform bool lightingEnabled;
+
+varying vec4 litColor;
+
+vec3 rotateYaw(vec3 v, float c, float s) {
+    return vec3(v.x * c - v.z * s, v.y, v.x * s + v.z * c);
+}
+
+vec3 shade(vec3 eyePos, vec3 n, vec3 baseColor) {
+    vec3 L;
+    float attenuation = 1.0;
+    if (gl_LightSource[0].position.w == 0.0) {
+        L = normalize(gl_LightSource[0].position.xyz);
+    } else {
+        vec3 toLight = gl_LightSource[0].position.xyz - eyePos;
+        float dist = length(toLight);
+        L = toLight / dist;
+        attenuation = 1.0 / (gl_LightSource[0].constantAttenuation +
+                             gl_LightSource[0].linearAttenuation * dist +
+                             gl_LightSource[0].quadraticAttenuation * dist * dist);
+    }
+
+    float diffuse = max(dot(n, L), 0.0);
+    float specular = 0.0;
+    if (diffuse > 0.0) {
+        vec3 H = normalize(L + vec3(0.0, 0.0, 1.0));
+        specular = pow(max(dot(n, H), 0.0), gl_FrontMaterial.shininess);
+    }
+
+    return gl_LightModel.ambient.rgb * baseColor +
+           attenuation * (gl_LightSource[0].ambient.rgb * baseColor +
+                          gl_LightSource[0].diffuse.rgb * baseColor * diffuse +
+                          gl_LightSource[0].specular.rgb * gl_FrontMaterial.specular.rgb * specular);
+}
+
+void main() {
+    float c = cos(instancePositionYaw.w);
+    float s = sin(instancePositionYaw.w);
+
+    vec3 local = (partMatrix * gl_Vertex).xyz;
+    vec4 world = vec4(rotateYaw(local, c, s) + instancePositionYaw.xyz, 1.0);
+    vec3 worldNormal = rotateYaw(partNormalMatrix * gl_Normal, c, s);
+
+    vec3 baseColor = partColor;
+    if (colorSource == 1) baseColor = instanceBodyColor;
+    else if (colorSource == 2) baseColor = instanceHeadColor;
+
+    vec4 eyePos = gl_ModelViewMatrix * world;
+    gl_Position = gl_ProjectionMatrix * eyePos;
+
+    if (lightingEnabled) {
+        litColor = vec4(shade(eyePos.xyz, normalize(gl_NormalMatrix * worldNormal), baseColor), 1.0);
+    } else {
+        litColor = vec4(baseColor, 1.0);
+    }
+}
+)";
+
+const char* ENEMY_FRAGMENT_SHADER = R"(
+#version 120
+varying vec4 litColor;
+
+void main() {
+    gl_FragColor = litColor;
+}
+)";
+
+}  // namespace
+
+EnemyRenderer::EnemyRenderer()
+    : instanceBuffer(0), instanceCapacity(0), drawInstanceBuffer(0), drawInstanceOffset(0), supported(false), lastDrawCalls(0),
+      partMatrixLoc(-1), partNormalMatrixLoc(-1), partColorLoc(-1), colorSourceLoc(-1), lightingEnabledLoc(-1) {}
+
+EnemyRenderer::~EnemyRenderer() {
+    if (instanceBuffer != 0) glDeleteBuffers(1, &instanceBuffer);
+}
+
+bool EnemyRenderer::initialize() {
+    supported = false;
+
+    // Instanced draws + attribute divisors are core in 3.3
+    if (!GLEW_VERSION_3_3) {
+        std::cout << "EnemyRenderer: OpenGL 3.3 not available, using per-enemy drawing" << std::endl;
+        return false;
+    }
+
+    bool built = program.build("enemy", ENEMY_VERTEX_SHADER, ENEMY_FRAGMENT_SHADER, {
+        {ATTRIB_INSTANCE_POSITION_YAW, "instancePositionYaw"},
+        {ATTRIB_INSTANCE_BODY_COLOR, "instanceBodyColor"},
+        {ATTRIB_INSTANCE_HEAD_COLOR, "instanceHeadColor"},
+    });
+    if (!built) {
+        std::cout << "EnemyRenderer: Shader build failed, using per-enemy drawing" << std::endl;
+        return false;
+    }
+
+    partMatrixLoc = program.getUniformLocation("partMatrix");
+    partNormalMatrixLoc = program.getUniformLocation("partNormalMatrix");
+    partColorLoc = program.getUniformLocation("partColor");
+    colorSourceLoc = program.getUniformLocation("colorSource");
+    lightingEnabledLoc = program.getUniformLocation("lightingEnabled");
+
+    // Prototype snowmen at the origin facing +Z, one per detail level: their parts
+    // are already in enemy-local space and hold that level's meshes
+    for (int level = 0; level < LevelOfDetail::LEVEL_COUNT; level++) {
+        prototypes[level] = std::make_unique<Enemy>(Vector3());
+        for (Shape* shape : prototypes[level]->getParts()) {
+            shape->setLodLevel(level);
+        }
+    }
+
+    std::vector<Shape*> shapes = prototypes[0]->getParts();
+    parts.clear();
+    for (size_t i = 0; i < shapes.size(); i++) {
+        Shape* shape = shapes[i];
+        Part part;
+        for (int level = 0; level < LevelOfDetail::LEVEL_COUNT; level++) {
+            part.meshes[level] = &ShapeRenderer::ensureMesh(*prototypes[level]->getParts()[i]);
+        }
+        part.model = shape->getModelMatrix();
+        part.model.normalMatrix(part.normalMatrix);
+
+        // Cylinders keep their color in the side/cap slots
+        if (Cylinder* cylinder = dynamic_cast<Cylinder*>(shape)) part.color = cylinder->getSideColor();
+        else part.color = shape->getColor();
+
+        if (static_cast<int>(i) == Enemy::BODY_PART_INDEX) part.colorSource = 1;
+        else if (static_cast<int>(i) == Enemy::HEAD_PART_INDEX) part.colorSource = 2;
+        else part.colorSource = 0;
+
+        parts.push_back(part);
+    }
+
+    glGenBuffers(1, &instanceBuffer);
+    supported = true;
+    std::cout << "EnemyRenderer: Instanced snowman rendering enabled (" << parts.size() << " parts)" << std::endl;
+    return true;
+}
+
+EnemyRenderer::Instance EnemyRenderer::makeInstance(Enemy& enemy) {
+    Instance instance;
+    Vector3 pos = enemy.getRenderPosition();
+    Color body = enemy.getColor(Enemy::BODY);
+    Color head = enemy.getColor(Enemy::HEAD);
+    instance.position[0] = pos.x;
+    instance.position[1] = pos.y;
+    instance.position[2] = pos.z;
+    instance.yaw = enemy.getRenderYaw();
+    instance.bodyColor[0] = body.r;
+    instance.bodyColor[1] = body.g;
+    instance.bodyColor[2] = body.b;
+    instance.headColor[0] = head.r;
+    instance.headColor[1] = head.g;
+    instance.headColor[2] = head.b;
+    return instance;
+}
+
+void EnemyRenderer::drawImmediate(Enemy& enemy) {
+    updateLod(enemy);
+    Shape* shapes[Enemy::PART_COUNT];
+    enemy.collectParts(shapes);
+    Vector3 renderPosition = enemy.getRenderPosition();
+
+    // Main body structure; the spheres sit at the simulated position
+    Vector3 offset = renderPosition - enemy.getPosition();
+    glPushMatrix();
+    glTranslatef(offset.x, offset.y, offset.z);
+    ShapeRenderer::draw(*shapes[Enemy::BODY_PART_INDEX]);
+    ShapeRenderer::draw(*shapes[Enemy::HEAD_PART_INDEX]);
+    glPopMatrix();
+
+    // Decorations, in local space under the enemy transform.
+    // Offsets rotate as (x cos - z sin, x sin + z cos), i.e. -yaw about +Y in GL terms.
+    glPushMatrix();
+    glTranslatef(renderPosition.x, renderPosition.y, renderPosition.z);
+    glRotatef(-enemy.getRenderYaw() * 180.0f / 3.14159265f, 0.0f, 1.0f, 0.0f);
+    for (int i = 0; i < Enemy::PART_COUNT; i++) {
+        if (i == Enemy::BODY_PART_INDEX || i == Enemy::HEAD_PART_INDEX) continue;
+        ShapeRenderer::draw(*shapes[i]);
+    }
+    glPopMatrix();
+
+    // Health bar (rendered last for proper overlay)
+    drawHealthBar(enemy);
+}
+
+void EnemyRenderer::drawHealthBar(const Enemy& enemy) {
+    // Queued into the frame's HUD batch; bars anchored behind the camera are skipped
+    HudBatch& hud = HudBatch::instance();
+    float winX, winY;
+    if (!hud.project(enemy.getHealthBarAnchor(), winX, winY)) {
+        return;
+    }
+
+    float barWidth = 100.0f;
+    float barHeight = 10.0f;
+    float left = winX - barWidth / 2;
+    float right = winX + barWidth / 2;
+
+    // Background, health, border
+    hud.addQuad(left, winY, right, winY + barHeight, Color(0.5f, 0.5f, 0.5f));
+    float healthRatio = enemy.getHealth() / enemy.getMaxHealth();
+    Color healthColor = healthRatio > 0.3f ? Color(0.0f, 1.0f, 0.0f) : Color(1.0f, 0.0f, 0.0f);
+    hud.addQuad(left, winY, left + barWidth * healthRatio, winY + barHeight, healthColor);
+    hud.addRectOutline(left, winY, right, winY + barHeight, 2.0f, Color(0.0f, 0.0f, 0.0f));
+}
+
+void EnemyRenderer::updateLod(Enemy& enemy) {
+    // Decorations live in local space, so every part is judged at the enemy's center
+    Vector3 center;
+    float radius;
+    enemy.getBoundingSphere(center, radius);
+    Shape* parts[Enemy::PART_COUNT];
+    enemy.collectParts(parts);
+    for (Shape* part : parts) {
+        ShapeRenderer::updateLod(*part, center);
+    }
+}
+
+int EnemyRenderer::partLevel(uint32_t lodKey, int partIndex) {
+    int shift = (Enemy::PART_COUNT - 1 - partIndex) * LOD_KEY_BITS;
+    return static_cast<int>((lodKey >> shift) & ((1u << LOD_KEY_BITS) - 1));
+}
+
+void EnemyRenderer::draw(const std::vector<Enemy*>& enemies, bool lightingEnabled) {
+    frameSortBuffer.clear();
+    for (Enemy* enemy : enemies) {
+        updateLod(*enemy);
+        int levels[Enemy::PART_COUNT];
+        enemy->getPartLodLevels(levels);
+
+        uint32_t key = 0;
+        for (int i = 0; i < Enemy::PART_COUNT; i++) {
+            key = (key << LOD_KEY_BITS) | static_cast<uint32_t>(levels[i]);
+        }
+        frameSortBuffer.push_back(std::make_pair(key, makeInstance(*enemy)));
+    }
+    drawSorted(lightingEnabled);
+}
+
+void EnemyRenderer::drawCrowd(const std::vector<Instance>& instances, const std::vector<uint32_t>& ids,
+                              bool lightingEnabled) {
+    const LevelOfDetail& lod = LevelOfDetail::instance();
+    previousCrowdLevels.swap(crowdLevels);
+    crowdLevels.clear();
+    frameSortBuffer.clear();
+    // Both lists ascend by id, so one forward walk finds each member's last level
+    size_t previous = 0;
+    for (size_t i = 0; i < instances.size(); i++) {
+        const Instance& instance = instances[i];
+        while (previous < previousCrowdLevels.size() && previousCrowdLevels[previous].first < ids[i]) previous++;
+        int previousLevel = 0;
+        if (previous < previousCrowdLevels.size() && previousCrowdLevels[previous].first == ids[i]) {
+            previousLevel = previousCrowdLevels[previous].second;
+        }
+
+        Vector3 center;
+        float radius;
+        Enemy::boundingSphereAt(Vector3(instance.position[0], instance.position[1], instance.position[2]),
+                                center, radius);
+        int selected = lod.select(center, radius, previousLevel);
+        crowdLevels.push_back(std::make_pair(ids[i], selected));
+        uint32_t level = static_cast<uint32_t>(selected);
+        uint32_t key = 0;
+        for (int i = 0; i < Enemy::PART_COUNT; i++) {
+            key = (key << LOD_KEY_BITS) | level;
+        }
+        frameSortBuffer.push_back(std::make_pair(key, instance));
+    }
+    drawSorted(lightingEnabled);
+}
+
+void EnemyRenderer::drawSorted(bool lightingEnabled) {
+    // Enemies with the same per-part levels end up adjacent, so each part's
+    // levels form a handful of contiguous runs
+    std::sort(frameSortBuffer.begin(), frameSortBuffer.end(),
+              [](const std::pair<uint32_t, Instance>& a, const std::pair<uint32_t, Instance>& b) {
+                  return a.first < b.first;
+              });
+
+    frameInstances.clear();
+    frameLodKeys.clear();
+    for (const auto& entry : frameSortBuffer) {
+        frameLodKeys.push_back(entry.first);
+        frameInstances.push_back(entry.second);
+    }
+    drawBatches(frameInstances, &frameLodKeys, lightingEnabled);
+}
+
+void EnemyRenderer::uploadInstances(const std::vector<Instance>& instances) {
+    size_t bytes = instances.size() * sizeof(Instance);
+    StreamBuffer& ring = StreamBuffer::instance();
+    if (StreamBuffer::Allocation allocation = ring.allocate(bytes)) {
+        std::memcpy(allocation.data, instances.data(), bytes);
+        ring.commit(allocation);
+        drawInstanceBuffer = allocation.buffer;
+        drawInstanceOffset = allocation.offset;
+        return;
+    }
+
+    // Grow geometrically so a rising enemy count doesn't reallocate every frame
+    if (bytes > instanceCapacity) instanceCapacity = bytes * 2;
+
+    // Orphan last frame's storage instead of waiting for the GPU to finish with it
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    drawInstanceBuffer = instanceBuffer;
+    drawInstanceOffset = 0;
+}
+
+void EnemyRenderer::draw(const std::vector<Instance>& instances, bool lightingEnabled) {
+    drawBatches(instances, nullptr, lightingEnabled);
+}
+
+void EnemyRenderer::drawBatches(const std::vector<Instance>& instances, const std::vector<uint32_t>* lodKeys,
+                                bool lightingEnabled) {
+    lastDrawCalls = 0;
+    if (!supported || instances.empty()) return;
+
+    uploadInstances(instances);
+
+    glDisable(GL_TEXTURE_2D);
+    program.use();
+    glUniform1i(lightingEnabledLoc, lightingEnabled ? 1 : 0);
+
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_POSITION_YAW);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_BODY_COLOR);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_HEAD_COLOR);
+    glVertexAttribDivisor(ATTRIB_INSTANCE_POSITION_YAW, 1);
+    glVertexAttribDivisor(ATTRIB_INSTANCE_BODY_COLOR, 1);
+    glVertexAttribDivisor(ATTRIB_INSTANCE_HEAD_COLOR, 1);
+
+    for (size_t p = 0; p < parts.size(); p++) {
+        const Part& part = parts[p];
+        glUniformMatrix4fv(partMatrixLoc, 1, GL_FALSE, part.model.data());
+        glUniformMatrix3fv(partNormalMatrixLoc, 1, GL_FALSE, part.normalMatrix);
+        glUniform3f(partColorLoc, part.color.r, part.color.g, part.color.b);
+        glUniform1i(colorSourceLoc, part.colorSource);
+
+        // One draw per run of instances that share this part's level; without
+        // LOD keys every instance uses level 0, so the whole array is one run
+        size_t first = 0;
+        while (first < instances.size()) {
+            int level = lodKeys ? partLevel((*lodKeys)[first], static_cast<int>(p)) : 0;
+            size_t end = lodKeys ? first + 1 : instances.size();
+            while (end < instances.size() && partLevel((*lodKeys)[end], static_cast<int>(p)) == level) {
+                end++;
+            }
+            drawPartRange(part, level, first, end - first);
+            first = end;
+        }
+    }
+
+    glVertexAttribDivisor(ATTRIB_INSTANCE_POSITION_YAW, 0);
+    glVertexAttribDivisor(ATTRIB_INSTANCE_BODY_COLOR, 0);
+    glVertexAttribDivisor(ATTRIB_INSTANCE_HEAD_COLOR, 0);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_POSITION_YAW);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_BODY_COLOR);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_HEAD_COLOR);
+    ShaderProgram::useNone();
+}
+
+void EnemyRenderer::drawPartRange(const Part& part, int level, size_t first, size_t count) {
+    GpuMesh* mesh = part.meshes[level];
+    mesh->bind();
+
+    // Attribute pointers latch the buffer bound at the time of the call; offsetting
+    // them to the run's first instance stands in for a base-instance draw
+    size_t base = drawInstanceOffset + first * sizeof(Instance);
+    glBindBuffer(GL_ARRAY_BUFFER, drawInstanceBuffer);
+    glVertexAttribPointer(ATTRIB_INSTANCE_POSITION_YAW, 4, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<const void*>(base + offsetof(Instance, position)));
+    glVertexAttribPointer(ATTRIB_INSTANCE_BODY_COLOR, 3, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<const void*>(base + offsetof(Instance, bodyColor)));
+    glVertexAttribPointer(ATTRIB_INSTANCE_HEAD_COLOR, 3, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<const void*>(base + offsetof(Instance, headColor)));
+
+    GLsizei instanceCount = static_cast<GLsizei>(count);
+    glDrawElementsInstanced(GL_TRIANGLES, mesh->getIndexCount(), GL_UNSIGNED_INT, nullptr, instanceCount);
+    lastDrawCalls++;
+    LevelOfDetail::instance().recordDraw(level, mesh->getIndexCount() / 3, instanceCount);
+
+    mesh->unbind();
+}
@@ -0,0 +1,118 @@
+#include "FlowField.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+FlowField::FlowField()
+    : grid(nullptr),
+      distance(CELL_COUNT, std::numeric_limits<float>::infinity()),
+      directionX(CELL_COUNT, 0.0f),
+      directionZ(CELL_COUNT, 0.0f),
+      goalX(-1),
+      goalZ(-1),
+      valid(false),
+      buildCount(0) {
+}
+
+bool FlowField::build(const NavigationGrid& navigationGrid, float worldGoalX, float worldGoalZ) {
+    int gx = navigationGrid.worldToGridX(worldGoalX);
+    int gz = navigationGrid.worldToGridZ(worldGoalZ);
+    gx = gx < 0 ? 0 : (gx >= SIZE ? SIZE - 1 : gx);
+    gz = gz < 0 ? 0 : (gz >= SIZE ? SIZE - 1 : gz);
+    if (valid && grid == &navigationGrid && gx == goalX && gz == goalZ) {
+        return false;
+    }
+
+    grid = &navigationGrid;
+    goalX = gx;
+    goalZ = gz;
+    std::fill(distance.begin(), distance.end(), std::numeric_limits<float>::infinity());
+    std::fill(directionX.begin(), directionX.end(), 0.0f);
+    std::fill(directionZ.begin(), directionZ.end(), 0.0f);
+
+    struct OpenNode {
+        float cost;
+        int index;
+    };
+    struct OpenCompare {
+        bool operator()(const OpenNode& a, const OpenNode& b) const {
+            return a.cost > b.cost;
+        }
+    };
+    std::priority_queue<OpenNode, std::vector<OpenNode>, OpenCompare> open;
+
+    const int directions[8][2] = {
+        {1, 0}, {-1, 0}, {0, 1}, {0, -1},
+        {1, 1}, {1, -1}, {-1, 1}, {-1, -1}
+    };
+    const float INV_SQRT2 = 0.70710678f;
+
+    int goalIndex = gz * SIZE + gx;
+    distance[goalIndex] = 0.0f;
+    open.push({0.0f, goalIndex});
+
+    // Each cell's direction points back at the neighbour it was reached from,
+    // i.e. one step along its cheapest path to the goal
+    while (!open.empty()) {
+        OpenNode current = open.top();
+        open.pop();
+        if (current.cost > distance[current.index]) continue;  // stale entry
+
+        int curX = current.index % SIZE;
+        int curZ = current.index / SIZE;
+        for (const auto& dir : directions) {
+            int nextX = curX + dir[0];
+            int nextZ = curZ + dir[1];
+            if (navigationGrid.isBlocked(nextX, nextZ)) continue;  // also rejects out of bounds
+
+            bool diagonal = dir[0] != 0 && dir[1] != 0;
+            if (diagonal && (navigationGrid.isBlocked(curX + dir[0], curZ) ||
+                             navigationGrid.isBlocked(curX, curZ + dir[1]))) {
+                continue;
+            }
+
+            int nextIndex = nextZ * SIZE + nextX;
+            float cost = current.cost + (diagonal ? 1.41421356f : 1.0f);
+            if (cost < distance[nextIndex]) {
+                distance[nextIndex] = cost;
+                float scale = diagonal ? INV_SQRT2 : 1.0f;
+                directionX[nextIndex] = -dir[0] * scale;
+                directionZ[nextIndex] = -dir[1] * scale;
+                open.push({cost, nextIndex});
+            }
+        }
+    }
+
+    valid = true;
+    buildCount++;
+    return true;
+}
+
+int FlowField::cellIndex(float x, float z) const {
+    if (!grid) return -1;
+    float fx = std::floor((x + NavigationGrid::GRID_OFFSET) / NavigationGrid::CELL_SIZE);
+    float fz = std::floor((z + NavigationGrid::GRID_OFFSET) / NavigationGrid::CELL_SIZE);
+    if (fx < 0.0f || fz < 0.0f || fx >= SIZE || fz >= SIZE) return -1;
+    return static_cast<int>(fz) * SIZE + static_cast<int>(fx);
+}
+
+bool FlowField::sample(float x, float z, float& outX, float& outZ) const {
+    if (!valid) return false;
+    int index = cellIndex(x, z);
+    if (index < 0 || (directionX[index] == 0.0f && directionZ[index] == 0.0f)) return false;
+    outX = directionX[index];
+    outZ = directionZ[index];
+    return true;
+}
+
+bool FlowField::isReachable(float x, float z) const {
+    return distanceAt(x, z) >= 0.0f;
+}
+
+float FlowField::distanceAt(float x, float z) const {
+    if (!valid) return -1.0f;
+    int index = cellIndex(x, z);
+    if (index < 0 || std::isinf(distance[index])) return -1.0f;
+    return distance[index];
+}
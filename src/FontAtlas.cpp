@@ -0,0 +1,177 @@
+#include "FontAtlas.h"
+#include <GL/glut.h>
+#include <iostream>
+
+namespace {
+
+// Solid white texels in the atlas corner, sampled by untextured quads
+constexpr int WHITE_BLOCK = 4;
+
+// GLUT bitmap fonts carry no metrics API, so line height and descent
+// (pixels below the baseline) are tabulated from the font data
+void fontMetrics(void* font, int& lineHeight, int& descent) {
+    if (font == GLUT_BITMAP_HELVETICA_10)         { lineHeight = 14; descent = 3; }
+    else if (font == GLUT_BITMAP_HELVETICA_12)    { lineHeight = 16; descent = 4; }
+    else if (font == GLUT_BITMAP_HELVETICA_18)    { lineHeight = 23; descent = 5; }
+    else if (font == GLUT_BITMAP_TIMES_ROMAN_10)  { lineHeight = 14; descent = 3; }
+    else if (font == GLUT_BITMAP_TIMES_ROMAN_24)  { lineHeight = 30; descent = 7; }
+    else if (font == GLUT_BITMAP_8_BY_13)         { lineHeight = 14; descent = 3; }
+    else if (font == GLUT_BITMAP_9_BY_15)         { lineHeight = 16; descent = 4; }
+    else                                          { lineHeight = 30; descent = 8; }
+}
+
+}  // namespace
+
+FontAtlas::FontAtlas()
+    : texture(0), framebuffer(0), failed(false), shelfX(WHITE_BLOCK), shelfY(0), shelfHeight(WHITE_BLOCK) {
+}
+
+FontAtlas::~FontAtlas() {
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    if (texture) glDeleteTextures(1, &texture);
+}
+
+bool FontAtlas::initialize() {
+    if (!(GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object)) {
+        std::cerr << "FontAtlas: framebuffer objects unavailable, text stays on glutBitmapCharacter" << std::endl;
+        return false;
+    }
+
+    std::vector<GLubyte> pixels(SIZE * SIZE * 4, 0);
+    for (int y = 0; y < WHITE_BLOCK; y++) {
+        for (int x = 0; x < WHITE_BLOCK; x++) {
+            for (int c = 0; c < 4; c++) pixels[(y * SIZE + x) * 4 + c] = 255;
+        }
+    }
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, SIZE, SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "FontAtlas: framebuffer incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &texture);
+        framebuffer = 0;
+        texture = 0;
+        return false;
+    }
+    return true;
+}
+
+const FontAtlas::Font* FontAtlas::getFont(void* font) {
+    for (const auto& entry : fonts) {
+        if (entry->handle == font) return entry->baked ? entry.get() : nullptr;
+    }
+    if (failed) return nullptr;
+
+    if (!texture && !initialize()) {
+        failed = true;
+        return nullptr;
+    }
+
+    std::unique_ptr<Font> entry(new Font());
+    entry->handle = font;
+    fontMetrics(font, entry->lineHeight, entry->descent);
+    entry->baked = bake(*entry);
+
+    // Kept even when baking failed, so a full atlas is only reported once
+    fonts.push_back(std::move(entry));
+    if (!fonts.back()->baked) return nullptr;
+    std::cout << "FontAtlas: baked font " << fonts.size() << " (" << fonts.back()->lineHeight
+              << " px lines)" << std::endl;
+    return fonts.back().get();
+}
+
+const FontAtlas::Glyph& FontAtlas::glyphFor(const Font& font, char c) {
+    int code = static_cast<unsigned char>(c);
+    if (code < FIRST_CHAR || code > LAST_CHAR) code = '?';
+    return font.glyphs[code - FIRST_CHAR];
+}
+
+void FontAtlas::getWhiteTexel(float& u, float& v) const {
+    u = v = (WHITE_BLOCK * 0.5f) / SIZE;
+}
+
+bool FontAtlas::bake(Font& font) {
+    // Pack every cell first so a full atlas leaves the packer untouched
+    const int cellHeight = font.lineHeight + PADDING * 2;
+    int x = shelfX, y = shelfY, rowHeight = shelfHeight;
+    int cellX[LAST_CHAR - FIRST_CHAR + 1];
+    int cellY[LAST_CHAR - FIRST_CHAR + 1];
+
+    for (int c = FIRST_CHAR; c <= LAST_CHAR; c++) {
+        Glyph& glyph = font.glyphs[c - FIRST_CHAR];
+        glyph.advance = glutBitmapWidth(font.handle, c);
+        glyph.width = glyph.advance + PADDING * 2;
+        glyph.height = cellHeight;
+
+        if (x + glyph.width > SIZE) {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        if (y + cellHeight > SIZE) {
+            std::cerr << "FontAtlas: atlas full, font falls back to glutBitmapCharacter" << std::endl;
+            return false;
+        }
+
+        cellX[c - FIRST_CHAR] = x;
+        cellY[c - FIRST_CHAR] = y;
+        glyph.u0 = static_cast<float>(x) / SIZE;
+        glyph.v0 = static_cast<float>(y) / SIZE;
+        glyph.u1 = static_cast<float>(x + glyph.width) / SIZE;
+        glyph.v1 = static_cast<float>(y + cellHeight) / SIZE;
+
+        x += glyph.width;
+        if (cellHeight > rowHeight) rowHeight = cellHeight;
+    }
+    shelfX = x;
+    shelfY = y;
+    shelfHeight = rowHeight;
+
+    // Render the glyphs white on transparent black straight into the atlas
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    glPushAttrib(GL_VIEWPORT_BIT | GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glViewport(0, 0, SIZE, SIZE);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, SIZE, 0, SIZE, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+    for (int c = FIRST_CHAR; c <= LAST_CHAR; c++) {
+        glRasterPos2i(cellX[c - FIRST_CHAR] + PADDING, cellY[c - FIRST_CHAR] + PADDING + font.descent);
+        glutBitmapCharacter(font.handle, c);
+    }
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    return true;
+}
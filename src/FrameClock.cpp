@@ -0,0 +1,81 @@
+#include "FrameClock.h"
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+
+// A frame longer than this is treated as a stall rather than slow rendering
+constexpr double MAX_FRAME_SECONDS = FrameClock::FIXED_STEP * FrameClock::MAX_STEPS_PER_FRAME;
+
+}  // namespace
+
+FrameClock::FrameClock()
+    : lastTime(Clock::now()), accumulator(0.0), totalSteps(0), totalFrames(0), droppedSeconds(0.0) {
+}
+
+void FrameClock::reset() {
+    lastTime = Clock::now();
+    accumulator = 0.0;
+}
+
+int FrameClock::advance() {
+    Clock::time_point now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastTime).count();
+    lastTime = now;
+    totalFrames++;
+
+    if (elapsed > MAX_FRAME_SECONDS) {
+        droppedSeconds += elapsed - MAX_FRAME_SECONDS;
+        elapsed = MAX_FRAME_SECONDS;
+    }
+    accumulator += elapsed;
+
+    int steps = 0;
+    while (accumulator >= FIXED_STEP && steps < MAX_STEPS_PER_FRAME) {
+        accumulator -= FIXED_STEP;
+        steps++;
+    }
+    // Rounding can leave a hair over one tick after a capped frame; never report alpha >= 1
+    if (accumulator >= FIXED_STEP) {
+        droppedSeconds += accumulator - FIXED_STEP * 0.999;
+        accumulator = FIXED_STEP * 0.999;
+    }
+    totalSteps += steps;
+    return steps;
+}
+
+bool FrameClock::setPacing(Pacing pacing) {
+    int interval = pacing == Pacing::VSYNC ? 1 : 0;
+#ifdef _WIN32
+    typedef BOOL (WINAPI *SwapIntervalProc)(int);
+    SwapIntervalProc swapInterval = reinterpret_cast<SwapIntervalProc>(wglGetProcAddress("wglSwapIntervalEXT"));
+    if (swapInterval && swapInterval(interval)) {
+        std::cout << "Frame pacing: " << (interval ? "vsync" : "uncapped") << std::endl;
+        return true;
+    }
+    std::cerr << "FrameClock: WGL_EXT_swap_control unavailable, keeping the driver's swap interval" << std::endl;
+    return false;
+#else
+    (void)interval;
+    std::cerr << "FrameClock: no swap interval control on this platform, keeping the driver's setting" << std::endl;
+    return false;
+#endif
+}
+
+void FrameClock::printStats() const {
+    std::cout << "Simulation: " << totalSteps << " fixed steps of " << FIXED_STEP * 1000.0f << " ms over "
+              << totalFrames << " frames";
+    if (totalFrames > 0) {
+        std::cout << " (" << static_cast<double>(totalSteps) / totalFrames << " steps/frame)";
+    }
+    std::cout << ", " << droppedSeconds << " s dropped by the catch-up cap" << std::endl;
+}
@@ -0,0 +1,257 @@
+#include "FrameGraph.h"
+#include <algorithm>
+#include <iostream>
+
+FrameGraph::FrameGraph() : frameIndex(0), stats{0, 0, 0} {
+}
+
+FrameGraph::~FrameGraph() {
+    for (const PooledTarget& target : pool) {
+        glDeleteFramebuffers(1, &target.framebuffer);
+        glDeleteTextures(1, &target.color);
+        if (target.depth) glDeleteRenderbuffers(1, &target.depth);
+    }
+}
+
+bool FrameGraph::supportsTransientTargets() const {
+    return GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object;
+}
+
+GLuint FrameGraph::getBoundFramebuffer() {
+    if (!(GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object)) return 0;
+    GLint framebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+    return static_cast<GLuint>(framebuffer);
+}
+
+void FrameGraph::reset() {
+    resources.clear();
+    passes.clear();
+}
+
+FrameGraph::Resource FrameGraph::importTarget(const std::string& name, GLuint framebuffer, int width, int height) {
+    ResourceEntry entry = {name, true, framebuffer, width, height, TargetDesc{width, height, true}, -1, false, -1, -1};
+    resources.push_back(entry);
+    return static_cast<Resource>(resources.size() - 1);
+}
+
+FrameGraph::Resource FrameGraph::createTarget(const std::string& name, const TargetDesc& desc) {
+    ResourceEntry entry = {name, false, 0, desc.width, desc.height, desc, -1, false, -1, -1};
+    resources.push_back(entry);
+    return static_cast<Resource>(resources.size() - 1);
+}
+
+void FrameGraph::markOutput(Resource resource) {
+    resources[resource].needed = true;
+}
+
+FrameGraph::PassId FrameGraph::addPass(const std::string& name, const PassState& state, std::function<void()> run) {
+    PassEntry entry;
+    entry.name = name;
+    entry.state = state;
+    entry.run = std::move(run);
+    entry.sideEffect = false;
+    entry.culled = false;
+    passes.push_back(std::move(entry));
+    return static_cast<PassId>(passes.size() - 1);
+}
+
+void FrameGraph::read(PassId pass, Resource resource) {
+    passes[pass].reads.push_back(resource);
+}
+
+void FrameGraph::write(PassId pass, Resource resource) {
+    passes[pass].writes.push_back(resource);
+}
+
+void FrameGraph::setSideEffect(PassId pass, bool sideEffect) {
+    passes[pass].sideEffect = sideEffect;
+}
+
+void FrameGraph::cull() {
+    // Walking backwards, a pass survives if it has side effects or writes
+    // something a later survivor (or the frame output) needs; whatever it
+    // reads is then needed in turn. Passes writing the same target in
+    // sequence all survive, since each builds on the previous contents.
+    for (int p = static_cast<int>(passes.size()) - 1; p >= 0; p--) {
+        PassEntry& pass = passes[p];
+        bool needed = pass.sideEffect;
+        for (Resource resource : pass.writes) needed = needed || resources[resource].needed;
+        pass.culled = !needed;
+        if (pass.culled) continue;
+        for (Resource resource : pass.reads) resources[resource].needed = true;
+    }
+
+    // Transient lifetimes over the surviving passes
+    for (int p = 0; p < static_cast<int>(passes.size()); p++) {
+        if (passes[p].culled) continue;
+        auto touch = [this, p](Resource resource) {
+            ResourceEntry& entry = resources[resource];
+            if (entry.firstUse < 0) entry.firstUse = p;
+            entry.lastUse = p;
+        };
+        for (Resource resource : passes[p].reads) touch(resource);
+        for (Resource resource : passes[p].writes) touch(resource);
+    }
+}
+
+void FrameGraph::execute() {
+    frameIndex++;
+    cull();
+
+    GLuint restoreFramebuffer = getBoundFramebuffer();
+    stats = {static_cast<int>(passes.size()), 0, 0};
+    int targetsInUse = 0;
+    lastPassNames.clear();
+
+    for (int p = 0; p < static_cast<int>(passes.size()); p++) {
+        PassEntry& pass = passes[p];
+        lastPassNames.push_back((pass.culled ? "-" : "") + pass.name);
+        if (pass.culled) {
+            stats.culled++;
+            continue;
+        }
+
+        // Transients first used here come out of the pool
+        for (ResourceEntry& entry : resources) {
+            if (!entry.imported && entry.firstUse == p && entry.pooled < 0) {
+                entry.pooled = acquireTarget(entry.desc);
+                entry.framebuffer = pool[entry.pooled].framebuffer;
+                targetsInUse++;
+            }
+        }
+        stats.transientTargets = std::max(stats.transientTargets, targetsInUse);
+
+        bindTargets(pass);
+        if (!pass.writes.empty()) {
+            applyState(pass.state);
+            if (pass.state.clear) glClear(pass.state.clear);
+        }
+        pass.run();
+
+        // ... and go back once their last reader or writer is done
+        for (ResourceEntry& entry : resources) {
+            if (!entry.imported && entry.lastUse == p && entry.pooled >= 0) {
+                releaseTarget(entry.pooled);
+                entry.pooled = -1;
+                targetsInUse--;
+            }
+        }
+    }
+
+    // Leave GL the way the frame found it
+    applyState(PassState());
+    if (supportsTransientTargets()) glBindFramebuffer(GL_FRAMEBUFFER, restoreFramebuffer);
+    trimPool();
+}
+
+void FrameGraph::bindTargets(const PassEntry& pass) {
+    if (!supportsTransientTargets()) return;  // only the window exists
+
+    if (!pass.writes.empty()) {
+        const ResourceEntry& target = resources[pass.writes.front()];
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.framebuffer);
+        glViewport(0, 0, target.width, target.height);
+    }
+    // Reads come from the first input, or from the pass's own target
+    const std::vector<Resource>& source = pass.reads.empty() ? pass.writes : pass.reads;
+    if (!source.empty()) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, resources[source.front()].framebuffer);
+    }
+}
+
+void FrameGraph::applyState(const PassState& state) {
+    if (state.depthTest) glEnable(GL_DEPTH_TEST);
+    else glDisable(GL_DEPTH_TEST);
+    glDepthMask(state.depthWrite ? GL_TRUE : GL_FALSE);
+    if (state.blend) {
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        glDisable(GL_BLEND);
+    }
+    if (!state.lighting) glDisable(GL_LIGHTING);
+}
+
+int FrameGraph::acquireTarget(const TargetDesc& desc) {
+    for (size_t i = 0; i < pool.size(); i++) {
+        PooledTarget& target = pool[i];
+        if (!target.inUse && target.desc.width == desc.width && target.desc.height == desc.height &&
+            target.desc.depth == desc.depth) {
+            target.inUse = true;
+            target.lastUsedFrame = frameIndex;
+            return static_cast<int>(i);
+        }
+    }
+
+    PooledTarget target = {desc, 0, 0, 0, true, frameIndex};
+    glGenTextures(1, &target.color);
+    glBindTexture(GL_TEXTURE_2D, target.color);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, desc.width, desc.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (desc.depth) {
+        glGenRenderbuffers(1, &target.depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, target.depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, desc.width, desc.height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    }
+
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &target.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.color, 0);
+    if (target.depth) {
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target.depth);
+    }
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, previous);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "FrameGraph: transient target " << desc.width << "x" << desc.height << " incomplete (0x"
+                  << std::hex << status << std::dec << ")" << std::endl;
+    }
+
+    pool.push_back(target);
+    return static_cast<int>(pool.size() - 1);
+}
+
+void FrameGraph::releaseTarget(int pooled) {
+    pool[pooled].inUse = false;
+    pool[pooled].lastUsedFrame = frameIndex;
+}
+
+void FrameGraph::trimPool() {
+    for (size_t i = 0; i < pool.size();) {
+        PooledTarget& target = pool[i];
+        if (!target.inUse && frameIndex - target.lastUsedFrame > POOL_IDLE_FRAMES) {
+            glDeleteFramebuffers(1, &target.framebuffer);
+            glDeleteTextures(1, &target.color);
+            if (target.depth) glDeleteRenderbuffers(1, &target.depth);
+            pool.erase(pool.begin() + i);
+        } else {
+            i++;
+        }
+    }
+}
+
+GLuint FrameGraph::getTexture(Resource resource) const {
+    const ResourceEntry& entry = resources[resource];
+    return entry.pooled >= 0 ? pool[entry.pooled].color : 0;
+}
+
+GLuint FrameGraph::getFramebuffer(Resource resource) const {
+    return resources[resource].framebuffer;
+}
+
+void FrameGraph::printStats() const {
+    std::cout << "Frame graph: " << stats.passes - stats.culled << " of " << stats.passes << " passes run (";
+    for (size_t i = 0; i < lastPassNames.size(); i++) {
+        std::cout << (i ? " " : "") << lastPassNames[i];
+    }
+    std::cout << "), " << stats.transientTargets << " transient targets, " << pool.size() << " pooled"
+              << std::endl;
+}
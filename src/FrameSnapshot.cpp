@@ -0,0 +1,75 @@
+#include "FrameSnapshot.h"
+#include "Scene.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "EnemyHorde.h"
+#include "Bullet.h"
+#include "Target.h"
+#include "Camera.h"
+#include "camera_controller.h"
+
+void FrameSnapshot::capture(Scene& scene, const EnemyHorde& liveHorde, Player& livePlayer, const Camera& camera,
+                            const CameraController& cameraController, GameState state,
+                            uint32_t simulationTick, float blend) {
+    tick = simulationTick;
+    alpha = blend;
+    gameState = state;
+    playerInsideSafeZone = scene.isPlayerInsideSafeZone();
+
+    enemies.clear();
+    for (Enemy* enemy : scene.getEnemies()) {
+        EnemyState out;
+        out.id = enemy->getId();
+        out.previousPosition = enemy->getPreviousPosition();
+        out.position = enemy->getPosition();
+        out.previousYaw = enemy->getPreviousYaw();
+        out.yaw = enemy->getYaw();
+        out.bodyColor = enemy->getColor(Enemy::BODY);
+        out.headColor = enemy->getColor(Enemy::HEAD);
+        out.health = enemy->getHealth();
+        enemies.push_back(out);
+    }
+
+    horde.resize(liveHorde.size());
+    for (size_t i = 0; i < liveHorde.size(); i++) {
+        EnemyState& out = horde[i];
+        out.id = liveHorde.getId(i);
+        out.previousPosition = liveHorde.getPreviousPosition(i);
+        out.position = liveHorde.getPosition(i);
+        out.previousYaw = liveHorde.getPreviousYaw(i);
+        out.yaw = liveHorde.getYaw(i);
+        out.bodyColor = liveHorde.getColor(i, Enemy::BODY);
+        out.headColor = liveHorde.getColor(i, Enemy::HEAD);
+        out.health = liveHorde.getHealth(i);
+    }
+
+    bullets.clear();
+    for (Bullet* bullet : scene.getBullets()) {
+        BulletState out;
+        out.previousPosition = bullet->getPreviousPosition();
+        out.position = bullet->getPosition();
+        out.color = bullet->getColor();
+        bullets.push_back(out);
+    }
+
+    targetHealth.clear();
+    for (const Target* target : scene.getTargets()) {
+        targetHealth.push_back(target->getHealthPercentage());
+    }
+
+    player.previousPosition = livePlayer.getPreviousPosition();
+    player.position = livePlayer.getPosition();
+    player.visionDirection = livePlayer.getVisionDirection();
+    player.bodyColor = livePlayer.getColor(Player::BODY);
+    player.headColor = livePlayer.getColor(Player::HEAD);
+    player.health = livePlayer.getHealth();
+    player.visible = livePlayer.isVisible();
+    player.testDraw = livePlayer.isTestDraw();
+
+    firstPersonView = camera.getInterpolatedViewMatrix(blend);
+    firstPersonProjection = camera.getProjectionMatrix();
+    firstPersonEye = camera.getInterpolatedPosition(blend);
+    firstPersonLook = camera.getLookDirection();
+    thirdPersonView = cameraController.getInterpolatedViewMatrix(blend);
+    thirdPersonProjection = cameraController.getProjectionMatrix();
+}
@@ -21,17 +21,15 @@ FreeCamera::~FreeCamera() {
 }
 
 void FreeCamera::applyView() {
-    // Compute camera position from spherical coordinates
-    float camX = orbitTarget.x + distance * cos(elevation) * sin(azimuth);
-    float camY = orbitTarget.y + distance * sin(elevation);
-    float camZ = orbitTarget.z + distance * cos(elevation) * cos(azimuth);
+    glMatrixMode(GL_PROJECTION);
+    glLoadMatrixf(getProjectionMatrix().data());
+    glMatrixMode(GL_MODELVIEW);
+    glLoadMatrixf(getViewMatrix().data());
+}
 
-    // Look at orbit target
-    gluLookAt(
-        camX, camY, camZ,           // Eye position
-        orbitTarget.x, orbitTarget.y, orbitTarget.z,  // Look at point
-        0.0f, 1.0f, 0.0f            // Up vector
-    );
+Matrix4 FreeCamera::getViewMatrix() const {
+    // Eye from spherical coordinates, looking at the orbit target
+    return Matrix4::lookAt(getPosition(), orbitTarget, Vector3(0.0f, 1.0f, 0.0f));
 }
 
 void FreeCamera::orbit(float deltaAzimuth, float deltaElevation) {
@@ -1,19 +1,9 @@
 #include "GameObject.h"
-#include <GL/glut.h>
 
 GameObject::GameObject(const Vector3& position, const Vector3& size, const Color& color)
     : position(position), size(size), color(color), collisionType(CollisionType::SOLID) {
 }
 
-void GameObject::draw() const {
-    glPushMatrix();
-    glTranslatef(position.x, position.y, position.z);
-    glColor3f(color.r, color.g, color.b);
-    glScalef(size.x, size.y, size.z);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-}
-
 // AABB (Axis-Aligned Bounding Box) collision detection
 // Checks if a circle (x, z, radius) collides with this box
 bool GameObject::checkAABBCollision(float x, float z, float radius) const {
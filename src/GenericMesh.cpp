@@ -11,49 +11,73 @@ GenericMesh::~GenericMesh() {
     // Cleanup if needed
 }
 
-void GenericMesh::draw() {
-    if (vertices.empty() || indices.empty()) {
-        return; // Nothing to draw
-    }
-
-    glPushMatrix();
+void GenericMesh::accept(ShapeVisitor& visitor) {
+    visitor.visit(*this);
+}
 
-    // Apply transformations
-    glTranslatef(pos.x, pos.y, pos.z);
+Matrix4 GenericMesh::getModelMatrix() const {
+    Matrix4 model = Matrix4::translation(pos);
 
     // Apply rotation if axis angle is non-zero
     if (axisAngle != 0.0f) {
-        glRotatef(axisAngle, axis.x, axis.y, axis.z);
+        model = model * Matrix4::rotation(axisAngle, axis);
     }
 
-    // Apply scale
-    glScalef(size.x, size.y, size.z);
+    return model * Matrix4::scale(size);
+}
 
-    // Set material color
-    glColor3f(color.r, color.g, color.b);
+float GenericMesh::getBoundingRadius() const {
+    // Vertices are scaled by size about pos; rotation doesn't change distances
+    float maxDistance = 0.0f;
+    for (const auto& vertex : vertices) {
+        const Vector3& p = vertex.position;
+        float distance = Vector3(p.x * size.x, p.y * size.y, p.z * size.z).length();
+        if (distance > maxDistance) maxDistance = distance;
+    }
+    return maxDistance;
+}
+
+void GenericMesh::tessellate(std::vector<Vector3>& positions,
+                             std::vector<Vector3>& normals,
+                             std::vector<int>& outIndices) const {
+    positions.clear();
+    normals.clear();
+    outIndices.clear();
+
+    for (const auto& v : vertices) {
+        positions.push_back(v.position);
+        normals.push_back(v.normal);
+    }
 
-    // Draw mesh using immediate mode (compatible with existing codebase)
-    glBegin(GL_TRIANGLES);
-    for (size_t i = 0; i < indices.size(); i++) {
-        int idx = indices[i];
-        if (idx >= 0 && idx < static_cast<int>(vertices.size())) {
-            const Vertex& v = vertices[idx];
-            glNormal3f(v.normal.x, v.normal.y, v.normal.z);
-            glVertex3f(v.position.x, v.position.y, v.position.z);
+    // Drop triangles that reference missing vertices
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        bool valid = true;
+        for (size_t k = 0; k < 3; k++) {
+            if (indices[i + k] < 0 || indices[i + k] >= static_cast<int>(vertices.size())) valid = false;
         }
+        if (!valid) continue;
+        outIndices.push_back(indices[i]);
+        outIndices.push_back(indices[i + 1]);
+        outIndices.push_back(indices[i + 2]);
     }
-    glEnd();
+}
 
-    glPopMatrix();
+void GenericMesh::tessellateTexCoords(std::vector<Vector3>& texCoords) const {
+    texCoords.clear();
+    for (const auto& v : vertices) {
+        texCoords.push_back(v.texCoord);
+    }
 }
 
 void GenericMesh::setVertices(const std::vector<Vertex>& verts) {
     vertices = verts;
     calculateAABB();
+    invalidateMesh();
 }
 
 void GenericMesh::setIndices(const std::vector<int>& inds) {
     indices = inds;
+    invalidateMesh();
 }
 
 void GenericMesh::calculateAABB() {
@@ -89,4 +113,5 @@ void GenericMesh::calculateAABB() {
 void GenericMesh::clear() {
     vertices.clear();
     indices.clear();
+    invalidateMesh();
 }
@@ -0,0 +1,105 @@
+#include "GpuMesh.h"
+#include <iostream>
+
+GpuMesh::GpuMesh() : vbo(0), ibo(0), vertexCount(0), indexCount(0) {}
+
+GpuMesh::~GpuMesh() {
+    release();
+}
+
+void GpuMesh::upload(const std::vector<Vector3>& positions,
+                     const std::vector<Vector3>& normals,
+                     const std::vector<Vector3>& texCoords,
+                     const std::vector<int>& indices) {
+    if (positions.empty() || indices.empty()) {
+        release();
+        return;
+    }
+
+    // Interleave attributes on the CPU once, GPU reads them every frame
+    std::vector<Vertex> vertices(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        Vertex& v = vertices[i];
+        v.position[0] = positions[i].x;
+        v.position[1] = positions[i].y;
+        v.position[2] = positions[i].z;
+
+        Vector3 n = i < normals.size() ? normals[i] : Vector3(0.0f, 1.0f, 0.0f);
+        v.normal[0] = n.x;
+        v.normal[1] = n.y;
+        v.normal[2] = n.z;
+
+        Vector3 t = i < texCoords.size() ? texCoords[i] : Vector3();
+        v.texCoord[0] = t.x;
+        v.texCoord[1] = t.y;
+    }
+
+    std::vector<GLuint> gpuIndices;
+    gpuIndices.reserve(indices.size());
+    for (int idx : indices) {
+        if (idx < 0 || idx >= static_cast<int>(positions.size())) {
+            std::cerr << "GpuMesh: Index " << idx << " out of range, clamped to 0" << std::endl;
+            idx = 0;
+        }
+        gpuIndices.push_back(static_cast<GLuint>(idx));
+    }
+
+    if (vbo == 0) glGenBuffers(1, &vbo);
+    if (ibo == 0) glGenBuffers(1, &ibo);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, gpuIndices.size() * sizeof(GLuint), gpuIndices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    vertexCount = static_cast<int>(vertices.size());
+    indexCount = static_cast<int>(gpuIndices.size());
+}
+
+void GpuMesh::release() {
+    if (vbo != 0) glDeleteBuffers(1, &vbo);
+    if (ibo != 0) glDeleteBuffers(1, &ibo);
+    vbo = ibo = 0;
+    vertexCount = indexCount = 0;
+}
+
+void GpuMesh::bind() const {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, position)));
+    glNormalPointer(GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, normal)));
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, texCoord)));
+}
+
+void GpuMesh::drawRange(int firstIndex, int count) const {
+    if (count <= 0) return;
+    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT,
+                   reinterpret_cast<const void*>(firstIndex * sizeof(GLuint)));
+}
+
+void GpuMesh::unbind() const {
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GpuMesh::draw() const {
+    if (!isValid()) return;
+    bind();
+    drawRange(0, indexCount);
+    unbind();
+}
+
+size_t GpuMesh::getMemoryBytes() const {
+    return vertexCount * sizeof(Vertex) + indexCount * sizeof(GLuint);
+}
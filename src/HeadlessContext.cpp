@@ -0,0 +1,92 @@
+#include "HeadlessContext.h"
+
+#ifdef FIRSTOGL_HEADLESS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+bool hasExtension(const char* extensions, const char* name) {
+    if (!extensions) return false;
+    size_t length = std::strlen(name);
+    for (const char* found = std::strstr(extensions, name); found; found = std::strstr(found + length, name)) {
+        bool startsWord = found == extensions || found[-1] == ' ';
+        bool endsWord = found[length] == ' ' || found[length] == '\0';
+        if (startsWord && endsWord) return true;
+    }
+    return false;
+}
+
+}  // namespace
+#endif
+
+HeadlessContext::HeadlessContext() : display(nullptr), context(nullptr) {
+}
+
+HeadlessContext::~HeadlessContext() {
+#ifdef FIRSTOGL_HEADLESS_EGL
+    if (context) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+    }
+    if (display) eglTerminate(display);
+#endif
+}
+
+bool HeadlessContext::create() {
+#ifdef FIRSTOGL_HEADLESS_EGL
+    // Mesa's surfaceless platform needs neither a display server nor a GPU
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    if (hasExtension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_MESA_platform_surfaceless")) {
+        eglDisplay = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (eglDisplay == EGL_NO_DISPLAY) eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major = 0, minor = 0;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "HeadlessContext: no EGL display" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+
+    const char* extensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+    if (!hasExtension(extensions, "EGL_KHR_surfaceless_context")) {
+        std::cerr << "HeadlessContext: EGL " << major << "." << minor << " cannot make a context current without a surface"
+                  << std::endl;
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "HeadlessContext: EGL has no desktop OpenGL" << std::endl;
+        return false;
+    }
+
+    // No surface means no surface format to match, so any GL config will do
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    if (!hasExtension(extensions, "EGL_KHR_no_config_context")) {
+        const EGLint configAttributes[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+        EGLint configCount = 0;
+        if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) || configCount == 0) {
+            std::cerr << "HeadlessContext: no EGL config for desktop OpenGL" << std::endl;
+            return false;
+        }
+    }
+
+    // Requesting no version gets the newest compatibility profile the driver has
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, nullptr);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cerr << "HeadlessContext: eglCreateContext failed (0x" << std::hex << eglGetError() << std::dec << ")"
+                  << std::endl;
+        return false;
+    }
+    context = eglContext;
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cerr << "HeadlessContext: eglMakeCurrent failed (0x" << std::hex << eglGetError() << std::dec << ")"
+                  << std::endl;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,221 @@
+#include "HudBatch.h"
+#include "StreamBuffer.h"
+#include <GL/glut.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+// Cached text not drawn for this many frames is dropped
+constexpr unsigned int TEXT_CACHE_FRAMES = 120;
+
+GLubyte toByte(float v) {
+    return static_cast<GLubyte>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+}  // namespace
+
+HudBatch& HudBatch::instance() {
+    static HudBatch batch;
+    return batch;
+}
+
+HudBatch::HudBatch() : frameIndex(0), lastQuadCount(0) {
+    atlas.getWhiteTexel(whiteU, whiteV);
+}
+
+void HudBatch::beginFrame(const CameraView& frameCamera) {
+    camera = frameCamera;
+}
+
+bool HudBatch::project(const Vector3& world, float& winX, float& winY) const {
+    return camera.project(world, winX, winY);
+}
+
+void HudBatch::addVertex(float x, float y, float u, float v, const Color& color, float alpha) {
+    Vertex vertex;
+    vertex.x = x;
+    vertex.y = y;
+    vertex.u = u;
+    vertex.v = v;
+    vertex.color[0] = toByte(color.r);
+    vertex.color[1] = toByte(color.g);
+    vertex.color[2] = toByte(color.b);
+    vertex.color[3] = toByte(alpha);
+    vertices.push_back(vertex);
+}
+
+void HudBatch::addQuad(float x0, float y0, float x1, float y1, const Color& color, float alpha) {
+    addGradientQuad(x0, y0, x1, y1, color, alpha, color, alpha);
+}
+
+void HudBatch::addGradientQuad(float x0, float y0, float x1, float y1,
+                               const Color& bottom, float bottomAlpha, const Color& top, float topAlpha) {
+    addVertex(x0, y0, whiteU, whiteV, bottom, bottomAlpha);
+    addVertex(x1, y0, whiteU, whiteV, bottom, bottomAlpha);
+    addVertex(x1, y1, whiteU, whiteV, top, topAlpha);
+    addVertex(x0, y1, whiteU, whiteV, top, topAlpha);
+}
+
+void HudBatch::addRectOutline(float x0, float y0, float x1, float y1, float thickness,
+                              const Color& color, float alpha) {
+    float h = thickness * 0.5f;
+    addQuad(x0 - h, y0 - h, x1 + h, y0 + h, color, alpha);  // bottom
+    addQuad(x0 - h, y1 - h, x1 + h, y1 + h, color, alpha);  // top
+    addQuad(x0 - h, y0 + h, x0 + h, y1 - h, color, alpha);  // left
+    addQuad(x1 - h, y0 + h, x1 + h, y1 - h, color, alpha);  // right
+}
+
+void HudBatch::addLine(float x0, float y0, float x1, float y1, float thickness, const Color& color, float alpha) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 1e-6f) return;
+
+    // Offset both ends along the perpendicular by half the thickness
+    float nx = -dy / length * thickness * 0.5f;
+    float ny = dx / length * thickness * 0.5f;
+    addVertex(x0 + nx, y0 + ny, whiteU, whiteV, color, alpha);
+    addVertex(x0 - nx, y0 - ny, whiteU, whiteV, color, alpha);
+    addVertex(x1 - nx, y1 - ny, whiteU, whiteV, color, alpha);
+    addVertex(x1 + nx, y1 + ny, whiteU, whiteV, color, alpha);
+}
+
+void HudBatch::addText(float x, float y, void* font, const std::string& text, const Color& color, float scale) {
+    if (text.empty()) return;
+
+    const FontAtlas::Font* atlasFont = atlas.getFont(font);
+    if (!atlasFont) {
+        texts.push_back({x, y, font, text, color});
+        return;
+    }
+
+    TextKey key{text, font, scale};
+    auto it = textCache.find(key);
+    TextMesh& mesh = it != textCache.end() ? it->second : layoutText(*atlasFont, key);
+    mesh.lastUsedFrame = frameIndex;
+
+    // Whole-pixel origin keeps unscaled glyphs texel-aligned
+    float originX = std::floor(x + 0.5f);
+    float originY = std::floor(y + 0.5f);
+    for (const GlyphQuad& q : mesh.quads) {
+        addVertex(originX + q.x0, originY + q.y0, q.u0, q.v0, color, 1.0f);
+        addVertex(originX + q.x1, originY + q.y0, q.u1, q.v0, color, 1.0f);
+        addVertex(originX + q.x1, originY + q.y1, q.u1, q.v1, color, 1.0f);
+        addVertex(originX + q.x0, originY + q.y1, q.u0, q.v1, color, 1.0f);
+    }
+}
+
+HudBatch::TextMesh& HudBatch::layoutText(const FontAtlas::Font& font, const TextKey& key) {
+    TextMesh& mesh = textCache[key];
+    mesh.quads.reserve(key.text.size());
+
+    float penX = 0.0f;
+    float bottom = -static_cast<float>(FontAtlas::PADDING + font.descent) * key.scale;
+    for (char c : key.text) {
+        const FontAtlas::Glyph& glyph = FontAtlas::glyphFor(font, c);
+        if (c != ' ') {
+            GlyphQuad q;
+            q.x0 = penX - FontAtlas::PADDING * key.scale;
+            q.y0 = bottom;
+            q.x1 = q.x0 + glyph.width * key.scale;
+            q.y1 = bottom + glyph.height * key.scale;
+            q.u0 = glyph.u0;
+            q.v0 = glyph.v0;
+            q.u1 = glyph.u1;
+            q.v1 = glyph.v1;
+            mesh.quads.push_back(q);
+        }
+        penX += glyph.advance * key.scale;
+    }
+    return mesh;
+}
+
+void HudBatch::evictUnusedText() {
+    for (auto it = textCache.begin(); it != textCache.end();) {
+        if (frameIndex - it->second.lastUsedFrame > TEXT_CACHE_FRAMES) {
+            it = textCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HudBatch::flush() {
+    lastQuadCount = static_cast<int>(vertices.size() / 4);
+    frameIndex++;
+    if (frameIndex % TEXT_CACHE_FRAMES == 0) evictUnusedText();
+    if (vertices.empty() && texts.empty()) return;
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, camera.viewportWidth, 0, camera.viewportHeight, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    if (!vertices.empty()) {
+        // This frame's slice of the stream ring, or client-side arrays without one
+        // (buffer 0, so no mesh VBO reinterprets the pointers)
+        size_t bytes = vertices.size() * sizeof(Vertex);
+        const unsigned char* base = reinterpret_cast<const unsigned char*>(vertices.data());
+        StreamBuffer& ring = StreamBuffer::instance();
+        StreamBuffer::Allocation allocation = ring.allocate(bytes);
+        if (allocation) {
+            std::memcpy(allocation.data, vertices.data(), bytes);
+            ring.commit(allocation);
+            base = reinterpret_cast<const unsigned char*>(allocation.offset);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, allocation.buffer);
+        glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(2, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, x));
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), base + offsetof(Vertex, color));
+
+        // Glyphs and the white texels of plain quads come from the same atlas
+        if (atlas.isReady()) {
+            glActiveTexture(GL_TEXTURE0);
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, atlas.getTexture());
+            glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, u));
+        } else {
+            glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+        glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(vertices.size()));
+        glPopClientAttrib();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    for (const TextItem& item : texts) {
+        glColor3f(item.color.r, item.color.g, item.color.b);
+        glRasterPos2f(item.x, item.y);
+        for (char c : item.text) {
+            glutBitmapCharacter(item.font, c);
+        }
+    }
+
+    glPopAttrib();
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    vertices.clear();
+    texts.clear();
+}
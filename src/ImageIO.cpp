@@ -0,0 +1,101 @@
+#include "ImageIO.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+const uint16_t BMP_MAGIC = 0x4D42;  // "BM"
+const size_t FILE_HEADER_SIZE = 14;
+const size_t INFO_HEADER_SIZE = 40;
+const uint32_t BI_RGB = 0;
+const uint32_t BI_BITFIELDS = 3;
+
+uint16_t readU16(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+}  // namespace
+
+namespace ImageIO {
+
+bool loadBMP(const std::string& filepath, Image& image) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file) {
+        std::cerr << "ImageIO: could not open " << filepath << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < FILE_HEADER_SIZE + INFO_HEADER_SIZE || readU16(&data[0]) != BMP_MAGIC) {
+        std::cerr << "ImageIO: " << filepath << " is not a bitmap file" << std::endl;
+        return false;
+    }
+
+    const unsigned char* info = &data[FILE_HEADER_SIZE];
+    uint32_t pixelOffset = readU32(&data[10]);
+    int32_t width = static_cast<int32_t>(readU32(info + 4));
+    int32_t height = static_cast<int32_t>(readU32(info + 8));
+    uint16_t bitCount = readU16(info + 14);
+    uint32_t compression = readU32(info + 16);
+
+    // Negative height marks a top-down bitmap
+    bool topDown = height < 0;
+    if (topDown) height = -height;
+
+    bool supported = (bitCount == 24 && compression == BI_RGB) ||
+                     (bitCount == 32 && (compression == BI_RGB || compression == BI_BITFIELDS));
+    if (width <= 0 || height <= 0 || !supported) {
+        std::cerr << "ImageIO: " << filepath << " uses an unsupported bitmap format (" << bitCount
+                  << " bpp, compression " << compression << ")" << std::endl;
+        return false;
+    }
+
+    // Rows are padded to 4 bytes
+    size_t bytesPerPixel = bitCount / 8;
+    size_t stride = (width * bytesPerPixel + 3) & ~static_cast<size_t>(3);
+    if (pixelOffset + stride * height > data.size()) {
+        std::cerr << "ImageIO: " << filepath << " is truncated" << std::endl;
+        return false;
+    }
+
+    // Plain 32-bit bitmaps leave the fourth byte undefined; only bitfield ones carry alpha
+    bool hasAlpha = bytesPerPixel == 4 && compression == BI_BITFIELDS;
+
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        int sourceRow = topDown ? height - 1 - y : y;
+        const unsigned char* src = &data[pixelOffset + stride * sourceRow];
+        unsigned char* dst = &image.pixels[static_cast<size_t>(y) * width * 4];
+        for (int x = 0; x < width; x++, src += bytesPerPixel, dst += 4) {
+            // Stored as BGR(A)
+            dst[0] = src[2];
+            dst[1] = src[1];
+            dst[2] = src[0];
+            dst[3] = hasAlpha ? src[3] : 255;
+        }
+    }
+    return true;
+}
+
+bool load(const std::string& filepath, Image& image) {
+    std::string extension = filepath.substr(std::min(filepath.size(), filepath.find_last_of('.')));
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".bmp") return loadBMP(filepath, image);
+
+    std::cerr << "ImageIO: no loader for " << filepath << std::endl;
+    return false;
+}
+
+}  // namespace ImageIO
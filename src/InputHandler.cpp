@@ -1,5 +1,7 @@
 ﻿#include "InputHandler.h"
 #include "Lighting.h"
+#include "SceneRenderer.h"
+#include "MeshLibrary.h"
 #include <GL/glut.h>
 #include <cmath>
 #include <cstdlib>
@@ -8,7 +10,7 @@
 extern bool Active_Third_Camera; // 声明外部变量
 InputHandler::InputHandler(Camera* camera, CameraController* camera_controller, FreeCamera* free_camera, Scene* scene, Stob* controlledStob, Player* player, UI* gameUI, int windowWidth, int windowHeight)
     : camera(camera), camera_controller(camera_controller), free_camera(free_camera), scene(scene), controlledStob(controlledStob), player(player), gameUI(gameUI), windowWidth(windowWidth), windowHeight(windowHeight),
-      firstMouse(true), mouseCaptured(true), mouseSensitivity(0.1f), lighting(nullptr),
+      firstMouse(true), mouseCaptured(true), mouseSensitivity(0.1f), lighting(nullptr), sceneRenderer(nullptr), modifiers(0),
       freeCameraActive(false), isOrbitDragging(false), isPanDragging(false), dragStartX(0), dragStartY(0) {
 
     for (int i = 0; i < 256; i++) {
@@ -100,7 +102,17 @@ void InputHandler::handleKeyPress(unsigned char key) {
         }
     }
     else if (key == 't' || key == 'T') {
-        scene->switchTexture();
+        if (sceneRenderer) sceneRenderer->switchTexture();
+    }
+    else if (key == 'b' || key == 'B') { // Toggle static geometry batching
+        if (sceneRenderer) sceneRenderer->toggleStaticBatching();
+    }
+    else if (key == 'o' || key == 'O') { // Toggle occlusion culling
+        if (sceneRenderer) sceneRenderer->toggleOcclusionCulling();
+    }
+    else if (key == 'i' || key == 'I') { // Print render statistics
+        MeshLibrary::instance().printStats();
+        if (sceneRenderer) sceneRenderer->printRenderStats();
     }
 }
 
@@ -145,7 +157,6 @@ void InputHandler::handleMouseClick(int button, int state, int x, int y) {
 
     // Free Camera mode: Alt+drag for orbit/pan
     if (freeCameraActive) {
-        int modifiers = glutGetModifiers();
         bool altPressed = (modifiers & GLUT_ACTIVE_ALT) != 0;
 
         std::cout << "Free Camera Click: button=" << button << ", state=" << state
@@ -290,7 +301,7 @@ void InputHandler::handleMouseMotion(int x, int y) {
     
 }
 
-void InputHandler::update() {
+void InputHandler::update(float deltaTime) {
     if(Active_Third_Camera == false){ 
         // 第一人称 wasd控制 摄像机移动
         
@@ -311,11 +322,6 @@ void InputHandler::update() {
     }
     else if (Active_Third_Camera == true){
         //第三人称wasd控制角色移动
-        // 计算时间增量
-        float currentTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f; // 转换为秒
-        float deltaTime = currentTime - lastTime;
-        lastTime = currentTime;
-
         float moveX = 0, moveY = 0;
 
         float moveSpeed = 5.0f; // 调整为合适的速度值
@@ -344,8 +350,6 @@ void InputHandler::update() {
             // Sync camera position with Player's position
             Vector3 playerPos = player->getPosition();
             camera_controller->setPlayerPosition(playerPos.x, playerPos.z);
-
-            glutPostRedisplay();
         }
     }
 }
@@ -388,6 +392,10 @@ void InputHandler::toggleCamera() {
         // Sync third-person camera controller
         camera_controller->setPlayerPosition(camX, camZ);
 
+        // A camera switch is a teleport, not motion to interpolate
+        player->storePreviousState();
+        camera_controller->storePreviousState();
+
         // Show Stob in third-person view
         controlledStob->setVisible(true);
         player->setVisible(true);
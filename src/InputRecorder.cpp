@@ -0,0 +1,121 @@
+#include "InputRecorder.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+const char MAGIC[4] = {'I', 'N', 'P', 'R'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t EVENT_SIZE = 12;
+
+void putLE(unsigned char* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out[i] = static_cast<unsigned char>(value >> (i * 8));
+}
+
+uint64_t getLE(const unsigned char* p, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= static_cast<uint64_t>(p[i]) << (i * 8);
+    return value;
+}
+
+}  // namespace
+
+InputRecorder::InputRecorder() : recordedCount(0), replayIndex(0), replaySeed(0) {
+}
+
+InputRecorder::~InputRecorder() {
+    stopRecording();
+}
+
+bool InputRecorder::startRecording(const std::string& path, uint64_t seed) {
+    stopRecording();
+    output.open(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cerr << "InputRecorder: cannot write " << path << std::endl;
+        return false;
+    }
+    unsigned char header[HEADER_SIZE];
+    std::memcpy(header, MAGIC, 4);
+    putLE(header + 4, VERSION, 4);
+    putLE(header + 8, seed, 8);
+    output.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+    outputPath = path;
+    recordedCount = 0;
+    std::cout << "Recording input to " << path << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+void InputRecorder::record(const InputEvent& event) {
+    if (!output.is_open()) return;
+    unsigned char bytes[EVENT_SIZE];
+    putLE(bytes, event.tick, 4);
+    bytes[4] = event.type;
+    bytes[5] = event.code;
+    bytes[6] = event.state;
+    bytes[7] = event.modifiers;
+    putLE(bytes + 8, static_cast<uint16_t>(event.x), 2);
+    putLE(bytes + 10, static_cast<uint16_t>(event.y), 2);
+    output.write(reinterpret_cast<const char*>(bytes), EVENT_SIZE);
+    recordedCount++;
+}
+
+void InputRecorder::stopRecording() {
+    if (!output.is_open()) return;
+    output.close();
+    std::cout << "Input recording saved: " << recordedCount << " events ("
+              << HEADER_SIZE + recordedCount * EVENT_SIZE << " bytes) to " << outputPath << std::endl;
+}
+
+bool InputRecorder::loadReplay(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        std::cerr << "InputRecorder: cannot read " << path << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, 4) != 0 ||
+        getLE(data.data() + 4, 4) != VERSION) {
+        std::cerr << "InputRecorder: " << path << " is not an input log (version " << VERSION << ")" << std::endl;
+        return false;
+    }
+    if ((data.size() - HEADER_SIZE) % EVENT_SIZE != 0) {
+        std::cerr << "InputRecorder: " << path << " is truncated" << std::endl;
+        return false;
+    }
+
+    replaySeed = getLE(data.data() + 8, 8);
+    replayEvents.clear();
+    replayIndex = 0;
+    for (size_t offset = HEADER_SIZE; offset < data.size(); offset += EVENT_SIZE) {
+        const unsigned char* p = data.data() + offset;
+        InputEvent event;
+        event.tick = static_cast<uint32_t>(getLE(p, 4));
+        event.type = p[4];
+        event.code = p[5];
+        event.state = p[6];
+        event.modifiers = p[7];
+        event.x = static_cast<int16_t>(getLE(p + 8, 2));
+        event.y = static_cast<int16_t>(getLE(p + 10, 2));
+        replayEvents.push_back(event);
+    }
+    std::cout << "Replaying " << replayEvents.size() << " input events from " << path
+              << " (seed " << replaySeed << ")" << std::endl;
+    return true;
+}
+
+bool InputRecorder::nextDue(uint32_t tick, InputEvent& event) {
+    if (replayIndex >= replayEvents.size() || replayEvents[replayIndex].tick > tick) return false;
+    event = replayEvents[replayIndex++];
+    if (replayIndex == replayEvents.size()) {
+        std::cout << "Input replay finished at tick " << tick << "; live input resumes" << std::endl;
+    }
+    return true;
+}
+
+bool InputRecorder::peekTick(uint32_t& tick) const {
+    if (replayIndex >= replayEvents.size()) return false;
+    tick = replayEvents[replayIndex].tick;
+    return true;
+}
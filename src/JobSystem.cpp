@@ -0,0 +1,240 @@
+#include "JobSystem.h"
+#include <iostream>
+
+namespace {
+
+// Failed find attempts a worker spins through before it goes to sleep
+constexpr int IDLE_SPINS = 64;
+
+// A thread's slot, cached per JobSystem generation
+struct SlotCache {
+    unsigned generation = 0;
+    bool resolved = false;
+    void* slot = nullptr;
+};
+thread_local SlotCache slotCache;
+
+}  // namespace
+
+// Chase-Lev deque over a fixed ring (Lê et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models"). The owner pushes and pops at
+// bottom; thieves take from top, racing the owner only for the last job.
+// Jobs are stored by value and copied out before the CAS on top: the owner
+// can only overwrite an entry once top has moved past it, and then the CAS
+// that would have claimed the stale copy fails and the copy is dropped.
+struct JobSystem::Slot {
+    static constexpr size_t MASK = DEQUE_CAPACITY - 1;
+
+    std::atomic<long long> top{0};
+    std::atomic<long long> bottom{0};
+    Job ring[DEQUE_CAPACITY];
+
+    // Written by the owning thread only; read while the system is idle
+    long long jobsRun = 0;
+    long long steals = 0;
+    unsigned victimSeed;
+
+    explicit Slot(unsigned seed) : victimSeed(seed | 1u) {}
+
+    bool push(const Job& job) {
+        long long b = bottom.load(std::memory_order_relaxed);
+        long long t = top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<long long>(DEQUE_CAPACITY)) return false;
+        ring[b & MASK] = job;
+        bottom.store(b + 1, std::memory_order_release);  // publishes the entry to thieves
+        return true;
+    }
+
+    bool pop(Job& out) {
+        long long b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = ring[b & MASK];
+        if (t == b) {
+            // Last job: whoever moves top first gets it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) return false;
+        }
+        return true;
+    }
+
+    bool steal(Job& out) {
+        long long t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        // Copied before claiming it; once top moves the owner may reuse the entry
+        Job job = ring[t & MASK];
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = job;
+        return true;
+    }
+
+    // xorshift, to spread thieves over victims
+    unsigned nextVictim(size_t count) {
+        victimSeed ^= victimSeed << 13;
+        victimSeed ^= victimSeed >> 17;
+        victimSeed ^= victimSeed << 5;
+        return victimSeed % static_cast<unsigned>(count);
+    }
+};
+
+JobSystem& JobSystem::instance() {
+    static JobSystem system;
+    return system;
+}
+
+JobSystem::JobSystem()
+    : externalSlotsUsed(0), generation(0), queuedJobs(0), sleepingWorkers(0), stopping(false), stats{0, 0} {
+    // The calling thread is one of the cores; the workers take the rest
+    int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    startWorkers(hardware > 1 ? hardware - 1 : 0);
+}
+
+JobSystem::~JobSystem() {
+    stopWorkers();
+}
+
+void JobSystem::setWorkerCount(int count) {
+    if (count < 0) count = 0;
+    stopWorkers();
+    startWorkers(count);
+}
+
+void JobSystem::startWorkers(int count) {
+    slots.clear();
+    for (int i = 0; i < count + MAX_EXTERNAL_THREADS; i++) {
+        slots.push_back(std::make_unique<Slot>(0x9E3779B9u * (i + 1)));
+    }
+    externalSlotsUsed = 0;
+    generation++;
+    queuedJobs = 0;
+    stopping = false;
+    for (int i = 0; i < count; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+}
+
+JobSystem::Slot* JobSystem::currentSlot() {
+    if (!slotCache.resolved || slotCache.generation != generation) {
+        // A thread outside the pool claims one of the spare deques for good
+        int index = externalSlotsUsed.fetch_add(1);
+        slotCache.slot = index < MAX_EXTERNAL_THREADS ? slots[workers.size() + index].get() : nullptr;
+        slotCache.generation = generation;
+        slotCache.resolved = true;
+    }
+    return static_cast<Slot*>(slotCache.slot);
+}
+
+void JobSystem::run(Task task, const void* context, size_t begin, size_t end, Counter& counter) {
+    Job job{task, context, begin, end, &counter};
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    Slot* own = currentSlot();
+    if (!own || !own->push(job)) {
+        execute(job);  // no deque to spare, or it is full
+        return;
+    }
+    queuedJobs.fetch_add(1);
+    if (sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+}
+
+void JobSystem::wait(Counter& counter) {
+    Slot* own = currentSlot();
+    while (!counter.isDone()) {
+        if (!tryRunOne(own)) std::this_thread::yield();
+    }
+}
+
+bool JobSystem::tryRunOne(Slot* own) {
+    Job job;
+    bool found = own && own->pop(job);
+    if (!found) {
+        size_t count = slots.size();
+        size_t first = own ? own->nextVictim(count) : 0;
+        for (size_t i = 0; i < count && !found; i++) {
+            Slot* victim = slots[(first + i) % count].get();
+            if (victim != own) found = victim->steal(job);
+        }
+        if (!found) return false;
+        if (own) own->steals++;
+    }
+    queuedJobs.fetch_sub(1);
+    if (own) own->jobsRun++;  // before execute(), whose counter release publishes it
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const Job& job) {
+    job.task(job.context, job.begin, job.end);
+    job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(int slotIndex) {
+    slotCache.slot = slots[slotIndex].get();
+    slotCache.generation = generation;
+    slotCache.resolved = true;
+    Slot* own = slots[slotIndex].get();
+
+    int idle = 0;
+    while (true) {
+        if (tryRunOne(own)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+
+        // Nothing anywhere: sleep until run() queues more
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1);
+        wake.wait(lock, [this]() { return stopping || queuedJobs.load() > 0; });
+        sleepingWorkers.fetch_sub(1);
+        if (stopping) return;
+    }
+}
+
+const JobSystem::Stats& JobSystem::getStats() const {
+    stats = {0, 0};
+    for (const auto& slot : slots) {
+        stats.jobs += slot->jobsRun;
+        stats.steals += slot->steals;
+    }
+    return stats;
+}
+
+void JobSystem::resetStats() {
+    for (auto& slot : slots) {
+        slot->jobsRun = 0;
+        slot->steals = 0;
+    }
+}
+
+void JobSystem::printStats() const {
+    const Stats& current = getStats();
+    std::cout << "Job system: " << getWorkerCount() << " workers, " << current.jobs << " jobs run, "
+              << current.steals << " stolen" << std::endl;
+}
@@ -0,0 +1,86 @@
+#include "LevelOfDetail.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Smallest on-screen diameter (pixels) that keeps a shape at level i;
+// anything smaller than the last threshold uses the coarsest level
+constexpr float LEVEL_MIN_PIXELS[LevelOfDetail::LEVEL_COUNT - 1] = {120.0f, 40.0f};
+
+// Fraction of the full slice count used at each level (20 slices -> 20, 12, 7)
+constexpr float LEVEL_SLICE_FRACTION[LevelOfDetail::LEVEL_COUNT] = {1.0f, 0.6f, 0.35f};
+
+// A size must pass a threshold by this fraction before the level changes
+constexpr float HYSTERESIS = 0.15f;
+
+}  // namespace
+
+LevelOfDetail& LevelOfDetail::instance() {
+    static LevelOfDetail lod;
+    return lod;
+}
+
+LevelOfDetail::LevelOfDetail() : pixelsPerUnitAtDistanceOne(0.0f), frameValid(false) {
+    std::fill(drawCounts, drawCounts + LEVEL_COUNT, 0);
+    std::fill(triangleCounts, triangleCounts + LEVEL_COUNT, 0);
+}
+
+void LevelOfDetail::beginFrame(const CameraView& camera) {
+    cameraPosition = camera.position;
+
+    // projection(1, 1) is cot(fovy / 2) for a perspective projection
+    pixelsPerUnitAtDistanceOne = camera.projection.at(1, 1) * camera.viewportHeight * 0.5f;
+    frameValid = pixelsPerUnitAtDistanceOne > 0.0f;
+
+    std::fill(drawCounts, drawCounts + LEVEL_COUNT, 0);
+    std::fill(triangleCounts, triangleCounts + LEVEL_COUNT, 0);
+}
+
+float LevelOfDetail::projectedDiameter(const Vector3& center, float radius) const {
+    float distance = (center - cameraPosition).length();
+    if (distance <= radius) {
+        return 1e9f;  // camera inside the bounds: treat as filling the screen
+    }
+    return 2.0f * radius * pixelsPerUnitAtDistanceOne / distance;
+}
+
+int LevelOfDetail::select(const Vector3& center, float radius, int previousLevel) const {
+    if (!frameValid) return 0;
+    return selectForSize(projectedDiameter(center, radius), previousLevel);
+}
+
+int LevelOfDetail::selectForSize(float pixelDiameter, int previousLevel) const {
+    int level = std::max(0, std::min(previousLevel, LEVEL_COUNT - 1));
+    while (level > 0 && pixelDiameter > LEVEL_MIN_PIXELS[level - 1] * (1.0f + HYSTERESIS)) {
+        level--;
+    }
+    while (level < LEVEL_COUNT - 1 && pixelDiameter < LEVEL_MIN_PIXELS[level] * (1.0f - HYSTERESIS)) {
+        level++;
+    }
+    return level;
+}
+
+int LevelOfDetail::slicesForLevel(int baseSlices, int level) {
+    level = std::max(0, std::min(level, LEVEL_COUNT - 1));
+    if (level == 0) return baseSlices;
+    int slices = static_cast<int>(baseSlices * LEVEL_SLICE_FRACTION[level] + 0.5f);
+    return std::max(std::min(MIN_SLICES, baseSlices), slices);
+}
+
+void LevelOfDetail::recordDraw(int level, int triangles, int instances) {
+    level = std::max(0, std::min(level, LEVEL_COUNT - 1));
+    drawCounts[level] += instances;
+    triangleCounts[level] += triangles * instances;
+}
+
+void LevelOfDetail::printStats() const {
+    int totalTriangles = 0;
+    std::cout << "LOD:";
+    for (int level = 0; level < LEVEL_COUNT; level++) {
+        std::cout << " level " << level << " = " << drawCounts[level] << " shapes / "
+                  << triangleCounts[level] << " tris;";
+        totalTriangles += triangleCounts[level];
+    }
+    std::cout << " total " << totalTriangles << " tris" << std::endl;
+}
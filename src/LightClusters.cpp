@@ -0,0 +1,196 @@
+#include "LightClusters.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+enum BufferSlot { LIGHT_DATA = 0, CLUSTER_GRID = 1, LIGHT_INDICES = 2 };
+
+int clampInt(int v, int lo, int hi) {
+    return std::max(lo, std::min(v, hi));
+}
+
+// NDC [-1, 1] to a tile index
+int tileFor(float ndc, int tiles) {
+    return clampInt(static_cast<int>(std::floor((ndc * 0.5f + 0.5f) * tiles)), 0, tiles - 1);
+}
+
+}  // namespace
+
+LightClusters::LightClusters()
+    : lightsDirty(true), buffers{0, 0, 0}, textures{0, 0, 0}, ready(false),
+      nearPlane(0.1f), farPlane(100.0f), sliceScale(0.0f), visibleLights(0), maxPerCluster(0) {
+}
+
+LightClusters::~LightClusters() {
+    if (ready) {
+        glDeleteTextures(3, textures);
+        glDeleteBuffers(3, buffers);
+    }
+}
+
+bool LightClusters::initialize() {
+    if (!GLEW_VERSION_3_1) {
+        std::cerr << "LightClusters: texture buffers require OpenGL 3.1" << std::endl;
+        return false;
+    }
+
+    const GLenum formats[3] = {GL_RGBA32F, GL_RG32UI, GL_R32UI};
+    glGenBuffers(3, buffers);
+    glGenTextures(3, textures);
+    for (int i = 0; i < 3; i++) {
+        glBindBuffer(GL_TEXTURE_BUFFER, buffers[i]);
+        // A texture buffer needs storage before it can be attached
+        glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_DYNAMIC_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffers[i]);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    grid.assign(CLUSTER_COUNT * 2, 0);
+    ready = true;
+    lightsDirty = true;
+    return true;
+}
+
+int LightClusters::addLight(const PointLight& light) {
+    if (static_cast<int>(lights.size()) >= MAX_LIGHTS) {
+        std::cerr << "LightClusters: light limit (" << MAX_LIGHTS << ") reached" << std::endl;
+        return -1;
+    }
+    lights.push_back(light);
+    lightsDirty = true;
+    return static_cast<int>(lights.size()) - 1;
+}
+
+void LightClusters::clearLights() {
+    lights.clear();
+    lightsDirty = true;
+}
+
+void LightClusters::uploadLights() {
+    // Positions stay in world space so camera movement never re-uploads them
+    std::vector<GLfloat> data;
+    data.reserve(lights.size() * 8);
+    for (const PointLight& light : lights) {
+        data.insert(data.end(), {light.position.x, light.position.y, light.position.z, light.radius,
+                                 light.color.r * light.intensity, light.color.g * light.intensity,
+                                 light.color.b * light.intensity, 0.0f});
+    }
+    if (data.empty()) data.assign(8, 0.0f);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, buffers[LIGHT_DATA]);
+    glBufferData(GL_TEXTURE_BUFFER, data.size() * sizeof(GLfloat), data.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    lightsDirty = false;
+}
+
+bool LightClusters::binLight(const PointLight& light, const Matrix4& view, const Matrix4& projection,
+                             ClusterRange& range) const {
+    Vector3 center = view.transformPoint(light.position);
+    float r = light.radius;
+
+    // Depth along -Z, clipped to the slice range
+    float depthMin = std::max(-center.z - r, nearPlane);
+    float depthMax = std::min(-center.z + r, farPlane);
+    if (depthMin >= depthMax) return false;
+
+    // x / depth is monotonic in depth for a fixed x, so the sphere's view-space
+    // box projects inside the extremes taken at its nearest and farthest depth
+    float xMin = center.x - r, xMax = center.x + r;
+    float yMin = center.y - r, yMax = center.y + r;
+    float ndcXMin = projection.at(0, 0) * std::min(xMin / depthMin, xMin / depthMax);
+    float ndcXMax = projection.at(0, 0) * std::max(xMax / depthMin, xMax / depthMax);
+    float ndcYMin = projection.at(1, 1) * std::min(yMin / depthMin, yMin / depthMax);
+    float ndcYMax = projection.at(1, 1) * std::max(yMax / depthMin, yMax / depthMax);
+    if (ndcXMax < -1.0f || ndcXMin > 1.0f || ndcYMax < -1.0f || ndcYMin > 1.0f) return false;
+
+    range.x0 = tileFor(ndcXMin, TILES_X);
+    range.x1 = tileFor(ndcXMax, TILES_X);
+    range.y0 = tileFor(ndcYMin, TILES_Y);
+    range.y1 = tileFor(ndcYMax, TILES_Y);
+    range.z0 = clampInt(static_cast<int>(std::log(depthMin / nearPlane) * sliceScale), 0, SLICES - 1);
+    range.z1 = clampInt(static_cast<int>(std::log(depthMax / nearPlane) * sliceScale), 0, SLICES - 1);
+    return true;
+}
+
+void LightClusters::update(const Matrix4& view, const Matrix4& projection) {
+    if (!ready) return;
+    if (lightsDirty) uploadLights();
+
+    // Recover the clip planes from a gluPerspective-style projection
+    float p22 = projection.at(2, 2);
+    float p23 = projection.at(2, 3);
+    if (std::fabs(p22 - 1.0f) > 1e-6f && std::fabs(p22 + 1.0f) > 1e-6f) {
+        nearPlane = p23 / (p22 - 1.0f);
+        farPlane = p23 / (p22 + 1.0f);
+    }
+    sliceScale = SLICES / std::log(farPlane / nearPlane);
+
+    // Two passes: count lights per cluster, then scatter indices at prefix-sum offsets
+    ranges.resize(lights.size());
+    rangeValid.assign(lights.size(), 0);
+    std::fill(grid.begin(), grid.end(), 0);
+    visibleLights = 0;
+
+    for (size_t i = 0; i < lights.size(); i++) {
+        if (!binLight(lights[i], view, projection, ranges[i])) continue;
+        rangeValid[i] = 1;
+        visibleLights++;
+        const ClusterRange& cr = ranges[i];
+        for (int z = cr.z0; z <= cr.z1; z++)
+            for (int y = cr.y0; y <= cr.y1; y++)
+                for (int x = cr.x0; x <= cr.x1; x++)
+                    grid[(x + TILES_X * (y + TILES_Y * z)) * 2 + 1]++;
+    }
+
+    GLuint offset = 0;
+    maxPerCluster = 0;
+    for (int c = 0; c < CLUSTER_COUNT; c++) {
+        grid[c * 2] = offset;
+        offset += grid[c * 2 + 1];
+        maxPerCluster = std::max(maxPerCluster, static_cast<int>(grid[c * 2 + 1]));
+        grid[c * 2 + 1] = 0;  // refilled as a cursor below
+    }
+
+    indices.resize(std::max<GLuint>(offset, 1));
+    for (size_t i = 0; i < lights.size(); i++) {
+        if (!rangeValid[i]) continue;
+        const ClusterRange& cr = ranges[i];
+        for (int z = cr.z0; z <= cr.z1; z++)
+            for (int y = cr.y0; y <= cr.y1; y++)
+                for (int x = cr.x0; x <= cr.x1; x++) {
+                    GLuint* cell = &grid[(x + TILES_X * (y + TILES_Y * z)) * 2];
+                    indices[cell[0] + cell[1]++] = static_cast<GLuint>(i);
+                }
+    }
+
+    // Orphan and refill: last frame's lists may still be in flight
+    glBindBuffer(GL_TEXTURE_BUFFER, buffers[CLUSTER_GRID]);
+    glBufferData(GL_TEXTURE_BUFFER, grid.size() * sizeof(GLuint), grid.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, buffers[LIGHT_INDICES]);
+    glBufferData(GL_TEXTURE_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LightClusters::bindTextures(GLuint firstUnit) const {
+    for (GLuint i = 0; i < 3; i++) {
+        glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void LightClusters::printStats() const {
+    int assignments = 0;
+    int litClusters = 0;
+    for (int c = 0; c < CLUSTER_COUNT && c * 2 + 1 < static_cast<int>(grid.size()); c++) {
+        assignments += grid[c * 2 + 1];
+        if (grid[c * 2 + 1] > 0) litClusters++;
+    }
+    std::cout << "Clustered lights: " << visibleLights << " of " << lights.size() << " visible, "
+              << litClusters << "/" << CLUSTER_COUNT << " clusters lit, " << assignments
+              << " assignments, max " << maxPerCluster << " per cluster" << std::endl;
+}
@@ -1,6 +1,149 @@
 #include "Lighting.h"
+#include <cstddef>
 #include <iostream>
 #include <iomanip>
+#include <string>
+
+namespace {
+
+// Default material shared by every lit surface (glass panels override it briefly)
+const GLfloat MATERIAL_SPECULAR[4] = {0.3f, 0.3f, 0.3f, 1.0f};
+const GLfloat MATERIAL_SHININESS = 32.0f;
+
+// GL_LIGHT_MODEL_AMBIENT default, applied on top of the light's own ambient
+const GLfloat SCENE_AMBIENT[4] = {0.2f, 0.2f, 0.2f, 1.0f};
+
+// std140 layout of LightBlock: every member is a vec4
+struct LightBlockData {
+    GLfloat position[4];  // world space; w = 0 for directional
+    GLfloat ambient[4];
+    GLfloat diffuse[4];   // scaled by intensity
+    GLfloat specular[4];  // scaled by intensity
+    GLfloat attenuation[4];  // constant, linear, quadratic
+    GLfloat sceneAmbient[4];
+    GLfloat materialSpecular[4];  // rgb, shininess in w
+};
+
+const char* LIT_VERTEX_SHADER = R"(
+#version 120
+varying vec3 eyePosition;
+varying vec3 eyeNormal;
+
+void main() {
+    vec4 eye = gl_ModelViewMatrix * gl_Vertex;
+    eyePosition = eye.xyz;
+    eyeNormal = gl_NormalMatrix * gl_Normal;
+    gl_FrontColor = gl_Color;
+    gl_TexCoord[0] = gl_MultiTexCoord0;
+    gl_Position = gl_ProjectionMatrix * eye;
+}
+)";
+
+// Texture units of the cluster texture buffers (unit 0 is the surface texture)
+constexpr GLuint CLUSTER_FIRST_UNIT = 1;
+
+const char* LIT_FRAGMENT_HEADER = R"(
+#version 120
+#extension GL_ARB_uniform_buffer_object : require
+)";
+
+// Prepended after the header when the cluster buffers are available
+const char* LIT_FRAGMENT_CLUSTERED = R"(
+#extension GL_EXT_gpu_shader4 : require
+#define CLUSTERED_LIGHTS 1
+)";
+
+// Per-pixel version of the fixed-function model (color material drives
+// ambient/diffuse, textures modulate the lit color), plus the point lights
+// binned into this fragment's cluster
+const char* LIT_FRAGMENT_BODY = R"(
+layout(std140) uniform LightBlock {
+    vec4 lightPosition;
+    vec4 lightAmbient;
+    vec4 lightDiffuse;
+    vec4 lightSpecular;
+    vec4 lightAttenuation;
+    vec4 sceneAmbient;
+    vec4 materialSpecular;
+};
+
+uniform mat4 viewMatrix;
+uniform bool textured;
+uniform sampler2D diffuseTexture;
+
+varying vec3 eyePosition;
+varying vec3 eyeNormal;
+
+#ifdef CLUSTERED_LIGHTS
+uniform samplerBuffer pointLightData;
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterLightIndices;
+uniform ivec3 clusterDims;
+uniform vec2 clusterTileSize;  // pixels per tile
+uniform vec2 clusterDepth;     // near plane, slices per unit of log(depth / near)
+
+vec3 shadePointLights(vec3 n, vec3 baseColor) {
+    ivec2 tile = clamp(ivec2(gl_FragCoord.xy / clusterTileSize), ivec2(0), clusterDims.xy - 1);
+    float depth = max(-eyePosition.z, clusterDepth.x);
+    int slice = clamp(int(log(depth / clusterDepth.x) * clusterDepth.y), 0, clusterDims.z - 1);
+    uvec2 range = texelFetchBuffer(clusterGrid, tile.x + clusterDims.x * (tile.y + clusterDims.y * slice)).xy;
+
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < int(range.y); i++) {
+        int lightIndex = int(texelFetchBuffer(clusterLightIndices, int(range.x) + i).x);
+        vec4 positionRadius = texelFetchBuffer(pointLightData, lightIndex * 2);
+        vec3 lightColor = texelFetchBuffer(pointLightData, lightIndex * 2 + 1).rgb;
+
+        vec3 toLight = (viewMatrix * vec4(positionRadius.xyz, 1.0)).xyz - eyePosition;
+        float dist = length(toLight);
+        if (dist >= positionRadius.w) continue;
+
+        // Smooth window that reaches zero at the light's radius
+        float window = 1.0 - (dist * dist) / (positionRadius.w * positionRadius.w);
+        result += lightColor * baseColor * max(dot(n, toLight / dist), 0.0) * window * window;
+    }
+    return result;
+}
+#endif
+
+void main() {
+    vec3 baseColor = gl_Color.rgb;
+    vec3 n = normalize(eyeNormal);
+    vec4 light = viewMatrix * lightPosition;
+
+    vec3 L;
+    float attenuation = 1.0;
+    if (light.w == 0.0) {
+        L = normalize(light.xyz);
+    } else {
+        vec3 toLight = light.xyz - eyePosition;
+        float dist = length(toLight);
+        L = toLight / dist;
+        attenuation = 1.0 / (lightAttenuation.x + lightAttenuation.y * dist +
+                             lightAttenuation.z * dist * dist);
+    }
+
+    float diffuse = max(dot(n, L), 0.0);
+    float specular = 0.0;
+    if (diffuse > 0.0) {
+        vec3 H = normalize(L + vec3(0.0, 0.0, 1.0));  // infinite viewer, like the fixed-function path
+        specular = pow(max(dot(n, H), 0.0), materialSpecular.w);
+    }
+
+    vec3 color = sceneAmbient.rgb * baseColor +
+                 attenuation * (lightAmbient.rgb * baseColor +
+                                lightDiffuse.rgb * baseColor * diffuse +
+                                lightSpecular.rgb * materialSpecular.rgb * specular);
+#ifdef CLUSTERED_LIGHTS
+    color += shadePointLights(n, baseColor);
+#endif
+    vec4 result = vec4(color, gl_Color.a);
+    if (textured) result *= texture2D(diffuseTexture, gl_TexCoord[0].st);
+    gl_FragColor = result;
+}
+)";
+
+}  // namespace
 
 Lighting::Lighting()
     : enabled(true),  // Start with lighting ENABLED for realistic look
@@ -10,7 +153,19 @@ Lighting::Lighting()
       intensity(1.0f),
       constantAttenuation(1.0f),
       linearAttenuation(0.0f),  // No attenuation for headlight
-      quadraticAttenuation(0.0f)
+      quadraticAttenuation(0.0f),
+      lightBuffer(0),
+      viewMatrixLoc(-1),
+      texturedLoc(-1),
+      clusterTileSizeLoc(-1),
+      clusterDepthLoc(-1),
+      shaderReady(false),
+      clustersEnabled(false),
+      shading(false),
+      paramsDirty(true),
+      positionDirty(false),
+      viewportWidth(1),
+      viewportHeight(1)
 {
     // Ambient light (low intensity for some base illumination)
     ambientColor[0] = 0.2f;
@@ -32,10 +187,61 @@ Lighting::Lighting()
 }
 
 Lighting::~Lighting() {
-    // Cleanup if needed
+    if (lightBuffer != 0) glDeleteBuffers(1, &lightBuffer);
+}
+
+bool Lighting::initializeShader() {
+    if (!(GLEW_VERSION_3_1 || GLEW_ARB_uniform_buffer_object)) {
+        std::cerr << "Lighting: uniform buffers unsupported, using fixed-function lighting" << std::endl;
+        return false;
+    }
+
+    // Prefer the clustered variant; without it only the main light is shaded
+    bool clustered = clusters.initialize();
+    std::string fragmentSource = std::string(LIT_FRAGMENT_HEADER) +
+                                 (clustered ? LIT_FRAGMENT_CLUSTERED : "") + LIT_FRAGMENT_BODY;
+    bool built = program.build("lighting", LIT_VERTEX_SHADER, fragmentSource.c_str());
+    if (!built && clustered) {
+        std::cerr << "Lighting: clustered point lights unavailable" << std::endl;
+        clustered = false;
+        fragmentSource = std::string(LIT_FRAGMENT_HEADER) + LIT_FRAGMENT_BODY;
+        built = program.build("lighting", LIT_VERTEX_SHADER, fragmentSource.c_str());
+    }
+    if (!built || !program.bindUniformBlock("LightBlock", LIGHT_BLOCK_BINDING)) {
+        std::cerr << "Lighting: falling back to fixed-function lighting" << std::endl;
+        program.release();
+        return false;
+    }
+    clustersEnabled = clustered;
+
+    viewMatrixLoc = program.getUniformLocation("viewMatrix");
+    texturedLoc = program.getUniformLocation("textured");
+    clusterTileSizeLoc = program.getUniformLocation("clusterTileSize");
+    clusterDepthLoc = program.getUniformLocation("clusterDepth");
+    program.use();
+    glUniform1i(program.getUniformLocation("diffuseTexture"), 0);
+    if (clustersEnabled) {
+        glUniform1i(program.getUniformLocation("pointLightData"), CLUSTER_FIRST_UNIT);
+        glUniform1i(program.getUniformLocation("clusterGrid"), CLUSTER_FIRST_UNIT + 1);
+        glUniform1i(program.getUniformLocation("clusterLightIndices"), CLUSTER_FIRST_UNIT + 2);
+        glUniform3i(program.getUniformLocation("clusterDims"),
+                    LightClusters::TILES_X, LightClusters::TILES_Y, LightClusters::SLICES);
+    }
+    ShaderProgram::useNone();
+
+    glGenBuffers(1, &lightBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, lightBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightBlockData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, LIGHT_BLOCK_BINDING, lightBuffer);
+
+    shaderReady = true;
+    paramsDirty = true;
+    std::cout << "Lighting: per-pixel shader path enabled" << std::endl;
+    return true;
 }
 
-void Lighting::apply() {
+void Lighting::apply(const CameraView& camera) {
     if (enabled) {
         glEnable(GL_LIGHTING);
         glEnable(GL_LIGHT0);
@@ -47,14 +253,18 @@ void Lighting::apply() {
         glEnable(GL_COLOR_MATERIAL);
         glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
 
-        // Set default material properties
-        GLfloat matSpecular[] = { 0.3f, 0.3f, 0.3f, 1.0f };
-        GLfloat matShininess[] = { 32.0f };
-        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, matSpecular);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, matShininess);
+        // The shader uses the camera view to bring world-space lights into eye space
+        viewMatrix = camera.view;
+        viewportWidth = camera.viewportWidth;
+        viewportHeight = camera.viewportHeight;
+        if (clustersEnabled) {
+            clusters.update(camera.view, camera.projection);
+        }
 
         // Update light parameters
         updateLight();
+        paramsDirty = false;
+        positionDirty = false;
     } else {
         glDisable(GL_LIGHTING);
         glDisable(GL_LIGHT0);
@@ -65,6 +275,8 @@ void Lighting::apply() {
 
 void Lighting::updateLight() {
     // Position (4th component: w=0 for directional, w=1 for point)
+    // GL_POSITION is transformed by the modelview when set, so it has to be
+    // re-specified every frame for immediate-mode objects still on GL_LIGHT0
     GLfloat position[4] = {
         posX,
         posY,
@@ -73,6 +285,17 @@ void Lighting::updateLight() {
     };
     glLightfv(GL_LIGHT0, GL_POSITION, position);
 
+    if (!paramsDirty) {
+        // A moving headlight changes nothing else, so only its 16 bytes are rewritten
+        if (positionDirty && shaderReady) uploadLightPosition(position);
+        return;
+    }
+
+    if (shaderReady) uploadLightBlock();
+
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, MATERIAL_SPECULAR);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, MATERIAL_SHININESS);
+
     // Ambient (not scaled by intensity to maintain minimum illumination)
     glLightfv(GL_LIGHT0, GL_AMBIENT, ambientColor);
 
@@ -107,6 +330,68 @@ void Lighting::updateLight() {
     }
 }
 
+void Lighting::uploadLightBlock() {
+    LightBlockData block = {
+        {posX, posY, posZ, pointLight ? 1.0f : 0.0f},
+        {ambientColor[0], ambientColor[1], ambientColor[2], ambientColor[3]},
+        {diffuseColor[0] * intensity, diffuseColor[1] * intensity, diffuseColor[2] * intensity, diffuseColor[3]},
+        {specularColor[0] * intensity, specularColor[1] * intensity, specularColor[2] * intensity, specularColor[3]},
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {SCENE_AMBIENT[0], SCENE_AMBIENT[1], SCENE_AMBIENT[2], SCENE_AMBIENT[3]},
+        {MATERIAL_SPECULAR[0], MATERIAL_SPECULAR[1], MATERIAL_SPECULAR[2], MATERIAL_SHININESS}
+    };
+    if (pointLight) {
+        block.attenuation[0] = constantAttenuation;
+        block.attenuation[1] = linearAttenuation;
+        block.attenuation[2] = quadraticAttenuation;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, lightBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(block), &block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void Lighting::uploadLightPosition(const GLfloat position[4]) {
+    glBindBuffer(GL_UNIFORM_BUFFER, lightBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, offsetof(LightBlockData, position), sizeof(GLfloat) * 4, position);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+bool Lighting::beginShading(bool textured) {
+    if (!enabled || !shaderReady) return false;
+
+    program.use();
+    glUniformMatrix4fv(viewMatrixLoc, 1, GL_FALSE, viewMatrix.data());
+    glUniform1i(texturedLoc, textured ? 1 : 0);
+    if (clustersEnabled) {
+        glUniform2f(clusterTileSizeLoc, static_cast<float>(viewportWidth) / LightClusters::TILES_X,
+                    static_cast<float>(viewportHeight) / LightClusters::TILES_Y);
+        glUniform2f(clusterDepthLoc, clusters.getNearPlane(), clusters.getSliceScale());
+        clusters.bindTextures(CLUSTER_FIRST_UNIT);
+    }
+    shading = true;
+    return true;
+}
+
+void Lighting::setTextured(bool textured) {
+    if (shading) glUniform1i(texturedLoc, textured ? 1 : 0);
+}
+
+void Lighting::endShading() {
+    if (!shading) return;
+    ShaderProgram::useNone();
+    shading = false;
+}
+
+int Lighting::addPointLight(const Vector3& position, const Color& color, float radius, float intensity) {
+    return clusters.addLight({position, radius, color, intensity});
+}
+
+void Lighting::printClusterStats() const {
+    if (clustersEnabled) clusters.printStats();
+    else std::cout << "Clustered lights: unavailable (" << clusters.getLightCount() << " lights unlit)" << std::endl;
+}
+
 void Lighting::setEnabled(bool enable) {
     enabled = enable;
     if (enabled) {
@@ -121,12 +406,14 @@ void Lighting::setPosition(float x, float y, float z) {
     posX = x;
     posY = y;
     posZ = z;
+    positionDirty = true;
 }
 
 void Lighting::adjustPosition(float dx, float dy, float dz) {
     posX += dx;
     posY += dy;
     posZ += dz;
+    positionDirty = true;
     if (enabled) {
         std::cout << std::fixed << std::setprecision(1)
                   << "Light position: (" << posX << ", " << posY << ", " << posZ << ")" << std::endl;
@@ -143,12 +430,14 @@ void Lighting::setIntensity(float inten) {
     intensity = inten;
     if (intensity < 0.0f) intensity = 0.0f;
     if (intensity > 5.0f) intensity = 5.0f;  // Cap at 5x for safety
+    paramsDirty = true;
 }
 
 void Lighting::adjustIntensity(float delta) {
     intensity += delta;
     if (intensity < 0.0f) intensity = 0.0f;
     if (intensity > 5.0f) intensity = 5.0f;
+    paramsDirty = true;
     if (enabled) {
         std::cout << std::fixed << std::setprecision(2)
                   << "Light intensity: " << intensity << std::endl;
@@ -157,6 +446,7 @@ void Lighting::adjustIntensity(float delta) {
 
 void Lighting::setLightType(bool isPoint) {
     pointLight = isPoint;
+    paramsDirty = true;
     if (enabled) {
         std::cout << "Light type: " << (pointLight ? "Point Light" : "Directional Light") << std::endl;
     }
@@ -166,6 +456,7 @@ void Lighting::setAttenuation(float constant, float linear, float quadratic) {
     constantAttenuation = constant;
     linearAttenuation = linear;
     quadraticAttenuation = quadratic;
+    paramsDirty = true;
 }
 
 void Lighting::updateHeadlight(float camX, float camY, float camZ, float lookX, float lookY, float lookZ) {
@@ -174,9 +465,12 @@ void Lighting::updateHeadlight(float camX, float camY, float camZ, float lookX,
     // Position light slightly in front of camera along look direction
     // This creates a headlight/flashlight effect
     float offset = 0.5f;  // Distance in front of camera
-    posX = camX + lookX * offset;
-    posY = camY + lookY * offset;
-    posZ = camZ + lookZ * offset;
+    float x = camX + lookX * offset;
+    float y = camY + lookY * offset;
+    float z = camZ + lookZ * offset;
+    if (x != posX || y != posY || z != posZ) {
+        setPosition(x, y, z);
+    }
 }
 
 void Lighting::printStatus() const {
@@ -187,6 +481,8 @@ void Lighting::printStatus() const {
               << "  Position: (" << posX << ", " << posY << ", " << posZ << ")" << std::endl;
     std::cout << std::fixed << std::setprecision(2)
               << "  Intensity: " << intensity << std::endl;
+    std::cout << "  Point lights: " << clusters.getLightCount()
+              << (clustersEnabled ? " (clustered)" : " (unavailable)") << std::endl;
     if (pointLight) {
         std::cout << "  Attenuation: const=" << constantAttenuation
                   << " linear=" << linearAttenuation
@@ -0,0 +1,58 @@
+#include "Matrix4.h"
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MATRIX4_SSE 1
+#include <xmmintrin.h>
+#endif
+
+Matrix4 Matrix4::operator*(const Matrix4& other) const {
+    Matrix4 r;
+#ifdef MATRIX4_SSE
+    // Column j of the product is this matrix's columns weighted by column j of other
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    for (int col = 0; col < 4; col++) {
+        const float* b = other.m + col * 4;
+        __m128 sum = _mm_mul_ps(c0, _mm_set1_ps(b[0]));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_set1_ps(b[1])));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_set1_ps(b[2])));
+        sum = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_set1_ps(b[3])));
+        _mm_storeu_ps(r.m + col * 4, sum);
+    }
+#else
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += at(row, k) * other.at(k, col);
+            }
+            r.at(row, col) = sum;
+        }
+    }
+#endif
+    return r;
+}
+
+void Matrix4::transformPoints(const Vector3* in, Vector3* out, size_t count) const {
+#ifdef MATRIX4_SSE
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 c3 = _mm_loadu_ps(m + 12);
+    float result[4];
+    for (size_t i = 0; i < count; i++) {
+        __m128 p = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(in[i].x)), c3);
+        p = _mm_add_ps(p, _mm_mul_ps(c1, _mm_set1_ps(in[i].y)));
+        p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(in[i].z)));
+        // Vector3 is 12 bytes, so go through a scratch lane instead of storing 16
+        _mm_storeu_ps(result, p);
+        out[i] = Vector3(result[0], result[1], result[2]);
+    }
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = transformPoint(in[i]);
+    }
+#endif
+}
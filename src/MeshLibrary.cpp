@@ -0,0 +1,60 @@
+#include "MeshLibrary.h"
+#include <iostream>
+#include <tuple>
+
+bool MeshLibrary::Key::operator<(const Key& other) const {
+    return std::tie(kind, slices, stacks, variant) <
+           std::tie(other.kind, other.slices, other.stacks, other.variant);
+}
+
+MeshLibrary& MeshLibrary::instance() {
+    static MeshLibrary library;
+    return library;
+}
+
+std::shared_ptr<GpuMesh> MeshLibrary::acquire(const Key& key, const Builder& build) {
+    auto it = meshes.find(key);
+    if (it != meshes.end()) {
+        return it->second;
+    }
+
+    std::vector<Vector3> positions, normals, texCoords;
+    std::vector<int> indices;
+    build(positions, normals, texCoords, indices);
+
+    auto mesh = std::make_shared<GpuMesh>();
+    mesh->upload(positions, normals, texCoords, indices);
+    meshes[key] = mesh;
+    return mesh;
+}
+
+int MeshLibrary::releaseUnused() {
+    int released = 0;
+    for (auto it = meshes.begin(); it != meshes.end();) {
+        // The library's own reference is the only one left
+        if (it->second.use_count() == 1) {
+            it = meshes.erase(it);
+            released++;
+        } else {
+            ++it;
+        }
+    }
+    return released;
+}
+
+void MeshLibrary::clear() {
+    meshes.clear();
+}
+
+size_t MeshLibrary::getMemoryBytes() const {
+    size_t total = 0;
+    for (const auto& entry : meshes) {
+        total += entry.second->getMemoryBytes();
+    }
+    return total;
+}
+
+void MeshLibrary::printStats() const {
+    std::cout << "MeshLibrary: " << getMeshCount() << " unique meshes resident, "
+              << getMemoryBytes() / 1024.0f << " KB" << std::endl;
+}
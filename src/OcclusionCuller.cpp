@@ -0,0 +1,194 @@
+#include "OcclusionCuller.h"
+#include "ShapeRenderer.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Occluders must be at least this tall and this wide (world units)
+constexpr float OCCLUDER_MIN_HEIGHT = 2.5f;
+constexpr float OCCLUDER_MIN_WIDTH = 2.5f;
+
+// Unit cube [0, 1]^3 as 6 quads, for the query boxes
+const GLfloat UNIT_BOX[24 * 3] = {
+    0, 0, 0,  1, 0, 0,  1, 1, 0,  0, 1, 0,   // -Z
+    0, 0, 1,  0, 1, 1,  1, 1, 1,  1, 0, 1,   // +Z
+    0, 0, 0,  0, 1, 0,  0, 1, 1,  0, 0, 1,   // -X
+    1, 0, 0,  1, 0, 1,  1, 1, 1,  1, 1, 0,   // +X
+    0, 0, 0,  0, 0, 1,  1, 0, 1,  1, 0, 0,   // -Y
+    0, 1, 0,  1, 1, 0,  1, 1, 1,  0, 1, 1,   // +Y
+};
+
+}  // namespace
+
+OcclusionCuller::OcclusionCuller() : frameIndex(0), supported(false), inPrePass(false), stats{0, 0, 0} {
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    if (!supported) return;
+    for (auto& entry : slots) {
+        if (entry.second.query) glDeleteQueries(1, &entry.second.query);
+    }
+    if (!freeQueries.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(freeQueries.size()), freeQueries.data());
+    }
+}
+
+bool OcclusionCuller::initialize() {
+    if (!GLEW_VERSION_1_5) {
+        std::cerr << "OcclusionCuller: occlusion queries require OpenGL 1.5" << std::endl;
+        return false;
+    }
+    GLint counterBits = 0;
+    glGetQueryiv(GL_SAMPLES_PASSED, GL_QUERY_COUNTER_BITS, &counterBits);
+    if (counterBits == 0) {
+        std::cerr << "OcclusionCuller: driver reports no sample counter bits" << std::endl;
+        return false;
+    }
+    supported = true;
+    return true;
+}
+
+bool OcclusionCuller::isOccluder(const Shape& shape) {
+    Vector3 size = shape.getSize();
+    return size.y >= OCCLUDER_MIN_HEIGHT && std::max(size.x, size.z) >= OCCLUDER_MIN_WIDTH;
+}
+
+GLuint OcclusionCuller::acquireQuery() {
+    if (!freeQueries.empty()) {
+        GLuint query = freeQueries.back();
+        freeQueries.pop_back();
+        return query;
+    }
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void OcclusionCuller::beginFrame(const Vector3& eye) {
+    cameraPosition = eye;
+    frameIndex++;
+    stats = {0, 0, 0};
+
+    for (auto it = slots.begin(); it != slots.end();) {
+        Slot& slot = it->second;
+
+        // Candidates that stopped being queried (died, left the frustum) give their query back
+        if (frameIndex - slot.lastSeenFrame > STALE_FRAMES) {
+            if (slot.query) freeQueries.push_back(slot.query);
+            it = slots.erase(it);
+            continue;
+        }
+
+        if (slot.pending) {
+            GLint available = 0;
+            glGetQueryObjectiv(slot.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint samples = 0;
+                glGetQueryObjectuiv(slot.query, GL_QUERY_RESULT, &samples);
+                slot.occluded = samples == 0;
+                slot.verdictFrame = slot.issuedFrame;
+                slot.pending = false;
+            } else {
+                // Don't wait on the GPU; treat it as visible until the answer arrives
+                slot.occluded = false;
+            }
+        }
+        ++it;
+    }
+}
+
+void OcclusionCuller::renderOccluders(const std::vector<std::shared_ptr<Shape>>& occluders,
+                                      const ViewFrustum& frustum) {
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_CURRENT_BIT);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+    inPrePass = true;
+
+    for (const auto& shape : occluders) {
+        if (!frustum.intersectsSphere(shape->getPosition(), shape->getBoundingRadius())) continue;
+        ShapeRenderer::draw(*shape);
+        stats.occluders++;
+    }
+
+    // Query boxes test against the occluders but must not write depth themselves
+    glDepthMask(GL_FALSE);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_TEXTURE_2D);
+    glDepthFunc(GL_LEQUAL);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, UNIT_BOX);
+}
+
+void OcclusionCuller::query(const void* key, const Vector3& boundsMin, const Vector3& boundsMax) {
+    if (!inPrePass) return;
+
+    Slot& slot = slots[key];
+    slot.lastSeenFrame = frameIndex;
+    if (slot.pending) return;  // last query still in flight
+
+    Vector3 lo = boundsMin - Vector3(BOX_MARGIN, BOX_MARGIN, BOX_MARGIN);
+    Vector3 hi = boundsMax + Vector3(BOX_MARGIN, BOX_MARGIN, BOX_MARGIN);
+
+    // A camera inside the box would see only back faces behind the near plane
+    if (cameraPosition.x >= lo.x && cameraPosition.x <= hi.x &&
+        cameraPosition.y >= lo.y && cameraPosition.y <= hi.y &&
+        cameraPosition.z >= lo.z && cameraPosition.z <= hi.z) {
+        slot.occluded = false;
+        return;
+    }
+
+    if (!slot.query) slot.query = acquireQuery();
+    glBeginQuery(GL_SAMPLES_PASSED, slot.query);
+    drawBox(lo, hi);
+    glEndQuery(GL_SAMPLES_PASSED);
+    slot.issuedFrame = frameIndex;
+    slot.pending = true;
+    stats.queries++;
+}
+
+void OcclusionCuller::drawBox(const Vector3& boundsMin, const Vector3& boundsMax) const {
+    Vector3 extent = boundsMax - boundsMin;
+    glPushMatrix();
+    glTranslatef(boundsMin.x, boundsMin.y, boundsMin.z);
+    glScalef(extent.x, extent.y, extent.z);
+    glDrawArrays(GL_QUADS, 0, 24);
+    glPopMatrix();
+}
+
+void OcclusionCuller::endFrame() {
+    if (!inPrePass) return;
+    inPrePass = false;
+
+    glPopClientAttrib();
+    glPopAttrib();
+
+    // The pre-pass depth only served the queries
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+bool OcclusionCuller::isOccluded(const void* key) {
+    // Only a recent answer counts; e.g. a candidate re-entering the frustum
+    // must not inherit a verdict from before it left
+    auto it = slots.find(key);
+    if (it == slots.end() || !it->second.occluded) return false;
+    if (frameIndex - it->second.verdictFrame > MAX_RESULT_AGE) return false;
+    stats.occluded++;
+    return true;
+}
+
+void OcclusionCuller::forget(const void* key) {
+    auto it = slots.find(key);
+    if (it == slots.end()) return;
+    // A query still in flight can go back too: beginning it again discards its result
+    if (it->second.query) freeQueries.push_back(it->second.query);
+    slots.erase(it);
+}
@@ -12,51 +12,13 @@ void Player::init() {
     groundLevel = 0.0f;
     isOnGround = true;
     testDraw = true;
+    previousPosition = renderPosition = position;
     // Initialize health
     maxHealth = DEFAULT_MAX_HEALTH;
     currentHealth = maxHealth;
     return;
 }
 
-void Player::draw() {
-    // Always draw health bar (it's 2D overlay, independent of visibility)
-    drawHealthBar();
-
-    if(!visible) return;
-    head->draw();
-    body->draw();
-    drawDirection();
-    if(testDraw) drawCoordinateAxes();
-}
-
-void Player::drawCoordinateAxes() {
-    glDisable(GL_LIGHTING);
-    glDisable(GL_DEPTH_TEST);
-    float x = position.x;
-    float y = position.y;
-    float z = position.z;
-    
-    glLineWidth(3.0f);
-    glBegin(GL_LINES);
-    
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glVertex3f(x, y, z);
-    glVertex3f(x + 2.0f, y, z);
-     
-    glColor3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(x, y, z);
-    glVertex3f(x, y + 2.0f, z);
-    
-    glColor3f(0.0f, 0.0f, 1.0f);
-    glVertex3f(x, y, z);
-    glVertex3f(x, y, z + 2.0f);
-    
-    glEnd();
-    
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-}
-
 void Player::setColor(Color icolor, PartType part) {
     switch (part) {
         case HEAD:
@@ -80,25 +42,6 @@ void Player::moveAbsolute(float dx, float dy, float dz) {
     updatePos();
 }
 
-void Player::drawDirection() {
-    glPushMatrix();
-
-    glTranslatef(position.x, position.y , position.z);
-
-    float angle = atan2(visionDirection.z, visionDirection.x) * 180.0f / float(M_PI);
-    glRotatef(-angle - 90.0f, 0.0f, 1.0f, 0.0f);
-
-    glColor3f(1.0f, 1.0f, 0.0f);
-
-    glBegin(GL_TRIANGLES);
-        glVertex3f(0.0f, 0.01f, 0.4f);
-        glVertex3f(-0.2f, 0.01f, 0.0f);
-        glVertex3f(0.2f, 0.01f, 0.0f);
-    glEnd();
-    
-    glPopMatrix();
-}
-
 bool Player::checkCollision(const std::vector<std::shared_ptr<Shape>>& objects) {
     for (size_t i = 0; i < objects.size(); ++i) {
         auto object = objects[i];
@@ -237,76 +180,3 @@ void Player::heal(float amount) {
 void Player::resetHealth() {
     currentHealth = maxHealth;
 }
-
-void Player::drawHealthBar() {
-    // Save OpenGL state
-    glPushMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-
-    // Set up orthographic projection for 2D overlay
-    GLint viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
-    glOrtho(0, viewport[2], 0, viewport[3], -1, 1);
-
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_LIGHTING);
-
-    // Health bar position and size (top-left corner)
-    float barX = 20.0f;
-    float barY = viewport[3] - 40.0f;  // 40 pixels from top
-    float barWidth = 200.0f;
-    float barHeight = 20.0f;
-
-    // Draw background (dark gray)
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glBegin(GL_QUADS);
-    glVertex2f(barX, barY);
-    glVertex2f(barX + barWidth, barY);
-    glVertex2f(barX + barWidth, barY + barHeight);
-    glVertex2f(barX, barY + barHeight);
-    glEnd();
-
-    // Draw health (green to red based on health)
-    float healthRatio = getHealthPercent();
-    if (healthRatio > 0.5f) {
-        glColor3f(0.0f, 1.0f, 0.0f);  // Green
-    } else if (healthRatio > 0.25f) {
-        glColor3f(1.0f, 1.0f, 0.0f);  // Yellow
-    } else {
-        glColor3f(1.0f, 0.0f, 0.0f);  // Red
-    }
-
-    glBegin(GL_QUADS);
-    glVertex2f(barX, barY);
-    glVertex2f(barX + barWidth * healthRatio, barY);
-    glVertex2f(barX + barWidth * healthRatio, barY + barHeight);
-    glVertex2f(barX, barY + barHeight);
-    glEnd();
-
-    // Draw border (black)
-    glColor3f(0.0f, 0.0f, 0.0f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(barX, barY);
-    glVertex2f(barX + barWidth, barY);
-    glVertex2f(barX + barWidth, barY + barHeight);
-    glVertex2f(barX, barY + barHeight);
-    glEnd();
-    glLineWidth(1.0f);
-
-    // Restore OpenGL state
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
-}
@@ -0,0 +1,180 @@
+#include "RenderQueue.h"
+#include "Lighting.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+uint32_t quantizeColor(const Color& color) {
+    auto channel = [](float v) {
+        return static_cast<uint32_t>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return (channel(color.r) << 16) | (channel(color.g) << 8) | channel(color.b);
+}
+
+bool sameColor(const Color& a, const Color& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+}  // namespace
+
+RenderQueue::RenderQueue() : stats{0, 0, 0, 0} {
+}
+
+void RenderQueue::begin(const Vector3& camera) {
+    cameraPosition = camera;
+    packets[OPAQUE_PASS].clear();
+    packets[TRANSPARENT_PASS].clear();
+    stats = {0, 0, 0, 0};
+}
+
+uint64_t RenderQueue::makeOpaqueKey(const GpuMesh& mesh, GLuint texture, const Color& color) {
+    auto it = meshIds.find(&mesh);
+    if (it == meshIds.end()) {
+        it = meshIds.emplace(&mesh, static_cast<uint32_t>(meshIds.size())).first;
+    }
+
+    // pass (1 bit) | texture (15 bits) | material (24 bits) | mesh (24 bits)
+    return (static_cast<uint64_t>(OPAQUE_PASS) << 63) |
+           (static_cast<uint64_t>(texture & 0x7FFF) << 48) |
+           (static_cast<uint64_t>(quantizeColor(color)) << 24) |
+           static_cast<uint64_t>(it->second & 0xFFFFFF);
+}
+
+void RenderQueue::submit(const GpuMesh& mesh, int firstIndex, int indexCount, const Matrix4& model,
+                         GLuint texture, const Color& color) {
+    if (!mesh.isValid() || indexCount <= 0) return;
+
+    Packet packet;
+    packet.sortKey = makeOpaqueKey(mesh, texture, color);
+    packet.mesh = &mesh;
+    packet.firstIndex = firstIndex;
+    packet.indexCount = indexCount;
+    packet.model = model;
+    packet.texture = texture;
+    packet.color = color;
+    packets[OPAQUE_PASS].push_back(packet);
+}
+
+void RenderQueue::submitTransparent(const Vector3& center, DrawCallback draw) {
+    // Farthest first: invert the distance so ascending keys run back to front.
+    // Non-negative floats order the same as their bit patterns.
+    float distanceSquared = (center - cameraPosition).dot(center - cameraPosition);
+    uint32_t distanceBits;
+    std::memcpy(&distanceBits, &distanceSquared, sizeof(distanceBits));
+
+    Packet packet;
+    packet.sortKey = (static_cast<uint64_t>(TRANSPARENT_PASS) << 63) | (0xFFFFFFFFu - distanceBits);
+    packet.mesh = nullptr;
+    packet.firstIndex = 0;
+    packet.indexCount = 0;
+    packet.texture = 0;
+    packet.callback = std::move(draw);
+    packets[TRANSPARENT_PASS].push_back(std::move(packet));
+}
+
+int RenderQueue::applyState(TrackedState& state, const Packet& packet, bool issueGL, Lighting* lighting) {
+    int changes = 0;
+
+    // Callbacks manage their own state; afterwards nothing is known
+    if (!packet.mesh) {
+        if (state.mesh) {
+            if (issueGL) state.mesh->unbind();
+            changes++;
+        }
+        state.known = false;
+        state.mesh = nullptr;
+        return changes;
+    }
+
+    bool wantTexture = packet.texture != 0;
+    if (!state.known || state.textureEnabled != wantTexture) {
+        if (issueGL) {
+            if (wantTexture) glEnable(GL_TEXTURE_2D);
+            else glDisable(GL_TEXTURE_2D);
+            if (lighting) lighting->setTextured(wantTexture);
+        }
+        state.textureEnabled = wantTexture;
+        changes++;
+    }
+    if (wantTexture && (!state.known || state.texture != packet.texture)) {
+        if (issueGL) glBindTexture(GL_TEXTURE_2D, packet.texture);
+        state.texture = packet.texture;
+        changes++;
+    }
+    if (!state.known || !sameColor(state.color, packet.color)) {
+        if (issueGL) glColor3f(packet.color.r, packet.color.g, packet.color.b);
+        state.color = packet.color;
+        changes++;
+    }
+    if (state.mesh != packet.mesh) {
+        if (issueGL) {
+            if (state.mesh) state.mesh->unbind();
+            packet.mesh->bind();
+        }
+        state.mesh = packet.mesh;
+        changes++;
+    }
+    state.known = true;
+    return changes;
+}
+
+int RenderQueue::countStateChanges(const std::vector<Packet>& list) {
+    TrackedState state = {false, false, 0, Color(), nullptr};
+    int changes = 0;
+    for (const Packet& packet : list) {
+        changes += applyState(state, packet, false, nullptr);
+    }
+    return changes;
+}
+
+void RenderQueue::execute(Pass pass, Lighting* lighting) {
+    std::vector<Packet>& list = packets[pass];
+    if (list.empty()) return;
+
+    stats.packets += static_cast<int>(list.size());
+    stats.stateChangesUnsorted += countStateChanges(list);
+
+    // Stable so equal keys keep submission order from frame to frame
+    std::stable_sort(list.begin(), list.end(),
+                     [](const Packet& a, const Packet& b) { return a.sortKey < b.sortKey; });
+
+    if (pass == TRANSPARENT_PASS) executeTransparent();
+    else executeOpaque(lighting);
+    list.clear();
+}
+
+void RenderQueue::executeOpaque(Lighting* lighting) {
+    if (lighting && !lighting->beginShading(false)) lighting = nullptr;
+
+    TrackedState state = {false, false, 0, Color(), nullptr};
+    for (const Packet& packet : packets[OPAQUE_PASS]) {
+        stats.stateChangesSorted += applyState(state, packet, true, lighting);
+
+        glPushMatrix();
+        glMultMatrixf(packet.model.data());
+        packet.mesh->drawRange(packet.firstIndex, packet.indexCount);
+        glPopMatrix();
+        stats.drawCalls++;
+    }
+    if (state.mesh) state.mesh->unbind();
+    glDisable(GL_TEXTURE_2D);
+    if (lighting) lighting->endShading();
+}
+
+void RenderQueue::executeTransparent() {
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    glDisable(GL_TEXTURE_2D);
+
+    TrackedState state = {false, false, 0, Color(), nullptr};
+    for (const Packet& packet : packets[TRANSPARENT_PASS]) {
+        stats.stateChangesSorted += applyState(state, packet, true, nullptr);
+        packet.callback();
+        stats.drawCalls++;
+    }
+
+    glPopAttrib();
+}
@@ -5,12 +5,13 @@
 #include "Shapes.h"
 #include "Enemy.h"
 #include "CollisionDetector.h"
-#include "Lighting.h"
-#include <GL/glut.h>
+#include "JobSystem.h"
+#include <algorithm>
 #include <cmath>
+#include <iostream>
 
 Scene::Scene()
-    : groundSize(50.0f), groundColor(0.2f, 0.6f, 0.2f), wallHeight(5.0f), wallThickness(1.0f), lighting(nullptr),
+    : groundSize(50.0f), groundColor(0.2f, 0.6f, 0.2f), wallHeight(5.0f), wallThickness(1.0f),
       playerInsideSafeZone(false) {
 }
 
@@ -22,9 +23,11 @@ Scene::~Scene() {
 }
 
 void Scene::initialize() {
-    // Load textures
-    addTexture(new Texture("resources/textures/WoodCap.bmp"));
-    addTexture(new Texture("resources/textures/WoodSide.bmp"));
+    // Loaded and bound by the renderer
+    texturePaths.clear();
+    textureBindings.clear();
+    addTexturePath("resources/textures/WoodCap.bmp");
+    int woodSide = addTexturePath("resources/textures/WoodSide.bmp");
 
     glassPanels.clear();
 
@@ -49,8 +52,8 @@ void Scene::initialize() {
     auto crate2 = std::make_shared<Cube>(Vector3(15.8f, 3.0f, 15.2f), Vector3(1.6f, 2.0f, 1.6f), Color(0.7f, 0.4f, 0.2f));
     addShape(crate1);
     addShape(crate2);
-    crate1->bindTexture(textures[1], Shape::BOTH);
-    crate2->bindTexture(textures[1], Shape::BOTH);
+    bindTexture(crate1, woodSide);
+    bindTexture(crate2, woodSide);
 
     // Silo at (20, -15)
     addShape(std::make_shared<Cylinder>(Vector3(20.0f, 2.5f, -15.0f), 5.0f, 2.0f, Color(0.7f, 0.7f, 0.7f)));
@@ -68,7 +71,7 @@ void Scene::initialize() {
     // Barn/warehouse at (0, 35)
     auto barn = std::make_shared<Cube>(Vector3(0.0f, 4.0f, 35.0f), Vector3(6.0f, 8.0f, 6.0f), Color(0.85f, 0.45f, 0.2f));
     addShape(barn);
-    barn->bindTexture(textures[1], Shape::BOTH);
+    bindTexture(barn, woodSide);
     addShape(std::make_shared<Cylinder>(Vector3(2.5f, 7.0f, 33.5f), 2.0f, 0.6f, Color(0.2f, 0.2f, 0.2f)));
 
     // Shed at (-35, -35)
@@ -226,41 +229,6 @@ void Scene::initialize() {
     rebuildNavigationGrid();
 }
 
-void Scene::draw() const {
-    // NOTE: Lighting is applied in display() AFTER camera view is set
-    // This allows for proper headlight mode
-
-    drawGround();
-    drawBoundaryWalls();
-    drawSafeZoneIndicator();
-
-    for (const auto& obj : gameObjects) {
-        obj->draw();
-    }
-
-    // Draw targets
-    for (const auto& target : targets) {
-        target->draw();
-    }
-
-    // Draw bullets
-    for (const auto& bullet : bullets) {
-        bullet->draw();
-    }
-    
-    for (const auto& shape : objects) {
-        shape->draw();
-    }
-    
-    // Draw enemies
-    for (const auto& enemy : enemies) {
-        enemy->draw();
-    }
-
-    drawGlassPanels();
-
-}
-
 void Scene::addGameObject(GameObject* obj) {
     gameObjects.push_back(obj);
 }
@@ -280,8 +248,13 @@ void Scene::addGlassPanel(const Vector3& center, float width, float height, bool
     glassPanels.push_back({center, width, height, facingX, normalSign});
 }
 
-void Scene::addTexture(Texture* texture) {
-    textures.push_back(texture);
+int Scene::addTexturePath(const std::string& path) {
+    texturePaths.push_back(path);
+    return static_cast<int>(texturePaths.size()) - 1;
+}
+
+void Scene::bindTexture(std::shared_ptr<Shape> shape, int textureIndex) {
+    textureBindings.push_back({shape, textureIndex});
 }
 
 void Scene::addEnemy(Enemy* enemy) {
@@ -304,166 +277,6 @@ bool Scene::isInSafeZone(const Vector3& position, float margin) const {
     return dx * dx + dz * dz <= effectiveRadius * effectiveRadius;
 }
 
-void Scene::drawGround() const {
-    glPushMatrix();
-    glColor3f(groundColor.r, groundColor.g, groundColor.b);
-
-    glBegin(GL_QUADS);
-    glNormal3f(0.0f, 1.0f, 0.0f);
-
-    glVertex3f(-groundSize, 0.0f, -groundSize);
-    glVertex3f(groundSize, 0.0f, -groundSize);
-    glVertex3f(groundSize, 0.0f, groundSize);
-    glVertex3f(-groundSize, 0.0f, groundSize);
-
-    glEnd();
-    glPopMatrix();
-}
-
-void Scene::drawBoundaryWalls() const {
-    glPushMatrix();
-    glColor3f(0.4f, 0.3f, 0.2f); // Brown/tan color for walls
-
-    // North wall (positive Z)
-    glPushMatrix();
-    glTranslatef(0.0f, wallHeight / 2.0f, groundSize);
-    glScalef(groundSize * 2.0f + wallThickness * 2.0f, wallHeight, wallThickness);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    // South wall (negative Z)
-    glPushMatrix();
-    glTranslatef(0.0f, wallHeight / 2.0f, -groundSize);
-    glScalef(groundSize * 2.0f + wallThickness * 2.0f, wallHeight, wallThickness);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    // East wall (positive X)
-    glPushMatrix();
-    glTranslatef(groundSize, wallHeight / 2.0f, 0.0f);
-    glScalef(wallThickness, wallHeight, groundSize * 2.0f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    // West wall (negative X)
-    glPushMatrix();
-    glTranslatef(-groundSize, wallHeight / 2.0f, 0.0f);
-    glScalef(wallThickness, wallHeight, groundSize * 2.0f);
-    glutSolidCube(1.0f);
-    glPopMatrix();
-
-    glPopMatrix();
-}
-
-void Scene::drawSafeZoneIndicator() const {
-    const float radius = SAFE_ZONE_RADIUS;
-    const float height = SAFE_ZONE_LIGHT_HEIGHT;
-    const int segments = SAFE_ZONE_CIRCLE_SEGMENTS;
-    const float fillAlpha = playerInsideSafeZone ? 0.05f : 0.25f;
-    const float outlineAlpha = 0.8f;
-
-    glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_COLOR_BUFFER_BIT);
-    glDisable(GL_LIGHTING);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE);
-
-    glColor4f(1.0f, 1.0f, 0.0f, fillAlpha);
-    glBegin(GL_TRIANGLE_STRIP);
-    for (int i = 0; i <= segments; ++i) {
-        int idx = i % segments;
-        float angle = (2.0f * M_PI * idx) / segments;
-        float x = cosf(angle) * radius;
-        float z = sinf(angle) * radius;
-        glVertex3f(x, 0.0f, z);
-        glVertex3f(x, height, z);
-    }
-    glEnd();
-
-    glLineWidth(2.0f);
-    glColor4f(1.0f, 1.0f, 0.0f, outlineAlpha);
-
-    glBegin(GL_LINE_LOOP);
-    for (int i = 0; i < segments; ++i) {
-        float angle = (2.0f * M_PI * i) / segments;
-        float x = cosf(angle) * radius;
-        float z = sinf(angle) * radius;
-        glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-
-    glBegin(GL_LINE_LOOP);
-    for (int i = 0; i < segments; ++i) {
-        float angle = (2.0f * M_PI * i) / segments;
-        float x = cosf(angle) * radius;
-        float z = sinf(angle) * radius;
-        glVertex3f(x, height, z);
-    }
-    glEnd();
-
-    glBegin(GL_LINES);
-    for (int i = 0; i < segments; i += 8) {
-        float angle = (2.0f * M_PI * i) / segments;
-        float x = cosf(angle) * radius;
-        float z = sinf(angle) * radius;
-        glVertex3f(x, 0.0f, z);
-        glVertex3f(x, height, z);
-    }
-    glEnd();
-
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-    glPopAttrib();
-}
-
-void Scene::drawGlassPanels() const {
-    if (glassPanels.empty()) {
-        return;
-    }
-
-    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_LIGHTING_BIT);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE);
-    glDisable(GL_TEXTURE_2D);
-
-    GLfloat glassSpecular[] = {0.8f, 0.9f, 1.0f, 1.0f};
-    GLfloat glassShininess[] = {96.0f};
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, glassSpecular);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, glassShininess);
-
-    for (const auto& panel : glassPanels) {
-        float halfW = panel.width * 0.5f;
-        float halfH = panel.height * 0.5f;
-        glColor4f(0.6f, 0.8f, 1.0f, 0.25f);
-
-        glBegin(GL_QUADS);
-        if (panel.facingX) {
-            glNormal3f(panel.normalSign, 0.0f, 0.0f);
-            glVertex3f(panel.center.x, panel.center.y - halfH, panel.center.z - halfW);
-            glVertex3f(panel.center.x, panel.center.y - halfH, panel.center.z + halfW);
-            glVertex3f(panel.center.x, panel.center.y + halfH, panel.center.z + halfW);
-            glVertex3f(panel.center.x, panel.center.y + halfH, panel.center.z - halfW);
-        } else {
-            glNormal3f(0.0f, 0.0f, panel.normalSign);
-            glVertex3f(panel.center.x - halfW, panel.center.y - halfH, panel.center.z);
-            glVertex3f(panel.center.x + halfW, panel.center.y - halfH, panel.center.z);
-            glVertex3f(panel.center.x + halfW, panel.center.y + halfH, panel.center.z);
-            glVertex3f(panel.center.x - halfW, panel.center.y + halfH, panel.center.z);
-        }
-        glEnd();
-    }
-
-    GLfloat defaultSpecular[] = {0.3f, 0.3f, 0.3f, 1.0f};
-    GLfloat defaultShininess[] = {32.0f};
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, defaultSpecular);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, defaultShininess);
-
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-    glPopAttrib();
-}
-
 // Get the highest ground level at a given XZ position (for landing on boxes)
 float Scene::getGroundHeightAt(float x, float z, float radius, float currentY) const {
     float highestGround = 0.0f; // Start with ground level
@@ -643,6 +456,11 @@ bool Scene::checkCollision(float x, float y, float z, float radius, float height
     return false; // No collision
 }
 
+void Scene::storePreviousState() {
+    for (Enemy* enemy : enemies) enemy->storePreviousState();
+    for (Bullet* bullet : bullets) bullet->storePreviousState();
+}
+
 // Update scene (bullets, physics, etc.)
 void Scene::update(float deltaTime) {
     for (auto& bullet : bullets) bullet->move(deltaTime);
@@ -655,62 +473,88 @@ void Scene::update(float deltaTime) {
     }
 }
 
+// Hits are found for all bullets in parallel against the tick's starting
+// state, then applied in bullet order. Only deaths happen in between, so a
+// hit on something still alive is what a serial pass would have found; a
+// bullet whose target died to an earlier bullet is simply tested again.
 void Scene::checkBulletCollisions() {
-    for (auto& bullet : bullets) {
-        if(!bullet->isActive()) continue;
+    bulletHits.assign(bullets.size(), BulletHit{BulletHit::NONE, 0});
+    JobSystem::instance().parallelFor(bullets.size(), BULLET_GRAIN, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (bullets[i]->isActive()) bulletHits[i] = findBulletHit(*bullets[i]);
+        }
+    });
+
+    bool enemiesKilled = false;
+    for (size_t i = 0; i < bullets.size(); i++) {
+        Bullet* bullet = bullets[i];
+        BulletHit hit = bulletHits[i];
+        if ((hit.type == BulletHit::TARGET && !targets[hit.index]->isAlive()) ||
+            (hit.type == BulletHit::ENEMY && !enemies[hit.index]->isAlive())) {
+            hit = findBulletHit(*bullet);
+        }
+        if (hit.type == BulletHit::NONE) continue;
+
+        bullet->deactivate();
+        if (hit.type == BulletHit::TARGET) {
+            targets[hit.index]->takeDamage(bullet->getDamage());
+        } else if (hit.type == BulletHit::ENEMY) {
+            enemies[hit.index]->takeDamage(bullet->getDamage());
+            enemiesKilled = enemiesKilled || !enemies[hit.index]->isAlive();
+        }
+    }
 
-        Vector3 bulletPos = bullet->getPosition();
+    // Deleted only now, so the indices above stayed valid
+    if (enemiesKilled) {
+        auto firstDead = std::stable_partition(enemies.begin(), enemies.end(),
+                                               [](Enemy* enemy) { return enemy->isAlive(); });
+        for (auto it = firstDead; it != enemies.end(); ++it) delete *it;
+        enemies.erase(firstDead, enemies.end());
+    }
+}
 
-        // Check wall collisions
-        if (bulletPos.x < -groundSize || bulletPos.x > groundSize ||
-            bulletPos.z < -groundSize || bulletPos.z > groundSize ||
-            bulletPos.y < 0.0f || bulletPos.y > wallHeight) {
-            bullet->deactivate();
-            continue;
-        }
+Scene::BulletHit Scene::findBulletHit(Bullet& bullet) const {
+    Vector3 bulletPos = bullet.getPosition();
 
-        // Check Target collisions
-        for (auto& target : targets) {
-            if (!target->isAlive()) continue;
-            if (target->checkAABBCollision(bulletPos.x, bulletPos.z, 0.1f)) {
-                // Check Y coordinate (height) as well
-                Vector3 targetPos = target->getPosition();
-                Vector3 targetSize = target->getSize();
-                if (bulletPos.y >= targetPos.y - targetSize.y &&
-                    bulletPos.y <= targetPos.y + targetSize.y) {
-                    bullet->deactivate();
-                    target->takeDamage(bullet->getDamage());
-                    break;
-                }
-            }
-        }
+    // Check wall collisions
+    if (bulletPos.x < -groundSize || bulletPos.x > groundSize ||
+        bulletPos.z < -groundSize || bulletPos.z > groundSize ||
+        bulletPos.y < 0.0f || bulletPos.y > wallHeight) {
+        return {BulletHit::WALL, 0};
+    }
 
-        if(!bullet->isActive()) continue;
-
-        // Check Enemy collisions
-        for (auto& enemy : enemies) {
-            if (CollisionDetector::checkCollision(bullet->getShape(), enemy->getHeadShape()) ||
-                CollisionDetector::checkCollision(bullet->getShape(), enemy->getBodyShape())) {
-                bullet->deactivate();
-                enemy->takeDamage(bullet->getDamage());
-                if(enemy->isAlive() == false) {
-                    delete enemy;
-                    enemies.erase(std::remove(enemies.begin(), enemies.end(), enemy), enemies.end());
-                }
-                break;
+    // Check Target collisions
+    for (size_t i = 0; i < targets.size(); i++) {
+        const Target* target = targets[i];
+        if (!target->isAlive()) continue;
+        if (target->checkAABBCollision(bulletPos.x, bulletPos.z, 0.1f)) {
+            // Check Y coordinate (height) as well
+            Vector3 targetPos = target->getPosition();
+            Vector3 targetSize = target->getSize();
+            if (bulletPos.y >= targetPos.y - targetSize.y &&
+                bulletPos.y <= targetPos.y + targetSize.y) {
+                return {BulletHit::TARGET, i};
             }
         }
+    }
 
-        if(!bullet->isActive()) continue;
+    // Check Enemy collisions
+    for (size_t i = 0; i < enemies.size(); i++) {
+        Enemy* enemy = enemies[i];
+        if (!enemy->isAlive()) continue;
+        if (CollisionDetector::checkCollision(bullet.getShape(), enemy->getHeadShape()) ||
+            CollisionDetector::checkCollision(bullet.getShape(), enemy->getBodyShape())) {
+            return {BulletHit::ENEMY, i};
+        }
+    }
 
-        // Check Shape collisions (cubes, spheres, cylinders)
-        for (auto& obj : objects) {
-            if (CollisionDetector::checkCollision(bullet->getShape(), obj.get())) {
-                bullet->deactivate();
-                break;
-            }
+    // Check Shape collisions (cubes, spheres, cylinders)
+    for (const auto& obj : objects) {
+        if (CollisionDetector::checkCollision(bullet.getShape(), obj.get())) {
+            return {BulletHit::SHAPE, 0};
         }
     }
+    return {BulletHit::NONE, 0};
 }
 
 // Add a target to the scene
@@ -845,9 +689,3 @@ void Scene::calculateSceneBounds(Vector3& center, float& radius) const {
         radius = 10.0f; // Default scene radius if very small
     }
 }
-
-void Scene::switchTexture() {
-    static int textureIndex = 1;
-    textureIndex = (textureIndex + 1) % textures.size();
-    objects[8]->bindTexture(textures[textureIndex]);
-}
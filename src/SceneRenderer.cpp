@@ -0,0 +1,776 @@
+#define _USE_MATH_DEFINES
+#include "SceneRenderer.h"
+#include "Bullet.h"
+#include "Target.h"
+#include "Shapes.h"
+#include "ShapeRenderer.h"
+#include "Enemy.h"
+#include "EnemyRenderer.h"
+#include "Player.h"
+#include "Lighting.h"
+#include "LevelOfDetail.h"
+#include "TextureCache.h"
+#include "StreamBuffer.h"
+#include "HudBatch.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+SceneRenderer::SceneRenderer(Scene& scene)
+    : scene(scene),
+      lighting(nullptr),
+      enemyCount(0),
+      bulletCount(0),
+      hordeStates(nullptr),
+      hordeAlpha(1.0f),
+      playerInsideSafeZone(false),
+      cullingGridShapes(0),
+      cullStats{0, 0, 0},
+      staticBatchingEnabled(true),
+      occluderShapes(0),
+      occlusionCullingEnabled(true) {
+}
+
+SceneRenderer::~SceneRenderer() = default;
+
+void SceneRenderer::initialize() {
+    enemyRenderer = std::make_unique<EnemyRenderer>();
+    enemyRenderer->initialize();
+    occlusionCuller.initialize();
+
+    // Request textures; they stream in over the first frames (the cache owns them)
+    textures.clear();
+    for (const std::string& path : scene.getTexturePaths()) {
+        textures.push_back(TextureCache::instance().get(path));
+    }
+    for (const Scene::TextureBinding& binding : scene.getTextureBindings()) {
+        binding.shape->bindTexture(textures[binding.textureIndex], Shape::BOTH);
+    }
+
+    rebuildCullingGrid();
+    rebuildStaticBatches();
+}
+
+void SceneRenderer::applySnapshot(const FrameSnapshot& snapshot) {
+    // Each stand-in gets the step's start pose as its previous state, then
+    // the end pose, and blends between them exactly as the live object would
+    enemyCount = snapshot.enemies.size();
+    while (enemyProxies.size() < enemyCount) {
+        enemyProxies.push_back(std::make_unique<Enemy>(Vector3()));
+    }
+    for (size_t i = 0; i < enemyCount; i++) {
+        const FrameSnapshot::EnemyState& state = snapshot.enemies[i];
+        Enemy& enemy = *enemyProxies[i];
+        if (enemy.getId() != state.id) {
+            // The stand-in changed hands (an enemy died or spawned): its
+            // occlusion verdict belonged to the previous occupant
+            occlusionCuller.forget(&enemy);
+            enemy.setId(state.id);
+        }
+        enemy.setPose(state.previousPosition, state.previousYaw);
+        enemy.storePreviousState();
+        enemy.setPose(state.position, state.yaw);
+        enemy.interpolate(snapshot.alpha);
+        enemy.setColor(state.bodyColor, Enemy::BODY);
+        enemy.setColor(state.headColor, Enemy::HEAD);
+        enemy.setHealth(state.health);
+    }
+
+    bulletCount = snapshot.bullets.size();
+    while (bulletProxies.size() < bulletCount) {
+        bulletProxies.push_back(std::make_unique<Sphere>(Vector3(), 0.1f, Color()));  // Bullet's sphere
+    }
+    for (size_t i = 0; i < bulletCount; i++) {
+        const FrameSnapshot::BulletState& state = snapshot.bullets[i];
+        bulletProxies[i]->setPosition(state.previousPosition + (state.position - state.previousPosition) * snapshot.alpha);
+        bulletProxies[i]->setColor(state.color);
+    }
+
+    if (!playerProxy) playerProxy = std::make_unique<Player>(&scene);
+    const FrameSnapshot::PlayerState& player = snapshot.player;
+    playerProxy->setPosition(player.previousPosition);
+    playerProxy->storePreviousState();
+    playerProxy->setPosition(player.position);
+    playerProxy->interpolate(snapshot.alpha);
+    playerProxy->updateVisionDirection(player.visionDirection);
+    playerProxy->setColor(player.bodyColor, Player::BODY);
+    playerProxy->setColor(player.headColor, Player::HEAD);
+    playerProxy->setHealth(player.health);
+    playerProxy->setVisible(player.visible);
+    playerProxy->setTestDraw(player.testDraw);
+
+    hordeStates = &snapshot.horde;
+    hordeAlpha = snapshot.alpha;
+    if (!snapshot.horde.empty() && !hordeProxy) hordeProxy = std::make_unique<Enemy>(Vector3());
+
+    targetHealth = snapshot.targetHealth;
+    playerInsideSafeZone = snapshot.playerInsideSafeZone;
+}
+
+void SceneRenderer::drawOpaque(const CameraView& camera) const {
+    // NOTE: Lighting is applied by the opaque pass AFTER the camera view is set
+    // This allows for proper headlight mode
+
+    // Culling and LOD work from the camera's CPU-side matrices
+    viewFrustum.extract(camera);
+    LevelOfDetail::instance().beginFrame(camera);
+    renderQueue.begin(camera.position);
+    cullStats = {0, 0, 0};
+
+    // Frustum-cull the grid shapes and enemies up front so the occlusion
+    // queries below only test what survived
+    if (staticBatchingEnabled) {
+        staticBatcher.update(scene.getObjects());
+    } else {
+        if (cullingGridShapes != scene.getObjects().size()) {
+            cullingGrid.build(scene.getObjects());
+            cullingGridShapes = scene.getObjects().size();
+        }
+        visibleObjects.clear();
+        cullStats.culled += cullingGrid.collectVisible(viewFrustum, visibleObjects);
+    }
+    visibleEnemies.clear();
+    for (size_t i = 0; i < enemyCount; i++) {
+        Enemy* enemy = enemyProxies[i].get();
+        Vector3 center;
+        float radius;
+        enemy->getBoundingSphere(center, radius);
+        if (viewFrustum.intersectsSphere(center, radius)) {
+            visibleEnemies.push_back(enemy);
+        } else {
+            cullStats.culled++;
+        }
+    }
+
+    // Depth pre-pass of the big occluders plus this frame's queries; the
+    // checks below use last frame's answers
+    OcclusionCuller* occlusion = nullptr;
+    if (occlusionCullingEnabled && occlusionCuller.isSupported()) {
+        issueOcclusionQueries();
+        occlusion = &occlusionCuller;
+    }
+
+    // Ground and walls use the per-pixel lighting program when it is available
+    bool shaded = lighting && lighting->beginShading(false);
+    drawGround();
+    drawBoundaryWalls();
+    if (shaded) lighting->endShading();
+
+    for (const auto& obj : scene.getGameObjects()) {
+        Vector3 halfSize = obj->getSize() * 0.5f;
+        if (!viewFrustum.intersectsAABB(obj->getPosition() - halfSize, obj->getPosition() + halfSize)) {
+            cullStats.culled++;
+            continue;
+        }
+        cullStats.submitted++;
+        drawGameObject(*obj);
+    }
+
+    // Draw targets; the scene never removes them, so the snapshot's health lines up
+    const std::vector<Target*>& targets = scene.getTargets();
+    for (size_t i = 0; i < targets.size() && i < targetHealth.size(); i++) {
+        const Target* target = targets[i];
+        Vector3 boxMin, boxMax;
+        getTargetBounds(*target, boxMin, boxMax);
+        if (!viewFrustum.intersectsAABB(boxMin, boxMax)) {
+            cullStats.culled++;
+            continue;
+        }
+        if (occlusion && occlusion->isOccluded(target)) {
+            cullStats.culled++;
+            cullStats.occluded++;
+            continue;
+        }
+        cullStats.submitted++;
+        drawTarget(*target, targetHealth[i]);
+    }
+
+    // Draw bullets, culled where interpolation placed them
+    for (size_t i = 0; i < bulletCount; i++) {
+        Shape* shape = bulletProxies[i].get();
+        if (!viewFrustum.intersectsSphere(shape->getPosition(), shape->getBoundingRadius())) {
+            cullStats.culled++;
+            continue;
+        }
+        cullStats.submitted++;
+        ShapeRenderer::submit(*shape, renderQueue);
+    }
+
+    if (staticBatchingEnabled) {
+        staticBatcher.draw(viewFrustum, cullStats.submitted, cullStats.culled, lighting, occlusion);
+        cullStats.occluded += staticBatcher.getLastOccludedShapes();
+    } else {
+        for (int index : visibleObjects) {
+            if (occlusion && occlusion->isOccluded(scene.getObjects()[index].get())) {
+                cullStats.culled++;
+                cullStats.occluded++;
+                continue;
+            }
+            cullStats.submitted++;
+            ShapeRenderer::submit(*scene.getObjects()[index], renderQueue);
+        }
+    }
+    // Before enemies so their health bars still draw over everything
+    renderQueue.execute(RenderQueue::OPAQUE_PASS, lighting);
+
+    // Draw enemies
+    if (occlusion) {
+        size_t kept = 0;
+        for (Enemy* enemy : visibleEnemies) {
+            if (occlusion->isOccluded(enemy)) {
+                cullStats.culled++;
+                cullStats.occluded++;
+            } else {
+                visibleEnemies[kept++] = enemy;
+            }
+        }
+        visibleEnemies.resize(kept);
+    }
+    cullStats.submitted += static_cast<int>(visibleEnemies.size());
+
+    if (enemyRenderer && enemyRenderer->isSupported()) {
+        enemyRenderer->draw(visibleEnemies, lighting && lighting->isEnabled());
+        for (const auto& enemy : visibleEnemies) {
+            EnemyRenderer::drawHealthBar(*enemy);
+        }
+    } else {
+        for (const auto& enemy : visibleEnemies) {
+            EnemyRenderer::drawImmediate(*enemy);
+        }
+    }
+
+    drawHorde();
+}
+
+void SceneRenderer::drawHorde() const {
+    if (!hordeStates || hordeStates->empty()) return;
+
+    // No occlusion queries or health bars: at horde sizes they would cost
+    // more than drawing the members they hide
+    visibleHorde.clear();
+    visibleHordeIds.clear();
+    for (const FrameSnapshot::EnemyState& state : *hordeStates) {
+        Vector3 position = state.previousPosition + (state.position - state.previousPosition) * hordeAlpha;
+        Vector3 center;
+        float radius;
+        Enemy::boundingSphereAt(position, center, radius);
+        if (!viewFrustum.intersectsSphere(center, radius)) {
+            cullStats.culled++;
+            continue;
+        }
+        // Turn the short way round, as Enemy::interpolate() does
+        float turn = std::remainder(state.yaw - state.previousYaw, 2.0f * static_cast<float>(M_PI));
+        EnemyRenderer::Instance instance;
+        instance.position[0] = position.x;
+        instance.position[1] = position.y;
+        instance.position[2] = position.z;
+        instance.yaw = state.previousYaw + turn * hordeAlpha;
+        instance.bodyColor[0] = state.bodyColor.r;
+        instance.bodyColor[1] = state.bodyColor.g;
+        instance.bodyColor[2] = state.bodyColor.b;
+        instance.headColor[0] = state.headColor.r;
+        instance.headColor[1] = state.headColor.g;
+        instance.headColor[2] = state.headColor.b;
+        visibleHorde.push_back(instance);
+        visibleHordeIds.push_back(state.id);
+    }
+    cullStats.submitted += static_cast<int>(visibleHorde.size());
+
+    if (enemyRenderer && enemyRenderer->isSupported()) {
+        enemyRenderer->drawCrowd(visibleHorde, visibleHordeIds, lighting && lighting->isEnabled());
+        return;
+    }
+    for (const EnemyRenderer::Instance& instance : visibleHorde) {
+        Vector3 position(instance.position[0], instance.position[1], instance.position[2]);
+        hordeProxy->setPose(position, instance.yaw);
+        hordeProxy->storePreviousState();
+        hordeProxy->interpolate(1.0f);
+        hordeProxy->setColor(Color(instance.bodyColor[0], instance.bodyColor[1], instance.bodyColor[2]), Enemy::BODY);
+        hordeProxy->setColor(Color(instance.headColor[0], instance.headColor[1], instance.headColor[2]), Enemy::HEAD);
+        EnemyRenderer::drawImmediate(*hordeProxy);
+    }
+}
+
+void SceneRenderer::drawTransparent() const {
+    // Blended surfaces go last, sorted back to front
+    renderQueue.submitTransparent(Vector3(0.0f, SAFE_ZONE_LIGHT_HEIGHT * 0.5f, 0.0f),
+                                  [this]() { drawSafeZoneIndicator(); });
+    for (const auto& panel : scene.getGlassPanels()) {
+        renderQueue.submitTransparent(panel.center, [this, &panel]() { drawGlassPanel(panel); });
+    }
+    renderQueue.execute(RenderQueue::TRANSPARENT_PASS);
+}
+
+void SceneRenderer::getTargetBounds(const Target& target, Vector3& boxMin, Vector3& boxMax) const {
+    // Health bar floats up to TARGET_HEALTH_BAR_CLEARANCE above the box
+    Vector3 halfSize = target.getSize() * 0.5f;
+    boxMin = target.getPosition() - halfSize;
+    boxMax = target.getPosition() + halfSize + Vector3(0.0f, TARGET_HEALTH_BAR_CLEARANCE, 0.0f);
+}
+
+void SceneRenderer::issueOcclusionQueries() const {
+    if (occluderShapes != scene.getObjects().size()) {
+        occluders.clear();
+        for (const auto& shape : scene.getObjects()) {
+            if (shape && OcclusionCuller::isOccluder(*shape)) occluders.push_back(shape);
+        }
+        occluderShapes = scene.getObjects().size();
+    }
+
+    occlusionCuller.beginFrame(viewFrustum.getCameraPosition());
+    occlusionCuller.renderOccluders(occluders, viewFrustum);
+
+    if (staticBatchingEnabled) {
+        staticBatcher.queryOcclusion(viewFrustum, occlusionCuller);
+    } else {
+        for (int index : visibleObjects) {
+            const Shape& shape = *scene.getObjects()[index];
+            Vector3 halfSize = shape.getSize() * 0.5f;
+            float radius = shape.getBoundingRadius();
+            Vector3 extent(std::max(halfSize.x, radius), std::max(halfSize.y, radius), std::max(halfSize.z, radius));
+            occlusionCuller.query(&shape, shape.getPosition() - extent, shape.getPosition() + extent);
+        }
+    }
+
+    for (const auto& target : scene.getTargets()) {
+        Vector3 boxMin, boxMax;
+        getTargetBounds(*target, boxMin, boxMax);
+        if (viewFrustum.intersectsAABB(boxMin, boxMax)) {
+            occlusionCuller.query(target, boxMin, boxMax);
+        }
+    }
+
+    for (Enemy* enemy : visibleEnemies) {
+        Vector3 center;
+        float radius;
+        enemy->getBoundingSphere(center, radius);
+        Vector3 extent(radius, radius, radius);
+        occlusionCuller.query(enemy, center - extent, center + extent);
+    }
+
+    occlusionCuller.endFrame();
+}
+
+void SceneRenderer::setLighting(Lighting* light) {
+    lighting = light;
+    if (!lighting) return;
+
+    // Light sources already modelled in the scene
+    lighting->addPointLight(Vector3(0.0f, 4.2f, -25.0f), Color(1.0f, 0.9f, 0.6f), 12.0f);   // lamp post
+    lighting->addPointLight(Vector3(-18.0f, 1.2f, 42.0f), Color(1.0f, 0.5f, 0.15f), 8.0f, 1.5f);  // campfire
+    lighting->addPointLight(Vector3(0.0f, SAFE_ZONE_LIGHT_HEIGHT * 0.25f, 0.0f), Color(1.0f, 1.0f, 0.3f),
+                            SAFE_ZONE_GLOW_RADIUS, 0.6f);  // safe zone
+}
+
+void SceneRenderer::rebuildCullingGrid() {
+    cullingGrid.build(scene.getObjects());
+    cullingGridShapes = scene.getObjects().size();
+    std::cout << "CullingGrid initialized: " << cullingGrid.getShapeCount() << " shapes in "
+              << cullingGrid.getCellCount() << " cells" << std::endl;
+}
+
+void SceneRenderer::rebuildStaticBatches() {
+    staticBatcher.build(scene.getObjects());
+}
+
+void SceneRenderer::toggleStaticBatching() {
+    staticBatchingEnabled = !staticBatchingEnabled;
+    std::cout << "Static batching: " << (staticBatchingEnabled ? "ON" : "OFF") << std::endl;
+}
+
+void SceneRenderer::toggleOcclusionCulling() {
+    occlusionCullingEnabled = !occlusionCullingEnabled;
+    std::cout << "Occlusion culling: " << (occlusionCullingEnabled ? "ON" : "OFF")
+              << (occlusionCuller.isSupported() ? "" : " (unsupported, has no effect)") << std::endl;
+}
+
+void SceneRenderer::printRenderStats() const {
+    int total = cullStats.submitted + cullStats.culled;
+    std::cout << "View culling: " << cullStats.submitted << " of " << total << " objects drawn, "
+              << cullStats.culled << " culled (" << cullStats.occluded << " occluded)" << std::endl;
+    if (occlusionCullingEnabled && occlusionCuller.isSupported()) {
+        const OcclusionCuller::Stats& occlusionStats = occlusionCuller.getStats();
+        std::cout << "Occlusion: " << occlusionStats.occluders << " occluders, " << occlusionStats.queries
+                  << " queries, " << occlusionStats.occluded << " candidates hidden ("
+                  << occlusionCuller.getTrackedCount() << " tracked)" << std::endl;
+    }
+    if (staticBatchingEnabled) {
+        std::cout << "Static batches: " << staticBatcher.getBatchCount() << " ("
+                  << staticBatcher.getLastDrawCalls() << " drawn last frame, "
+                  << staticBatcher.getMemoryBytes() / 1024.0f << " KB)" << std::endl;
+    }
+    const RenderQueue::Stats& queueStats = renderQueue.getStats();
+    std::cout << "Render queue: " << queueStats.packets << " packets, " << queueStats.drawCalls
+              << " draw calls, " << queueStats.stateChangesSorted << " state changes ("
+              << queueStats.stateChangesUnsorted << " unsorted)" << std::endl;
+    if (lighting) lighting->printClusterStats();
+    LevelOfDetail::instance().printStats();
+    TextureCache::instance().printStats();
+    const StreamBuffer& ring = StreamBuffer::instance();
+    if (ring.isSupported()) {
+        std::cout << "Stream ring: " << ring.getLastFrameBytes() / 1024.0f << " KB written last frame, "
+                  << ring.getStallCount() << " fence waits, " << ring.getOverflowCount()
+                  << " allocations refused (segment full)" << std::endl;
+    }
+}
+
+void SceneRenderer::drawGround() const {
+    const float groundSize = scene.getGroundSize();
+    const Color groundColor = scene.getGroundColor();
+    glPushMatrix();
+    glColor3f(groundColor.r, groundColor.g, groundColor.b);
+
+    glBegin(GL_QUADS);
+    glNormal3f(0.0f, 1.0f, 0.0f);
+
+    glVertex3f(-groundSize, 0.0f, -groundSize);
+    glVertex3f(groundSize, 0.0f, -groundSize);
+    glVertex3f(groundSize, 0.0f, groundSize);
+    glVertex3f(-groundSize, 0.0f, groundSize);
+
+    glEnd();
+    glPopMatrix();
+}
+
+void SceneRenderer::drawBoundaryWalls() const {
+    const float groundSize = scene.getGroundSize();
+    const float wallHeight = scene.getWallHeight();
+    const float wallThickness = scene.getWallThickness();
+    glPushMatrix();
+    glColor3f(0.4f, 0.3f, 0.2f); // Brown/tan color for walls
+
+    // North wall (positive Z)
+    glPushMatrix();
+    glTranslatef(0.0f, wallHeight / 2.0f, groundSize);
+    glScalef(groundSize * 2.0f + wallThickness * 2.0f, wallHeight, wallThickness);
+    ShapeRenderer::drawUnitCube();
+    glPopMatrix();
+
+    // South wall (negative Z)
+    glPushMatrix();
+    glTranslatef(0.0f, wallHeight / 2.0f, -groundSize);
+    glScalef(groundSize * 2.0f + wallThickness * 2.0f, wallHeight, wallThickness);
+    ShapeRenderer::drawUnitCube();
+    glPopMatrix();
+
+    // East wall (positive X)
+    glPushMatrix();
+    glTranslatef(groundSize, wallHeight / 2.0f, 0.0f);
+    glScalef(wallThickness, wallHeight, groundSize * 2.0f);
+    ShapeRenderer::drawUnitCube();
+    glPopMatrix();
+
+    // West wall (negative X)
+    glPushMatrix();
+    glTranslatef(-groundSize, wallHeight / 2.0f, 0.0f);
+    glScalef(wallThickness, wallHeight, groundSize * 2.0f);
+    ShapeRenderer::drawUnitCube();
+    glPopMatrix();
+
+    glPopMatrix();
+}
+
+void SceneRenderer::drawSafeZoneIndicator() const {
+    const float radius = Scene::SAFE_ZONE_RADIUS;
+    const float height = SAFE_ZONE_LIGHT_HEIGHT;
+    const int segments = SAFE_ZONE_CIRCLE_SEGMENTS;
+    const float fillAlpha = playerInsideSafeZone ? 0.05f : 0.25f;
+    const float outlineAlpha = 0.8f;
+
+    // Wall strip, bottom ring, top ring and every 8th post, back to back
+    const int stripCount = 2 * (segments + 1);
+    const int ringCount = segments;
+    const int postCount = 2 * ((segments + 7) / 8);
+    const int vertexCount = stripCount + 2 * ringCount + postCount;
+    const size_t bytes = vertexCount * 3 * sizeof(float);
+
+    StreamBuffer& ring = StreamBuffer::instance();
+    StreamBuffer::Allocation allocation = ring.allocate(bytes);
+    std::vector<float> fallback;
+    float* out = static_cast<float*>(allocation.data);
+    if (!allocation) {
+        fallback.resize(vertexCount * 3);
+        out = fallback.data();
+    }
+    float* strip = out;
+    float* bottomRing = strip + stripCount * 3;
+    float* topRing = bottomRing + ringCount * 3;
+    float* posts = topRing + ringCount * 3;
+    for (int i = 0; i <= segments; ++i) {
+        float angle = (2.0f * M_PI * (i % segments)) / segments;
+        float x = cosf(angle) * radius;
+        float z = sinf(angle) * radius;
+        float* v = strip + i * 6;
+        v[0] = x; v[1] = 0.0f;   v[2] = z;
+        v[3] = x; v[4] = height; v[5] = z;
+        if (i == segments) break;
+        v = bottomRing + i * 3;
+        v[0] = x; v[1] = 0.0f; v[2] = z;
+        v = topRing + i * 3;
+        v[0] = x; v[1] = height; v[2] = z;
+        if (i % 8 == 0) {
+            v = posts + (i / 8) * 6;
+            v[0] = x; v[1] = 0.0f;   v[2] = z;
+            v[3] = x; v[4] = height; v[5] = z;
+        }
+    }
+    ring.commit(allocation);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_COLOR_BUFFER_BIT);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    glBindBuffer(GL_ARRAY_BUFFER, allocation.buffer);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, allocation ? reinterpret_cast<const void*>(allocation.offset) : out);
+
+    glColor4f(1.0f, 1.0f, 0.0f, fillAlpha);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, stripCount);
+
+    glLineWidth(2.0f);
+    glColor4f(1.0f, 1.0f, 0.0f, outlineAlpha);
+    glDrawArrays(GL_LINE_LOOP, stripCount, ringCount);
+    glDrawArrays(GL_LINE_LOOP, stripCount + ringCount, ringCount);
+    glDrawArrays(GL_LINES, stripCount + 2 * ringCount, postCount);
+
+    glPopClientAttrib();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    glPopAttrib();
+}
+
+// Called from the transparent pass, which has blending on and depth writes off
+void SceneRenderer::drawGlassPanel(const Scene::GlassPanel& panel) const {
+    GLfloat glassSpecular[] = {0.8f, 0.9f, 1.0f, 1.0f};
+    GLfloat glassShininess[] = {96.0f};
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, glassSpecular);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, glassShininess);
+
+    float halfW = panel.width * 0.5f;
+    float halfH = panel.height * 0.5f;
+    glColor4f(0.6f, 0.8f, 1.0f, 0.25f);
+
+    glBegin(GL_QUADS);
+    if (panel.facingX) {
+        glNormal3f(panel.normalSign, 0.0f, 0.0f);
+        glVertex3f(panel.center.x, panel.center.y - halfH, panel.center.z - halfW);
+        glVertex3f(panel.center.x, panel.center.y - halfH, panel.center.z + halfW);
+        glVertex3f(panel.center.x, panel.center.y + halfH, panel.center.z + halfW);
+        glVertex3f(panel.center.x, panel.center.y + halfH, panel.center.z - halfW);
+    } else {
+        glNormal3f(0.0f, 0.0f, panel.normalSign);
+        glVertex3f(panel.center.x - halfW, panel.center.y - halfH, panel.center.z);
+        glVertex3f(panel.center.x + halfW, panel.center.y - halfH, panel.center.z);
+        glVertex3f(panel.center.x + halfW, panel.center.y + halfH, panel.center.z);
+        glVertex3f(panel.center.x - halfW, panel.center.y + halfH, panel.center.z);
+    }
+    glEnd();
+
+    GLfloat defaultSpecular[] = {0.3f, 0.3f, 0.3f, 1.0f};
+    GLfloat defaultShininess[] = {32.0f};
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, defaultSpecular);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SHININESS, defaultShininess);
+}
+
+void SceneRenderer::switchTexture() {
+    static int textureIndex = 1;
+    if (textures.empty() || scene.getObjects().size() <= 8) return;
+    textureIndex = (textureIndex + 1) % textures.size();
+    scene.getObjects()[8]->bindTexture(textures[textureIndex]);
+}
+
+void SceneRenderer::drawGameObject(const GameObject& object) const {
+    Vector3 position = object.getPosition();
+    Vector3 size = object.getSize();
+    Color color = object.getColor();
+    glPushMatrix();
+    glTranslatef(position.x, position.y, position.z);
+    glColor3f(color.r, color.g, color.b);
+    glScalef(size.x, size.y, size.z);
+    ShapeRenderer::drawUnitCube();
+    glPopMatrix();
+}
+
+void SceneRenderer::drawTarget(const Target& target, float healthPercent) const {
+    if (healthPercent <= 0.0f) {
+        return; // Don't draw dead targets
+    }
+
+    Vector3 position = target.getPosition();
+    glPushMatrix();
+    glTranslatef(position.x, position.y, position.z);
+
+    // Color based on health percentage
+    Color c = target.getColor();
+
+    // Blend from original color to red as health decreases
+    float r = c.r + (1.0f - c.r) * (1.0f - healthPercent);
+    float g = c.g * healthPercent;
+    float b = c.b * healthPercent;
+    glColor3f(r, g, b);
+
+    Vector3 s = target.getSize();
+    glScalef(s.x, s.y, s.z);
+    ShapeRenderer::drawUnitCube();
+    glPopMatrix();
+
+    // Draw health bar above the target
+    drawTargetHealthBar(target, healthPercent);
+}
+
+void SceneRenderer::drawTargetHealthBar(const Target& target, float healthPercent) const {
+    Vector3 pos = target.getPosition();
+    Vector3 size = target.getSize();
+
+    // Health bar position (above the target)
+    float barWidth = size.x * 1.2f;
+    float barHeight = 0.2f;
+    float barY = pos.y + size.y / 2.0f + 0.5f; // Above the target
+
+    glDisable(GL_LIGHTING); // Disable lighting for health bar
+    glDisable(GL_DEPTH_TEST); // Disable depth testing to prevent z-fighting
+
+    glPushMatrix();
+    glTranslatef(pos.x, barY, pos.z);
+
+    // Background (red - missing health)
+    glColor3f(0.3f, 0.0f, 0.0f);
+    glBegin(GL_QUADS);
+    glVertex3f(-barWidth / 2.0f, 0.0f, 0.0f);
+    glVertex3f(barWidth / 2.0f, 0.0f, 0.0f);
+    glVertex3f(barWidth / 2.0f, barHeight, 0.0f);
+    glVertex3f(-barWidth / 2.0f, barHeight, 0.0f);
+    glEnd();
+
+    // Foreground (green - current health)
+    float healthWidth = barWidth * healthPercent;
+
+    // Color transitions: green -> yellow -> red
+    float r = (healthPercent < 0.5f) ? 1.0f : 2.0f * (1.0f - healthPercent);
+    float g = (healthPercent > 0.5f) ? 1.0f : 2.0f * healthPercent;
+    glColor3f(r, g, 0.0f);
+
+    glBegin(GL_QUADS);
+    glVertex3f(-barWidth / 2.0f, 0.0f, 0.0f);
+    glVertex3f(-barWidth / 2.0f + healthWidth, 0.0f, 0.0f);
+    glVertex3f(-barWidth / 2.0f + healthWidth, barHeight, 0.0f);
+    glVertex3f(-barWidth / 2.0f, barHeight, 0.0f);
+    glEnd();
+
+    // Border (black outline)
+    glColor3f(0.0f, 0.0f, 0.0f);
+    glLineWidth(2.0f);
+    glBegin(GL_LINE_LOOP);
+    glVertex3f(-barWidth / 2.0f, 0.0f, 0.0f);
+    glVertex3f(barWidth / 2.0f, 0.0f, 0.0f);
+    glVertex3f(barWidth / 2.0f, barHeight, 0.0f);
+    glVertex3f(-barWidth / 2.0f, barHeight, 0.0f);
+    glEnd();
+
+    glPopMatrix();
+
+    glEnable(GL_DEPTH_TEST); // Re-enable depth testing
+    glEnable(GL_LIGHTING); // Re-enable lighting
+}
+
+void SceneRenderer::drawPlayer() const {
+    if (!playerProxy) return;
+    Player& player = *playerProxy;
+    // Always draw health bar (it's 2D overlay, independent of visibility)
+    drawPlayerHealthBar(player);
+
+    if (!player.isVisible()) return;
+    // The parts sit at the simulated position; shift them to the interpolated one
+    Vector3 offset = player.getRenderPosition() - player.getPosition();
+    glPushMatrix();
+    glTranslatef(offset.x, offset.y, offset.z);
+    ShapeRenderer::draw(*player.getHeadShape());
+    ShapeRenderer::draw(*player.getBodyShape());
+    drawPlayerDirection(player);
+    if (player.isTestDraw()) drawPlayerAxes(player);
+    glPopMatrix();
+}
+
+void SceneRenderer::drawPlayerAxes(Player& player) const {
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    Vector3 position = player.getPosition();
+    float x = position.x;
+    float y = position.y;
+    float z = position.z;
+
+    glLineWidth(3.0f);
+    glBegin(GL_LINES);
+
+    glColor3f(1.0f, 0.0f, 0.0f);
+    glVertex3f(x, y, z);
+    glVertex3f(x + 2.0f, y, z);
+
+    glColor3f(0.0f, 1.0f, 0.0f);
+    glVertex3f(x, y, z);
+    glVertex3f(x, y + 2.0f, z);
+
+    glColor3f(0.0f, 0.0f, 1.0f);
+    glVertex3f(x, y, z);
+    glVertex3f(x, y, z + 2.0f);
+
+    glEnd();
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_LIGHTING);
+}
+
+void SceneRenderer::drawPlayerDirection(Player& player) const {
+    Vector3 position = player.getPosition();
+    Vector3 direction = player.getVisionDirection();
+    glPushMatrix();
+
+    glTranslatef(position.x, position.y, position.z);
+
+    float angle = atan2(direction.z, direction.x) * 180.0f / float(M_PI);
+    glRotatef(-angle - 90.0f, 0.0f, 1.0f, 0.0f);
+
+    glColor3f(1.0f, 1.0f, 0.0f);
+
+    glBegin(GL_TRIANGLES);
+        glVertex3f(0.0f, 0.01f, 0.4f);
+        glVertex3f(-0.2f, 0.01f, 0.0f);
+        glVertex3f(0.2f, 0.01f, 0.0f);
+    glEnd();
+
+    glPopMatrix();
+}
+
+void SceneRenderer::drawPlayerHealthBar(const Player& player) const {
+    HudBatch& hud = HudBatch::instance();
+
+    // Health bar position and size (top-left corner)
+    float barX = 20.0f;
+    float barY = hud.getViewportHeight() - 40.0f;  // 40 pixels from top
+    float barWidth = 200.0f;
+    float barHeight = 20.0f;
+
+    // Background (dark gray)
+    hud.addQuad(barX, barY, barX + barWidth, barY + barHeight, Color(0.3f, 0.3f, 0.3f));
+
+    // Health (green to red based on health)
+    float healthRatio = player.getHealthPercent();
+    Color healthColor(1.0f, 0.0f, 0.0f);  // Red
+    if (healthRatio > 0.5f) {
+        healthColor = Color(0.0f, 1.0f, 0.0f);  // Green
+    } else if (healthRatio > 0.25f) {
+        healthColor = Color(1.0f, 1.0f, 0.0f);  // Yellow
+    }
+    hud.addQuad(barX, barY, barX + barWidth * healthRatio, barY + barHeight, healthColor);
+
+    // Border (black)
+    hud.addRectOutline(barX, barY, barX + barWidth, barY + barHeight, 2.0f, Color(0.0f, 0.0f, 0.0f));
+}
@@ -7,6 +7,8 @@
 #include <filesystem>
 #include <cstring>
 
+#ifdef FIRSTOGL_SCREEN_RECORDER
+
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
@@ -16,6 +18,21 @@ extern "C" {
 #include <libavutil/dict.h>
 }
 
+namespace {
+
+// Local time for file names (localtime() is not thread-safe)
+std::tm localTime(std::time_t time) {
+    std::tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &time);
+#else
+    localtime_r(&time, &tm);
+#endif
+    return tm;
+}
+
+}  // namespace
+
 ScreenRecorder::ScreenRecorder(int width, int height, int fps)
     : width(width), height(height), fps(fps), recording(false), frameCount(0),
       formatContext(nullptr), codecContext(nullptr), videoStream(nullptr),
@@ -45,9 +62,7 @@ bool ScreenRecorder::startRecording(const std::string& filename) {
     // Generate filename with timestamp if not provided
     std::string outputFile = filename;
     if (outputFile.empty()) {
-        auto now = std::time(nullptr);
-        std::tm tm;
-        localtime_s(&tm, &now);
+        std::tm tm = localTime(std::time(nullptr));
         std::ostringstream oss;
         oss << "../../videos/gameplay_" << std::put_time(&tm, "%Y%m%d_%H%M%S") << ".mp4";
         outputFile = oss.str();
@@ -138,9 +153,7 @@ bool ScreenRecorder::takeScreenshot() {
     std::filesystem::create_directories("../../pics");
 
     // Generate filename with timestamp
-    auto now = std::time(nullptr);
-    std::tm tm;
-    localtime_s(&tm, &now);
+    std::tm tm = localTime(std::time(nullptr));
     std::ostringstream oss;
     oss << "../../pics/screenshot_" << std::put_time(&tm, "%Y%m%d_%H%M%S") << ".png";
     std::string filename = oss.str();
@@ -464,3 +477,34 @@ void ScreenRecorder::cleanup() {
         swsContext = nullptr;
     }
 }
+
+#else
+
+// Built without FFmpeg (FIRSTOGL_SCREEN_RECORDER off): recording and
+// screenshots report that and do nothing
+ScreenRecorder::ScreenRecorder(int width, int height, int fps)
+    : width(width), height(height), fps(fps), recording(false), frameCount(0),
+      formatContext(nullptr), codecContext(nullptr), videoStream(nullptr),
+      frame(nullptr), rgbFrame(nullptr), packet(nullptr), swsContext(nullptr) {
+}
+
+ScreenRecorder::~ScreenRecorder() {
+}
+
+bool ScreenRecorder::startRecording(const std::string&) {
+    std::cerr << "Screen recording is not built in (configure with -DFIRSTOGL_SCREEN_RECORDER=ON)" << std::endl;
+    return false;
+}
+
+void ScreenRecorder::captureFrame() {
+}
+
+void ScreenRecorder::stopRecording() {
+}
+
+bool ScreenRecorder::takeScreenshot() {
+    std::cerr << "Screenshots are not built in (configure with -DFIRSTOGL_SCREEN_RECORDER=ON)" << std::endl;
+    return false;
+}
+
+#endif
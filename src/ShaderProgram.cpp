@@ -0,0 +1,98 @@
+#include "ShaderProgram.h"
+#include <iostream>
+
+ShaderProgram::ShaderProgram() : programID(0) {}
+
+ShaderProgram::~ShaderProgram() {
+    release();
+}
+
+bool ShaderProgram::build(const std::string& programName,
+                          const char* vertexSource,
+                          const char* fragmentSource,
+                          const std::vector<std::pair<GLuint, const char*>>& attributeLocations) {
+    release();
+    name = programName;
+
+    if (!GLEW_VERSION_2_0) {
+        std::cerr << "ShaderProgram(" << name << "): GLSL requires OpenGL 2.0" << std::endl;
+        return false;
+    }
+
+    GLuint vertexShader = compile(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = compile(GL_FRAGMENT_SHADER, fragmentSource);
+    if (vertexShader == 0 || fragmentShader == 0) {
+        if (vertexShader) glDeleteShader(vertexShader);
+        if (fragmentShader) glDeleteShader(fragmentShader);
+        return false;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    for (const auto& attribute : attributeLocations) {
+        glBindAttribLocation(program, attribute.first, attribute.second);
+    }
+    glLinkProgram(program);
+
+    // Shaders are owned by the program once linked
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        GLint logLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+        std::string log(logLength > 0 ? logLength : 1, '\0');
+        glGetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, &log[0]);
+        std::cerr << "ShaderProgram(" << name << "): Link failed\n" << log << std::endl;
+        glDeleteProgram(program);
+        return false;
+    }
+
+    programID = program;
+    return true;
+}
+
+GLuint ShaderProgram::compile(GLenum stage, const char* source) {
+    GLuint shader = glCreateShader(stage);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE) {
+        GLint logLength = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+        std::string log(logLength > 0 ? logLength : 1, '\0');
+        glGetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, &log[0]);
+        std::cerr << "ShaderProgram(" << name << "): "
+                  << (stage == GL_VERTEX_SHADER ? "Vertex" : "Fragment")
+                  << " shader compile failed\n" << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+void ShaderProgram::release() {
+    if (programID != 0) {
+        glDeleteProgram(programID);
+        programID = 0;
+    }
+}
+
+GLint ShaderProgram::getUniformLocation(const char* uniformName) const {
+    return glGetUniformLocation(programID, uniformName);
+}
+
+bool ShaderProgram::bindUniformBlock(const char* blockName, GLuint bindingPoint) const {
+    GLuint blockIndex = glGetUniformBlockIndex(programID, blockName);
+    if (blockIndex == GL_INVALID_INDEX) {
+        std::cerr << "ShaderProgram(" << name << "): No uniform block " << blockName << std::endl;
+        return false;
+    }
+    glUniformBlockBinding(programID, blockIndex, bindingPoint);
+    return true;
+}
@@ -0,0 +1,290 @@
+#include "ShapeRenderer.h"
+#include "ShapeTessellation.h"
+#include "GenericMesh.h"
+#include "GpuMesh.h"
+#include "MeshLibrary.h"
+#include "LevelOfDetail.h"
+#include "RenderQueue.h"
+#include "Texture.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Geometry unique to a shape: private buffers built from tessellate()
+std::shared_ptr<GpuMesh> buildOwnMesh(const Shape& shape) {
+    std::vector<Vector3> positions, normals, texCoords;
+    std::vector<int> indices;
+    shape.tessellate(positions, normals, indices);
+    shape.tessellateTexCoords(texCoords);
+
+    auto ownMesh = std::make_shared<GpuMesh>();
+    ownMesh->upload(positions, normals, texCoords, indices);
+    return ownMesh;
+}
+
+// Only valid for shapes whose tessellate() output is already in unit space
+std::shared_ptr<GpuMesh> acquireUnitMesh(const Shape& shape, const MeshLibrary::Key& key) {
+    return MeshLibrary::instance().acquire(key,
+        [&shape](std::vector<Vector3>& positions, std::vector<Vector3>& normals,
+                 std::vector<Vector3>& texCoords, std::vector<int>& indices) {
+            shape.tessellate(positions, normals, indices);
+            shape.tessellateTexCoords(texCoords);
+        });
+}
+
+class MeshAcquirer : public ShapeVisitor {
+public:
+    std::shared_ptr<GpuMesh> mesh;
+
+    void visit(Cylinder& shape) override {
+        int n = LevelOfDetail::slicesForLevel(shape.getSlices(), shape.getLodLevel());
+        mesh = MeshLibrary::instance().acquire(MeshLibrary::Key(MeshLibrary::CYLINDER_MESH, n),
+            [n](std::vector<Vector3>& positions, std::vector<Vector3>& normals,
+                std::vector<Vector3>& texCoords, std::vector<int>& indices) {
+                ShapeTessellation::tessellateUnitCylinder(n, positions, normals, indices);
+                ShapeTessellation::unitCylinderTexCoords(n, texCoords);
+            });
+    }
+
+    void visit(Sphere& shape) override {
+        int n = LevelOfDetail::slicesForLevel(shape.getSlices(), shape.getLodLevel());
+        int m = LevelOfDetail::slicesForLevel(shape.getStacks(), shape.getLodLevel());
+        mesh = MeshLibrary::instance().acquire(MeshLibrary::Key(MeshLibrary::SPHERE_MESH, n, m),
+            [n, m](std::vector<Vector3>& positions, std::vector<Vector3>& normals,
+                   std::vector<Vector3>& texCoords, std::vector<int>& indices) {
+                ShapeTessellation::tessellateUnitSphere(n, m, positions, normals, indices);
+                ShapeTessellation::unitSphereTexCoords(n, m, texCoords);
+            });
+    }
+
+    void visit(Cube& shape) override {
+        mesh = acquireUnitMesh(shape, MeshLibrary::Key(MeshLibrary::CUBE_MESH, 0));
+    }
+
+    void visit(Cone& shape) override {
+        int n = LevelOfDetail::slicesForLevel(shape.getSlices(), shape.getLodLevel());
+        mesh = MeshLibrary::instance().acquire(MeshLibrary::Key(MeshLibrary::CONE_MESH, n),
+            [n](std::vector<Vector3>& positions, std::vector<Vector3>& normals,
+                std::vector<Vector3>& texCoords, std::vector<int>& indices) {
+                ShapeTessellation::tessellateCone(n, 1.0f, 1.0f, positions, normals, indices);
+                texCoords.clear();
+            });
+    }
+
+    void visit(Prism& shape) override {
+        int n = shape.getSides();
+        mesh = MeshLibrary::instance().acquire(MeshLibrary::Key(MeshLibrary::PRISM_MESH, n),
+            [n](std::vector<Vector3>& positions, std::vector<Vector3>& normals,
+                std::vector<Vector3>& texCoords, std::vector<int>& indices) {
+                ShapeTessellation::tessellatePolygonalFrustum(n, 1.0f, 1.0f, 1.0f, positions, normals, indices);
+                texCoords.clear();
+            });
+    }
+
+    void visit(Frustum& shape) override {
+        // Radii relative to the wider end, quantized so near-identical frustums share a mesh
+        float bottomRadius = shape.getBottomRadius();
+        float topRadius = shape.getTopRadius();
+        float unitRadius = std::max(bottomRadius, topRadius);
+        int bottomPermille = unitRadius > 0.0f ? static_cast<int>(std::lround(1000.0f * bottomRadius / unitRadius)) : 1000;
+        int topPermille = unitRadius > 0.0f ? static_cast<int>(std::lround(1000.0f * topRadius / unitRadius)) : 1000;
+        int n = shape.getSides();
+        mesh = MeshLibrary::instance().acquire(
+            MeshLibrary::Key(MeshLibrary::FRUSTUM_MESH, n, 0, bottomPermille * 10000 + topPermille),
+            [n, bottomPermille, topPermille](std::vector<Vector3>& positions, std::vector<Vector3>& normals,
+                                             std::vector<Vector3>& texCoords, std::vector<int>& indices) {
+                ShapeTessellation::tessellatePolygonalFrustum(n, bottomPermille / 1000.0f, topPermille / 1000.0f, 1.0f,
+                                                              positions, normals, indices);
+                texCoords.clear();
+            });
+    }
+
+    void visit(GenericMesh& shape) override {
+        mesh = buildOwnMesh(shape);
+    }
+};
+
+void recordDraw(Shape& shape) {
+    LevelOfDetail::instance().recordDraw(shape.getLodLevel(), ShapeRenderer::ensureMesh(shape).getIndexCount() / 3);
+}
+
+// Untextured shapes take their color; textured ones are drawn unmodulated
+void bindMaterial(Shape& shape) {
+    if (Texture* texture = shape.getActiveTexture()) {
+        glEnable(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, texture->getID());
+    } else {
+        glDisable(GL_TEXTURE_2D);
+        Color color = shape.getColor();
+        glColor3f(color.r, color.g, color.b);
+    }
+}
+
+class ImmediateDrawer : public ShapeVisitor {
+public:
+    void visit(Cylinder& shape) override {
+        Texture* texture = shape.getActiveTexture();
+        if (texture) {
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, texture->getID());
+        }
+        if (shape.isAutoLod()) ShapeRenderer::updateLod(shape, shape.getPosition());
+        glPushMatrix();
+        glMultMatrixf(shape.getModelMatrix().data());
+
+        // The unit cylinder emits cap triangles first, then sides, so the two colors are two index ranges
+        GpuMesh& gpuMesh = ShapeRenderer::ensureMesh(shape);
+        int capIndexCount = LevelOfDetail::slicesForLevel(shape.getSlices(), shape.getLodLevel()) * 6;
+        recordDraw(shape);
+        gpuMesh.bind();
+        if (texture) {
+            glColor3f(1.0f, 1.0f, 1.0f);
+            gpuMesh.drawRange(0, gpuMesh.getIndexCount());
+        } else {
+            Color cap = shape.getCapColor();
+            Color side = shape.getSideColor();
+            glColor3f(cap.r, cap.g, cap.b);
+            gpuMesh.drawRange(0, capIndexCount);
+            glColor3f(side.r, side.g, side.b);
+            gpuMesh.drawRange(capIndexCount, gpuMesh.getIndexCount() - capIndexCount);
+        }
+        gpuMesh.unbind();
+        glPopMatrix();
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    void visit(Sphere& shape) override {
+        bindMaterial(shape);
+        if (shape.isAutoLod()) ShapeRenderer::updateLod(shape, shape.getPosition());
+        drawMesh(shape);
+        recordDraw(shape);
+        glDisable(GL_TEXTURE_2D);
+    }
+
+    void visit(Cube& shape) override {
+        bindMaterial(shape);
+        drawMesh(shape);
+    }
+
+    void visit(Cone& shape) override {
+        if (shape.isAutoLod()) ShapeRenderer::updateLod(shape, shape.getPosition());
+        drawColored(shape);
+        recordDraw(shape);
+    }
+
+    void visit(Prism& shape) override { drawColored(shape); }
+    void visit(Frustum& shape) override { drawColored(shape); }
+
+    void visit(GenericMesh& shape) override {
+        if (shape.getVertices().empty() || shape.getIndices().empty()) {
+            return; // Nothing to draw
+        }
+        drawColored(shape);
+    }
+
+private:
+    static void drawMesh(Shape& shape) {
+        glPushMatrix();
+        glMultMatrixf(shape.getModelMatrix().data());
+        ShapeRenderer::ensureMesh(shape).draw();
+        glPopMatrix();
+    }
+
+    static void drawColored(Shape& shape) {
+        Color color = shape.getColor();
+        glColor3f(color.r, color.g, color.b);
+        drawMesh(shape);
+    }
+};
+
+class QueueSubmitter : public ShapeVisitor {
+public:
+    explicit QueueSubmitter(RenderQueue& queue) : queue(queue) {}
+
+    void visit(Cylinder& shape) override {
+        if (shape.isAutoLod()) ShapeRenderer::updateLod(shape, shape.getPosition());
+        GpuMesh& gpuMesh = ShapeRenderer::ensureMesh(shape);
+        Matrix4 model = shape.getModelMatrix();
+        recordDraw(shape);
+
+        if (Texture* texture = shape.getActiveTexture()) {
+            queue.submit(gpuMesh, 0, gpuMesh.getIndexCount(), model, texture->getID(), Color(1.0f, 1.0f, 1.0f));
+            return;
+        }
+        int capIndexCount = LevelOfDetail::slicesForLevel(shape.getSlices(), shape.getLodLevel()) * 6;
+        queue.submit(gpuMesh, 0, capIndexCount, model, 0, shape.getCapColor());
+        queue.submit(gpuMesh, capIndexCount, gpuMesh.getIndexCount() - capIndexCount, model, 0, shape.getSideColor());
+    }
+
+    void visit(Sphere& shape) override { submitLevelled(shape); }
+    void visit(Cube& shape) override { submitWhole(shape); }
+    void visit(Cone& shape) override { submitLevelled(shape); }
+    void visit(Prism& shape) override { submitWhole(shape); }
+    void visit(Frustum& shape) override { submitWhole(shape); }
+    void visit(GenericMesh& shape) override { submitWhole(shape); }
+
+private:
+    void submitWhole(Shape& shape) {
+        GpuMesh& gpuMesh = ShapeRenderer::ensureMesh(shape);
+        Texture* texture = shape.getActiveTexture();
+        // Textured shapes are drawn unmodulated
+        Color drawColor = texture ? Color(1.0f, 1.0f, 1.0f) : shape.getColor();
+        queue.submit(gpuMesh, 0, gpuMesh.getIndexCount(), shape.getModelMatrix(),
+                     texture ? texture->getID() : 0, drawColor);
+    }
+
+    void submitLevelled(Shape& shape) {
+        if (shape.isAutoLod()) ShapeRenderer::updateLod(shape, shape.getPosition());
+        submitWhole(shape);
+        recordDraw(shape);
+    }
+
+    RenderQueue& queue;
+};
+
+}  // namespace
+
+namespace ShapeRenderer {
+
+void draw(Shape& shape) {
+    ImmediateDrawer drawer;
+    shape.accept(drawer);
+}
+
+void drawUnitCube() {
+    std::shared_ptr<GpuMesh> mesh = MeshLibrary::instance().acquire(MeshLibrary::Key(MeshLibrary::CUBE_MESH, 0),
+        [](std::vector<Vector3>& positions, std::vector<Vector3>& normals,
+           std::vector<Vector3>& texCoords, std::vector<int>& indices) {
+            Cube unitCube(Vector3(), Vector3(1.0f, 1.0f, 1.0f), Color());
+            unitCube.tessellate(positions, normals, indices);
+            unitCube.tessellateTexCoords(texCoords);
+        });
+    // The shared mesh spans [-1, 1]
+    glPushMatrix();
+    glScalef(0.5f, 0.5f, 0.5f);
+    mesh->draw();
+    glPopMatrix();
+}
+
+void submit(Shape& shape, RenderQueue& queue) {
+    QueueSubmitter submitter(queue);
+    shape.accept(submitter);
+}
+
+GpuMesh& ensureMesh(Shape& shape) {
+    Shape::MeshCache& cache = shape.getMeshCache();
+    if (cache.dirty || !cache.mesh) {
+        MeshAcquirer acquirer;
+        shape.accept(acquirer);
+        cache.mesh = acquirer.mesh;
+        cache.dirty = false;
+    }
+    return *cache.mesh;
+}
+
+void updateLod(Shape& shape, const Vector3& worldCenter) {
+    shape.selectLodLevel(LevelOfDetail::instance().select(worldCenter, shape.getBoundingRadius(), shape.getLodLevel()));
+}
+
+}  // namespace ShapeRenderer
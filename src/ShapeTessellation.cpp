@@ -0,0 +1,284 @@
+#define _USE_MATH_DEFINES
+#include "ShapeTessellation.h"
+#include <cmath>
+
+namespace ShapeTessellation {
+
+// Cone with its base at y = 0 and apex at y = height
+void tessellateCone(int slices, float baseRadius, float height,
+                    std::vector<Vector3>& positions,
+                    std::vector<Vector3>& normals,
+                    std::vector<int>& indices) {
+    positions.clear();
+    normals.clear();
+    indices.clear();
+
+    // Base center
+    positions.push_back(Vector3(0.0f, 0.0f, 0.0f));
+    normals.push_back(Vector3(0.0f, -1.0f, 0.0f));
+
+    // Base perimeter vertices
+    for (int i = 0; i <= slices; i++) {
+        float theta = (2.0f * M_PI * i) / slices;
+        float x = baseRadius * cosf(theta);
+        float z = baseRadius * sinf(theta);
+        positions.push_back(Vector3(x, 0.0f, z));
+        normals.push_back(Vector3(0.0f, -1.0f, 0.0f));
+    }
+
+    // Base cap indices
+    for (int i = 0; i < slices; i++) {
+        indices.push_back(0);
+        indices.push_back(i + 1);
+        indices.push_back(i + 2);
+    }
+
+    // Side faces get their own vertices so each carries the outward face normal
+    Vector3 apex(0.0f, height, 0.0f);
+    for (int i = 0; i < slices; i++) {
+        float theta1 = (2.0f * M_PI * i) / slices;
+        float theta2 = (2.0f * M_PI * (i + 1)) / slices;
+        Vector3 v1(baseRadius * cosf(theta1), 0.0f, baseRadius * sinf(theta1));
+        Vector3 v2(baseRadius * cosf(theta2), 0.0f, baseRadius * sinf(theta2));
+        Vector3 normal = (apex - v1).cross(v2 - v1).normalized();
+
+        int baseIdx = positions.size();
+        positions.push_back(v1);
+        positions.push_back(v2);
+        positions.push_back(apex);
+        for (int k = 0; k < 3; k++) normals.push_back(normal);
+
+        indices.push_back(baseIdx);
+        indices.push_back(baseIdx + 1);
+        indices.push_back(baseIdx + 2);
+    }
+}
+
+// Capped n-sided prism (equal radii) or frustum with its bottom at y = 0
+void tessellatePolygonalFrustum(int sides, float bottomRadius, float topRadius, float height,
+                                std::vector<Vector3>& positions,
+                                std::vector<Vector3>& normals,
+                                std::vector<int>& indices) {
+    positions.clear();
+    normals.clear();
+    indices.clear();
+
+    // Bottom cap vertices
+    for (int i = 0; i < sides; i++) {
+        float theta = (2.0f * M_PI * i) / sides;
+        float x = bottomRadius * cosf(theta);
+        float z = bottomRadius * sinf(theta);
+        positions.push_back(Vector3(x, 0.0f, z));
+        normals.push_back(Vector3(0.0f, -1.0f, 0.0f));
+    }
+
+    // Top cap vertices
+    for (int i = 0; i < sides; i++) {
+        float theta = (2.0f * M_PI * i) / sides;
+        float x = topRadius * cosf(theta);
+        float z = topRadius * sinf(theta);
+        positions.push_back(Vector3(x, height, z));
+        normals.push_back(Vector3(0.0f, 1.0f, 0.0f));
+    }
+
+    // Bottom cap indices
+    for (int i = 1; i < sides - 1; i++) {
+        indices.push_back(0);
+        indices.push_back(i);
+        indices.push_back(i + 1);
+    }
+
+    // Top cap indices
+    int topStart = sides;
+    for (int i = 1; i < sides - 1; i++) {
+        indices.push_back(topStart);
+        indices.push_back(topStart + i + 1);
+        indices.push_back(topStart + i);
+    }
+
+    // Side faces get their own vertices so each carries its face normal
+    for (int i = 0; i < sides; i++) {
+        float theta1 = (2.0f * M_PI * i) / sides;
+        float theta2 = (2.0f * M_PI * (i + 1)) / sides;
+        Vector3 v1(bottomRadius * cosf(theta1), 0.0f, bottomRadius * sinf(theta1));
+        Vector3 v2(bottomRadius * cosf(theta2), 0.0f, bottomRadius * sinf(theta2));
+        Vector3 v3(topRadius * cosf(theta2), height, topRadius * sinf(theta2));
+        Vector3 v4(topRadius * cosf(theta1), height, topRadius * sinf(theta1));
+        Vector3 normal = (v4 - v1).cross(v2 - v1).normalized();
+
+        int baseIdx = positions.size();
+        positions.push_back(v1);
+        positions.push_back(v2);
+        positions.push_back(v3);
+        positions.push_back(v4);
+        for (int k = 0; k < 4; k++) normals.push_back(normal);
+
+        // Two triangles per quad face
+        indices.push_back(baseIdx);
+        indices.push_back(baseIdx + 1);
+        indices.push_back(baseIdx + 3);
+
+        indices.push_back(baseIdx + 1);
+        indices.push_back(baseIdx + 2);
+        indices.push_back(baseIdx + 3);
+    }
+}
+
+// Unit cylinder: radius 1, y in [-0.5, 0.5]
+void tessellateUnitCylinder(int slices,
+                            std::vector<Vector3>& positions,
+                            std::vector<Vector3>& normals,
+                            std::vector<int>& indices) {
+    positions.clear();
+    normals.clear();
+    indices.clear();
+
+    // Generate vertices for bottom cap, top cap, and sides
+    // Bottom cap center
+    positions.push_back(Vector3(0.0f, -0.5f, 0.0f));
+    normals.push_back(Vector3(0.0f, -1.0f, 0.0f));
+    int bottomCenterIdx = 0;
+
+    // Top cap center
+    positions.push_back(Vector3(0.0f, 0.5f, 0.0f));
+    normals.push_back(Vector3(0.0f, 1.0f, 0.0f));
+    int topCenterIdx = 1;
+
+    // Generate ring vertices for both caps and sides
+    for (int i = 0; i <= slices; i++) {
+        float theta = (2.0f * M_PI * i) / slices;
+        float x = cosf(theta);
+        float z = sinf(theta);
+
+        // Bottom ring vertex (for caps)
+        positions.push_back(Vector3(x, -0.5f, z));
+        normals.push_back(Vector3(0.0f, -1.0f, 0.0f));
+
+        // Top ring vertex (for caps)
+        positions.push_back(Vector3(x, 0.5f, z));
+        normals.push_back(Vector3(0.0f, 1.0f, 0.0f));
+
+        // Bottom ring vertex (for sides) - outward normals
+        positions.push_back(Vector3(x, -0.5f, z));
+        normals.push_back(Vector3(x, 0.0f, z).normalized());
+
+        // Top ring vertex (for sides) - outward normals
+        positions.push_back(Vector3(x, 0.5f, z));
+        normals.push_back(Vector3(x, 0.0f, z).normalized());
+    }
+
+    // Cap indices first (slices * 6), then sides, so draw() can color them separately
+    for (int i = 0; i < slices; i++) {
+        int baseIdx = 2 + i * 4;
+
+        // Bottom cap triangle (center, edge1, edge2)
+        indices.push_back(bottomCenterIdx);
+        indices.push_back(baseIdx + 4);  // next bottom cap vertex
+        indices.push_back(baseIdx);      // current bottom cap vertex
+
+        // Top cap triangle (center, edge1, edge2)
+        indices.push_back(topCenterIdx);
+        indices.push_back(baseIdx + 1);  // current top cap vertex
+        indices.push_back(baseIdx + 5);  // next top cap vertex
+    }
+
+    for (int i = 0; i < slices; i++) {
+        int baseIdx = 2 + i * 4;
+
+        // Side quad split into 2 triangles
+        int sideCurBottom = baseIdx + 2;
+        int sideCurTop = baseIdx + 3;
+        int sideNextBottom = baseIdx + 6;
+        int sideNextTop = baseIdx + 7;
+
+        // Triangle 1
+        indices.push_back(sideCurBottom);
+        indices.push_back(sideNextBottom);
+        indices.push_back(sideNextTop);
+
+        // Triangle 2
+        indices.push_back(sideCurBottom);
+        indices.push_back(sideNextTop);
+        indices.push_back(sideCurTop);
+    }
+}
+
+void unitCylinderTexCoords(int slices, std::vector<Vector3>& texCoords) {
+    texCoords.clear();
+
+    // Same vertex order as tessellateUnitCylinder
+    texCoords.push_back(Vector3(0.5f, 0.5f, 0.0f));
+    texCoords.push_back(Vector3(0.5f, 0.5f, 0.0f));
+    for (int i = 0; i <= slices; i++) {
+        float theta = (2.0f * M_PI * i) / slices;
+        Vector3 capUV(0.5f + 0.5f * cosf(theta), 0.5f + 0.5f * sinf(theta), 0.0f);
+        texCoords.push_back(capUV);
+        texCoords.push_back(capUV);
+        texCoords.push_back(Vector3((float)i / slices, 0.0f, 0.0f));
+        texCoords.push_back(Vector3((float)i / slices, 1.0f, 0.0f));
+    }
+}
+
+// Unit sphere around the z axis
+void tessellateUnitSphere(int slices, int stacks,
+                          std::vector<Vector3>& positions,
+                          std::vector<Vector3>& normals,
+                          std::vector<int>& indices) {
+    positions.clear();
+    normals.clear();
+    indices.clear();
+
+    // Generate vertices using spherical coordinates
+    for (int j = 0; j <= stacks; j++) {
+        float phi = (M_PI * j) / stacks;
+        float sinPhi = sinf(phi);
+        float cosPhi = cosf(phi);
+
+        for (int i = 0; i <= slices; i++) {
+            float theta = (2.0f * M_PI * i) / slices;
+            float sinTheta = sinf(theta);
+            float cosTheta = cosf(theta);
+
+            // Position (unit sphere, will be scaled later)
+            float x = cosTheta * sinPhi;
+            float y = sinTheta * sinPhi;
+            float z = cosPhi;
+
+            positions.push_back(Vector3(x, y, z));
+            // For sphere, normal equals normalized position
+            normals.push_back(Vector3(x, y, z).normalized());
+        }
+    }
+
+    // Generate triangle indices from the grid
+    for (int j = 0; j < stacks; j++) {
+        for (int i = 0; i < slices; i++) {
+            int idx0 = j * (slices + 1) + i;
+            int idx1 = idx0 + 1;
+            int idx2 = (j + 1) * (slices + 1) + i;
+            int idx3 = idx2 + 1;
+
+            // Quad split into 2 triangles
+            // Triangle 1
+            indices.push_back(idx0);
+            indices.push_back(idx2);
+            indices.push_back(idx1);
+
+            // Triangle 2
+            indices.push_back(idx1);
+            indices.push_back(idx2);
+            indices.push_back(idx3);
+        }
+    }
+}
+
+void unitSphereTexCoords(int slices, int stacks, std::vector<Vector3>& texCoords) {
+    texCoords.clear();
+    for (int j = 0; j <= stacks; j++) {
+        for (int i = 0; i <= slices; i++) {
+            texCoords.push_back(Vector3(1.0f * i / slices, 1.0f * j / stacks, 0.0f));
+        }
+    }
+}
+
+}  // namespace ShapeTessellation
@@ -0,0 +1,342 @@
+// Headless load test of the gameplay library: ticks the world a fixed number
+// of times without a window and reports throughput per system.
+//
+//   sim_runner [--ticks N] [--enemies N] [--obstacles level|none|random:N]
+//              [--fire-every N] [--seed N] [--threads N] [--scaling]
+//              [--horde N] [--horde-scale]
+//
+// --threads sets how many threads the job system uses (default: every core);
+// --scaling reruns the same seeded session on 1, 2, 4 ... cores and reports
+// the speedup of each over one core.
+//
+// --horde N runs EnemyManager's horde mode with N enemies, kept topped up as
+// the player shoots them. --horde-scale is the stress test for it: one
+// session per scale step (10k to 50k enemies), each judged against the 60 Hz
+// tick budget by its 99th-percentile tick; the exit status is 2 when any
+// step misses it.
+#include "Scene.h"
+#include "Shapes.h"
+#include "Player.h"
+#include "Enemy.h"
+#include "EnemyManager.h"
+#include "GameState.h"
+#include "Random.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Same step as the game's FrameClock::FIXED_STEP
+constexpr float TICK_STEP = 1.0f / 60.0f;
+
+// Outside the safe zone, so enemies chase the player instead of wandering
+const Vector3 PLAYER_START(0.0f, 0.0f, 15.0f);
+
+// A whole tick has to fit in one step for the simulation to keep up at 60 Hz
+constexpr double TICK_BUDGET_MS = 1000.0 / 60.0;
+const int HORDE_SCALE_STEPS[] = {10000, 20000, 30000, 40000, 50000};
+// Horde sessions are long per tick, so they default to 10 simulated seconds
+constexpr int HORDE_DEFAULT_TICKS = 600;
+
+struct SimOptions {
+    int ticks = 6000;
+    int enemies = 20;
+    std::string obstacles = "level";
+    int randomObstacles = 0;
+    int fireEvery = 10;  // ticks between player shots, 0 disables firing
+    uint64_t seed = 1;
+    int threads = 0;  // 0: every hardware thread
+    bool scaling = false;
+    bool horde = false;       // enemies is the horde size
+    bool hordeScale = false;
+    bool ticksGiven = false;
+};
+
+enum SimSystem { SYSTEM_ENEMIES, SYSTEM_PLAYER, SYSTEM_SCENE, SYSTEM_COUNT };
+const char* const SYSTEM_NAMES[SYSTEM_COUNT] = {"enemies", "player", "scene"};
+
+struct SimResult {
+    size_t obstacles = 0;
+    double seconds = 0.0;
+    double systemSeconds[SYSTEM_COUNT] = {};
+    int shots = 0;
+    int peakEnemies = 0;
+    std::vector<double> tickSeconds;  // whole tick, in tick order
+
+    // Tick time, in ms, that this fraction of ticks stayed within
+    double tickPercentileMs(double fraction) const {
+        if (tickSeconds.empty()) return 0.0;
+        std::vector<double> sorted = tickSeconds;
+        size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+        return sorted[index] * 1000.0;
+    }
+};
+
+void printUsage() {
+    std::cerr << "Usage: sim_runner [--ticks N] [--enemies N] [--obstacles level|none|random:N]"
+              << " [--fire-every N] [--seed N] [--threads N] [--scaling] [--horde N] [--horde-scale]" << std::endl;
+}
+
+bool parseArgs(int argc, char** argv, SimOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--ticks") == 0 && hasValue) {
+            options.ticks = std::max(1, std::atoi(argv[++i]));
+            options.ticksGiven = true;
+        } else if (std::strcmp(arg, "--enemies") == 0 && hasValue) {
+            options.enemies = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--fire-every") == 0 && hasValue) {
+            options.fireEvery = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--scaling") == 0) {
+            options.scaling = true;
+        } else if (std::strcmp(arg, "--horde") == 0 && hasValue) {
+            options.horde = true;
+            options.enemies = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--horde-scale") == 0) {
+            options.hordeScale = true;
+        } else if (std::strcmp(arg, "--obstacles") == 0 && hasValue) {
+            std::string value = argv[++i];
+            if (value == "level" || value == "none") {
+                options.obstacles = value;
+            } else if (value.compare(0, 7, "random:") == 0 && std::atoi(value.c_str() + 7) > 0) {
+                options.obstacles = "random";
+                options.randomObstacles = std::atoi(value.c_str() + 7);
+            } else {
+                std::cerr << "sim_runner: bad --obstacles " << value << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "sim_runner: unknown or incomplete argument " << arg << std::endl;
+            return false;
+        }
+    }
+    if ((options.horde || options.hordeScale) && !options.ticksGiven) {
+        options.ticks = HORDE_DEFAULT_TICKS;
+    }
+    return true;
+}
+
+// Crates of random size scattered over the arena, clear of the safe zone
+void addRandomObstacles(Scene& scene, int count, Random& random) {
+    float limit = scene.getGroundSize() - 3.0f;
+    for (int placed = 0; placed < count;) {
+        Vector3 position(random.range(-limit, limit), 0.0f, random.range(-limit, limit));
+        if (scene.isInSafeZone(position, 3.0f)) continue;
+        Vector3 size(random.range(1.0f, 4.0f), random.range(1.0f, 4.0f), random.range(1.0f, 4.0f));
+        position.y = size.y * 0.5f;
+        scene.addShape(std::make_shared<Cube>(position, size, Color(0.7f, 0.4f, 0.2f)));
+        placed++;
+    }
+}
+
+// Aim at the nearest enemy, or sweep around the player when there is none
+Vector3 pickFireDirection(const Scene& scene, const EnemyManager& enemyManager, const Vector3& from, int tick) {
+    bool found = false;
+    Vector3 nearest;
+    float nearestDistance = 0.0f;
+    if (enemyManager.isHordeMode()) {
+        found = enemyManager.getHorde().findNearest(from, nearest);
+        nearestDistance = (nearest - from).length();
+    } else {
+        for (Enemy* enemy : scene.getEnemies()) {
+            float distance = (enemy->getPosition() - from).length();
+            if (!found || distance < nearestDistance) {
+                nearest = enemy->getPosition();
+                nearestDistance = distance;
+                found = true;
+            }
+        }
+    }
+    if (found && nearestDistance > 0.0f) {
+        return (nearest - from).normalized();
+    }
+    float angle = tick * 0.1f;
+    return Vector3(std::cos(angle), 0.0f, std::sin(angle));
+}
+
+// Builds a fresh world from options and runs the whole session on the job
+// system as currently sized
+SimResult runSimulation(const SimOptions& options) {
+    Random obstacleRandom(options.seed, Random::SIM_OBSTACLES);
+
+    Scene scene;
+    if (options.obstacles == "level") {
+        scene.initialize();
+    } else {
+        if (options.obstacles == "random") addRandomObstacles(scene, options.randomObstacles, obstacleRandom);
+        scene.rebuildCollisionGrid();
+        scene.rebuildNavigationGrid();
+    }
+
+    Player player(&scene);
+    player.setPosition(PLAYER_START);
+    player.setVisible(false);
+
+    EnemyManager enemyManager(&scene);
+    enemyManager.setSeed(options.seed);
+    enemyManager.setMaxEnemies(options.enemies);
+    enemyManager.setSpawnInterval(0.1f);
+    enemyManager.setNavigationGrid(&scene.getNavigationGrid());
+    if (options.horde) {
+        // Fill the horde in one go and top it straight back up after kills
+        enemyManager.setHordeMode(true);
+        enemyManager.setSpawnInterval(0.0f);
+        enemyManager.setHordeSpawnBatch(options.enemies);
+        enemyManager.update(TICK_STEP, GameState::PLAYING, player.getPosition());
+    }
+
+    SimResult result;
+    result.obstacles = scene.getObjects().size();
+    result.tickSeconds.reserve(options.ticks);
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point runStart = Clock::now();
+    for (int tick = 0; tick < options.ticks; tick++) {
+        Clock::time_point start = Clock::now();
+        // The player is invulnerable here; the hit test still runs for its cost
+        enemyManager.update(TICK_STEP, GameState::PLAYING, player.getPosition());
+        enemyManager.checkPlayerCollision(&player, TICK_STEP);
+        Clock::time_point enemiesDone = Clock::now();
+
+        player.update(TICK_STEP);
+        scene.setPlayerInsideSafeZone(scene.isInSafeZone(player.getPosition()));
+        Clock::time_point playerDone = Clock::now();
+
+        if (options.fireEvery > 0 && tick % options.fireEvery == 0) {
+            Vector3 muzzle = player.getPosition() + Vector3(0.0f, 1.0f, 0.0f);
+            scene.fireBullet(muzzle, pickFireDirection(scene, enemyManager, muzzle, tick));
+            result.shots++;
+        }
+        scene.update(TICK_STEP);
+        Clock::time_point sceneDone = Clock::now();
+
+        result.systemSeconds[SYSTEM_ENEMIES] += std::chrono::duration<double>(enemiesDone - start).count();
+        result.systemSeconds[SYSTEM_PLAYER] += std::chrono::duration<double>(playerDone - enemiesDone).count();
+        result.systemSeconds[SYSTEM_SCENE] += std::chrono::duration<double>(sceneDone - playerDone).count();
+        result.tickSeconds.push_back(std::chrono::duration<double>(sceneDone - start).count());
+        result.peakEnemies = std::max(result.peakEnemies, enemyManager.getEnemyCount());
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    return result;
+}
+
+void printHeader(const SimOptions& options, const SimResult& result) {
+    std::cout << "sim_runner: " << options.ticks << " ticks, " << options.enemies
+              << (options.horde ? " horde enemies, " : " enemies, ")
+              << result.obstacles << " obstacles (" << options.obstacles << ")" << std::endl;
+}
+
+// Mean, 99th-percentile and worst tick against the 60 Hz budget; true when the 99th percentile fits
+bool printTickBudget(const SimResult& result) {
+    double meanMs = result.tickSeconds.empty() ? 0.0 : result.seconds * 1000.0 / result.tickSeconds.size();
+    double p99Ms = result.tickPercentileMs(0.99);
+    bool withinBudget = p99Ms <= TICK_BUDGET_MS;
+    std::cout << "mean " << meanMs << " ms, p99 " << p99Ms << " ms, worst " << result.tickPercentileMs(1.0)
+              << " ms per tick (budget " << TICK_BUDGET_MS << " ms): "
+              << (withinBudget ? "within budget" : "OVER BUDGET") << std::endl;
+    return withinBudget;
+}
+
+// One horde session per scale step on the job system as currently sized
+int runHordeScale(SimOptions options) {
+    options.horde = true;
+    std::cout << "sim_runner: horde scale test, " << options.ticks << " ticks per step on "
+              << JobSystem::instance().getThreadCount() << " threads" << std::endl;
+    bool allWithinBudget = true;
+    for (int enemies : HORDE_SCALE_STEPS) {
+        options.enemies = enemies;
+        SimResult result = runSimulation(options);
+        std::cout << "  " << enemies << " enemies (";
+        for (int system = 0; system < SYSTEM_COUNT; system++) {
+            std::cout << (system ? ", " : "") << SYSTEM_NAMES[system] << " "
+                      << result.systemSeconds[system] * 1000.0 / options.ticks << " ms/tick";
+        }
+        std::cout << "): ";
+        allWithinBudget = printTickBudget(result) && allWithinBudget;
+    }
+    return allWithinBudget ? 0 : 2;
+}
+
+// 1, 2, 4 ... threads, ending with every hardware thread
+std::vector<int> scalingSteps() {
+    int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<int> steps;
+    for (int threads = 1; threads < hardware; threads *= 2) steps.push_back(threads);
+    steps.push_back(hardware);
+    return steps;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    SimOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    JobSystem& jobs = JobSystem::instance();
+
+    if (options.hordeScale) {
+        if (options.threads > 0) jobs.setWorkerCount(options.threads - 1);
+        int status = runHordeScale(options);
+        jobs.printStats();
+        return status;
+    }
+
+    if (options.scaling) {
+        // Same seed every run, so each thread count does identical work
+        std::vector<int> steps = scalingSteps();
+        std::vector<SimResult> results;
+        for (int threads : steps) {
+            jobs.setWorkerCount(threads - 1);
+            results.push_back(runSimulation(options));
+        }
+        printHeader(options, results.front());
+        std::cout << "Peak enemies " << results.front().peakEnemies << ", shots fired "
+                  << results.front().shots << std::endl;
+        double baseline = results.front().seconds;
+        for (size_t i = 0; i < steps.size(); i++) {
+            const SimResult& result = results[i];
+            std::cout << "  " << steps[i] << " threads: "
+                      << (result.seconds > 0.0 ? options.ticks / result.seconds : 0.0) << " ticks/s, speedup "
+                      << (result.seconds > 0.0 ? baseline / result.seconds : 0.0) << "x (";
+            for (int system = 0; system < SYSTEM_COUNT; system++) {
+                std::cout << (system ? ", " : "") << SYSTEM_NAMES[system] << " "
+                          << result.systemSeconds[system] * 1000.0 / options.ticks << " ms/tick";
+            }
+            std::cout << ")" << std::endl;
+        }
+        return 0;
+    }
+
+    if (options.threads > 0) jobs.setWorkerCount(options.threads - 1);
+    SimResult result = runSimulation(options);
+    printHeader(options, result);
+    std::cout << "Simulated " << options.ticks * TICK_STEP << " s in " << result.seconds * 1000.0 << " ms on "
+              << jobs.getThreadCount() << " threads: "
+              << (result.seconds > 0.0 ? options.ticks / result.seconds : 0.0) << " ticks/s" << std::endl;
+    std::cout << "Peak enemies " << result.peakEnemies << ", shots fired " << result.shots << std::endl;
+    for (int system = 0; system < SYSTEM_COUNT; system++) {
+        std::cout << "  " << SYSTEM_NAMES[system] << ": " << result.systemSeconds[system] * 1000.0 << " ms total, "
+                  << result.systemSeconds[system] * 1000.0 / options.ticks << " ms/tick" << std::endl;
+    }
+    std::cout << "Tick time: ";
+    printTickBudget(result);
+    jobs.printStats();
+    return 0;
+}
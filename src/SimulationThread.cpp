@@ -0,0 +1,70 @@
+#include "SimulationThread.h"
+#include <iostream>
+
+SimulationThread::SimulationThread()
+    : pending(false),
+      running(false),
+      stopping(false),
+      lastJobSeconds(0.0),
+      totalJobSeconds(0.0),
+      totalWaitSeconds(0.0),
+      jobCount(0) {
+    worker = std::thread(&SimulationThread::run, this);
+}
+
+SimulationThread::~SimulationThread() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void SimulationThread::launch(std::function<void()> newJob) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = std::move(newJob);
+        pending = true;
+        running = true;
+    }
+    wake.notify_one();
+}
+
+void SimulationThread::wait() {
+    if (!pending) return;
+    Clock::time_point start = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return !running; });
+    pending = false;
+    totalWaitSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void SimulationThread::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return running || stopping; });
+        if (!running) return;  // stopping with nothing left to do
+
+        std::function<void()> current = std::move(job);
+        lock.unlock();
+        Clock::time_point start = Clock::now();
+        current();
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        lock.lock();
+
+        lastJobSeconds = seconds;
+        totalJobSeconds += seconds;
+        jobCount++;
+        running = false;
+        finished.notify_one();
+    }
+}
+
+void SimulationThread::printStats() const {
+    if (jobCount == 0) return;
+    std::cout << "Simulation thread: " << jobCount << " frames, " << totalJobSeconds * 1000.0 / jobCount
+              << " ms/frame simulating (last " << lastJobSeconds * 1000.0 << " ms), main thread waited "
+              << totalWaitSeconds * 1000.0 / jobCount << " ms/frame" << std::endl;
+}
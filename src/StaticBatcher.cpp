@@ -0,0 +1,225 @@
+#include "StaticBatcher.h"
+#include "Lighting.h"
+#include "Texture.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+bool StaticBatcher::BatchKey::operator<(const BatchKey& other) const {
+    if (texture != other.texture) return std::less<Texture*>()(texture, other.texture);
+    if (cellX != other.cellX) return cellX < other.cellX;
+    return cellZ < other.cellZ;
+}
+
+StaticBatcher::Batch::~Batch() {
+    if (colorBuffer != 0) glDeleteBuffers(1, &colorBuffer);
+}
+
+StaticBatcher::StaticBatcher() : lastDrawCalls(0), lastOccludedShapes(0) {
+}
+
+StaticBatcher::BatchKey StaticBatcher::keyFor(const Shape& shape) {
+    // Cells are anchored at the world origin so a shape's key doesn't depend on its neighbours
+    Vector3 pos = shape.getPosition();
+    BatchKey key;
+    key.texture = shape.getActiveTexture();
+    key.cellX = static_cast<int>(std::floor(pos.x / CELL_SIZE));
+    key.cellZ = static_cast<int>(std::floor(pos.z / CELL_SIZE));
+    return key;
+}
+
+void StaticBatcher::build(const std::vector<std::shared_ptr<Shape>>& shapes) {
+    batches.clear();
+    records.clear();
+    update(shapes);
+
+    std::cout << "StaticBatcher initialized: " << shapes.size() << " shapes in "
+              << batches.size() << " batches" << std::endl;
+}
+
+int StaticBatcher::update(const std::vector<std::shared_ptr<Shape>>& shapes) {
+    // Shapes are only ever appended; anything else means the indices are stale
+    if (shapes.size() < records.size()) {
+        batches.clear();
+        records.clear();
+    }
+
+    for (size_t i = 0; i < shapes.size(); i++) {
+        int index = static_cast<int>(i);
+        const Shape* shape = shapes[i].get();
+
+        if (i >= records.size()) {
+            ShapeRecord record;
+            record.key = shape ? keyFor(*shape) : BatchKey{nullptr, 0, 0};
+            record.revision = shape ? shape->getRevision() : 0;
+            records.push_back(record);
+            if (shape) addToBatch(index, record.key);
+            continue;
+        }
+
+        ShapeRecord& record = records[i];
+        if (!shape || shape->getRevision() == record.revision) continue;
+
+        // Edited: the old batch always needs rebuilding, and the shape may have
+        // moved to another cell or changed texture
+        BatchKey key = keyFor(*shape);
+        removeFromBatch(index, record.key);
+        addToBatch(index, key);
+        record.key = key;
+        record.revision = shape->getRevision();
+    }
+
+    int rebuilt = 0;
+    for (auto it = batches.begin(); it != batches.end();) {
+        Batch& batch = *it->second;
+        if (batch.members.empty()) {
+            it = batches.erase(it);
+            continue;
+        }
+        if (batch.dirty) {
+            rebuildBatch(batch, shapes);
+            rebuilt++;
+        }
+        ++it;
+    }
+    return rebuilt;
+}
+
+void StaticBatcher::addToBatch(int shapeIndex, const BatchKey& key) {
+    std::unique_ptr<Batch>& batch = batches[key];
+    if (!batch) batch = std::make_unique<Batch>();
+    batch->members.push_back(shapeIndex);
+    batch->dirty = true;
+}
+
+void StaticBatcher::removeFromBatch(int shapeIndex, const BatchKey& key) {
+    auto it = batches.find(key);
+    if (it == batches.end()) return;
+    std::vector<int>& members = it->second->members;
+    members.erase(std::remove(members.begin(), members.end(), shapeIndex), members.end());
+    it->second->dirty = true;
+}
+
+void StaticBatcher::rebuildBatch(Batch& batch, const std::vector<std::shared_ptr<Shape>>& shapes) {
+    std::vector<Vector3> positions, normals, texCoords;
+    std::vector<GLubyte> colors;
+    std::vector<int> indices;
+
+    std::vector<Vector3> shapePositions, shapeNormals, shapeTexCoords;
+    std::vector<Color> shapeColors;
+    std::vector<int> shapeIndices;
+
+    for (int index : batch.members) {
+        const Shape& shape = *shapes[index];
+        shape.tessellate(shapePositions, shapeNormals, shapeIndices);
+        shape.tessellateTexCoords(shapeTexCoords);
+        shape.tessellateColors(shapeColors, shapePositions.size());
+
+        // Bake the transform draw() would apply
+        Matrix4 model = shape.getTessellationMatrix();
+        float normalMatrix[9];
+        model.normalMatrix(normalMatrix);
+
+        int baseVertex = static_cast<int>(positions.size());
+        positions.resize(positions.size() + shapePositions.size());
+        if (!shapePositions.empty()) {
+            model.transformPoints(shapePositions.data(), &positions[baseVertex], shapePositions.size());
+        }
+        for (size_t v = 0; v < shapePositions.size(); v++) {
+
+            Vector3 n = v < shapeNormals.size() ? shapeNormals[v] : Vector3(0.0f, 1.0f, 0.0f);
+            Vector3 worldNormal(normalMatrix[0] * n.x + normalMatrix[3] * n.y + normalMatrix[6] * n.z,
+                                normalMatrix[1] * n.x + normalMatrix[4] * n.y + normalMatrix[7] * n.z,
+                                normalMatrix[2] * n.x + normalMatrix[5] * n.y + normalMatrix[8] * n.z);
+            normals.push_back(worldNormal.normalized());
+
+            texCoords.push_back(v < shapeTexCoords.size() ? shapeTexCoords[v] : Vector3());
+
+            const Color& c = shapeColors[v];
+            colors.push_back(static_cast<GLubyte>(std::min(std::max(c.r, 0.0f), 1.0f) * 255.0f + 0.5f));
+            colors.push_back(static_cast<GLubyte>(std::min(std::max(c.g, 0.0f), 1.0f) * 255.0f + 0.5f));
+            colors.push_back(static_cast<GLubyte>(std::min(std::max(c.b, 0.0f), 1.0f) * 255.0f + 0.5f));
+            colors.push_back(255);
+        }
+        for (int idx : shapeIndices) {
+            indices.push_back(baseVertex + idx);
+        }
+    }
+
+    batch.mesh.upload(positions, normals, texCoords, indices);
+
+    if (batch.colorBuffer == 0) glGenBuffers(1, &batch.colorBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, batch.colorBuffer);
+    glBufferData(GL_ARRAY_BUFFER, colors.size(), colors.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    batch.boundsMin = batch.boundsMax = positions.empty() ? Vector3() : positions[0];
+    for (const Vector3& p : positions) {
+        batch.boundsMin = Vector3(std::min(batch.boundsMin.x, p.x), std::min(batch.boundsMin.y, p.y), std::min(batch.boundsMin.z, p.z));
+        batch.boundsMax = Vector3(std::max(batch.boundsMax.x, p.x), std::max(batch.boundsMax.y, p.y), std::max(batch.boundsMax.z, p.z));
+    }
+    batch.dirty = false;
+}
+
+void StaticBatcher::queryOcclusion(const ViewFrustum& frustum, OcclusionCuller& occlusion) const {
+    for (const auto& entry : batches) {
+        const Batch& batch = *entry.second;
+        if (!batch.mesh.isValid() || !frustum.intersectsAABB(batch.boundsMin, batch.boundsMax)) continue;
+        occlusion.query(&batch, batch.boundsMin, batch.boundsMax);
+    }
+}
+
+void StaticBatcher::draw(const ViewFrustum& frustum, int& submitted, int& culled, Lighting* lighting,
+                         OcclusionCuller* occlusion) {
+    lastDrawCalls = 0;
+    lastOccludedShapes = 0;
+    if (lighting && !lighting->beginShading(false)) lighting = nullptr;
+
+    glEnableClientState(GL_COLOR_ARRAY);
+    for (const auto& entry : batches) {
+        const Batch& batch = *entry.second;
+        if (!batch.mesh.isValid()) continue;
+
+        if (!frustum.intersectsAABB(batch.boundsMin, batch.boundsMax)) {
+            culled += static_cast<int>(batch.members.size());
+            continue;
+        }
+        if (occlusion && occlusion->isOccluded(&batch)) {
+            culled += static_cast<int>(batch.members.size());
+            lastOccludedShapes += static_cast<int>(batch.members.size());
+            continue;
+        }
+        submitted += static_cast<int>(batch.members.size());
+
+        Texture* texture = entry.first.texture;
+        if (texture) {
+            glEnable(GL_TEXTURE_2D);
+            glBindTexture(GL_TEXTURE_2D, texture->getID());
+        } else {
+            glDisable(GL_TEXTURE_2D);
+        }
+        if (lighting) lighting->setTextured(texture != nullptr);
+
+        batch.mesh.bind();
+        // Colors live in their own buffer; glColorPointer latches whichever buffer is bound
+        glBindBuffer(GL_ARRAY_BUFFER, batch.colorBuffer);
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+        batch.mesh.drawRange(0, batch.mesh.getIndexCount());
+        batch.mesh.unbind();
+        lastDrawCalls++;
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisable(GL_TEXTURE_2D);
+    if (lighting) lighting->endShading();
+
+    // The current color is undefined after drawing with a color array
+    glColor3f(1.0f, 1.0f, 1.0f);
+}
+
+size_t StaticBatcher::getMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : batches) {
+        bytes += entry.second->mesh.getMemoryBytes() + entry.second->mesh.getVertexCount() * 4;
+    }
+    return bytes;
+}
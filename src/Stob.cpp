@@ -1,8 +1,9 @@
 #define _USE_MATH_DEFINES
 #include "Stob.h"
 #include "Scene.h"
+#include "TextureCache.h"
 #include <cmath>
-#include <gl/glut.h>
+#include <GL/glut.h>
 #include <iostream>
 #define disp(x) std::cout << x << std::endl;
 
@@ -22,8 +23,8 @@ bool Stob::testCollision(Vector3 posBullet, float rBullet) {
     return false;
 }
 
-void Stob::rebindTexture(enum PartType type, char* bmpFile) {
-    if(type < 2) textures[type].rebind(bmpFile);
+void Stob::rebindTexture(enum PartType type, const std::string& bmpFile) {
+    if(type < 2) textures[type] = TextureCache::instance().get(bmpFile);
 }
 
 void Stob::setColor(enum PartType type, Color icolor) {
@@ -42,17 +43,9 @@ void Stob::init() {
     colorSide = Color(0.2f, 0.8f, 0.2f);
     colorCap = Color(0.8f, 0.2f, 0.8f);
 
-    Texture textureside("resources/textures/WoodSide.bmp");
-    textures.push_back(textureside);
-    Texture texturecap("resources/textures/WoodCap.bmp");
-    textures.push_back(texturecap);
-
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, 5, imageweight, imageheight, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    // Shared with the scene's crates and barn through the cache
+    textures.push_back(TextureCache::instance().get("resources/textures/WoodSide.bmp"));
+    textures.push_back(TextureCache::instance().get("resources/textures/WoodCap.bmp"));
 }
 void Stob::move_absolute(float dx, float dy, float dz) {
     // Calculate new position
@@ -129,7 +122,7 @@ void Stob::draw() {
         float theta2 = (2.0f * M_PI * (i + 1)) / slices;
 
         if(textureEnabled) glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, textures[1].getID());
+        glBindTexture(GL_TEXTURE_2D, textures[1]->getID());
         glBegin(GL_TRIANGLES);
         if(textureEnabled) glColor3f(color.r, color.g, color.b);
         else glColor3f(colorCap.r, colorCap.g, colorCap.b);
@@ -154,7 +147,7 @@ void Stob::draw() {
         glVertex3f(cosf(theta2), 1.0f, sinf(theta2));
         glEnd();
 
-        glBindTexture(GL_TEXTURE_2D, textures[0].getID());
+        glBindTexture(GL_TEXTURE_2D, textures[0]->getID());
         glBegin(GL_QUADS);
         if(textureEnabled) glColor3f(color.r, color.g, color.b);
         else glColor3f(colorSide.r, colorSide.g, colorSide.b);
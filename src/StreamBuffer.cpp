@@ -0,0 +1,130 @@
+#include "StreamBuffer.h"
+#include <iostream>
+
+namespace {
+
+// Give up on a fence after this long (ns) per wait call and try again
+constexpr GLuint64 FENCE_TIMEOUT = 1000000;
+
+}  // namespace
+
+StreamBuffer& StreamBuffer::instance() {
+    static StreamBuffer ring;
+    return ring;
+}
+
+StreamBuffer::StreamBuffer()
+    : buffer(0), mapped(nullptr), persistent(false), fences{}, segment(0), segmentUsed(0), lastFrameBytes(0),
+      stallCount(0), overflowCount(0), supported(false), initialized(false), inFrame(false), overflowReported(false) {
+}
+
+StreamBuffer::~StreamBuffer() {
+    if (!supported) return;
+    for (GLsync fence : fences) {
+        if (fence) glDeleteSync(fence);
+    }
+    if (persistent) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    } else {
+        delete[] mapped;
+    }
+    glDeleteBuffers(1, &buffer);
+}
+
+bool StreamBuffer::initialize() {
+    if (initialized) return supported;
+    initialized = true;
+
+    if (!(GLEW_VERSION_3_2 || GLEW_ARB_sync)) {
+        std::cerr << "StreamBuffer: fence sync objects unavailable, dynamic geometry keeps its own uploads"
+                  << std::endl;
+        return false;
+    }
+
+    const size_t totalSize = SEGMENT_SIZE * FRAME_COUNT;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, totalSize, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSize, flags));
+        persistent = mapped != nullptr;
+    }
+    if (!persistent) {
+        // Immutable storage cannot be respecified, so start over with a plain buffer
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glDeleteBuffers(1, &buffer);
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+        mapped = new unsigned char[totalSize];
+        std::cerr << "StreamBuffer: no persistent mapping, falling back to glBufferSubData" << std::endl;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    supported = true;
+    std::cout << "StreamBuffer: " << FRAME_COUNT << " x " << SEGMENT_SIZE / 1024 << " KB ring"
+              << (persistent ? " (persistently mapped)" : "") << std::endl;
+    return true;
+}
+
+void StreamBuffer::beginFrame() {
+    if (!initialize()) return;
+    segment = (segment + 1) % FRAME_COUNT;
+    segmentUsed = 0;
+    inFrame = true;
+
+    // The GPU may still read this segment from FRAME_COUNT frames ago
+    GLsync& fence = fences[segment];
+    if (fence) {
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            stallCount++;
+            do {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void StreamBuffer::endFrame() {
+    if (!inFrame) return;
+    inFrame = false;
+    lastFrameBytes = segmentUsed;
+    fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+StreamBuffer::Allocation StreamBuffer::allocate(size_t bytes) {
+    Allocation allocation;
+    if (!inFrame) return allocation;
+
+    size_t aligned = (segmentUsed + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (aligned + bytes > SEGMENT_SIZE) {
+        // A segment too small for the scene stays too small; the stats keep count
+        overflowCount++;
+        if (!overflowReported) {
+            std::cerr << "StreamBuffer: frame segment full (" << bytes << " more bytes requested)" << std::endl;
+            overflowReported = true;
+        }
+        return allocation;
+    }
+    segmentUsed = aligned + bytes;
+
+    allocation.offset = segment * SEGMENT_SIZE + aligned;
+    allocation.data = mapped + allocation.offset;
+    allocation.buffer = buffer;
+    allocation.size = bytes;
+    return allocation;
+}
+
+void StreamBuffer::commit(const Allocation& allocation) {
+    // Coherent persistent mappings need nothing
+    if (persistent || !allocation) return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferSubData(GL_ARRAY_BUFFER, allocation.offset, allocation.size, allocation.data);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -1,72 +1,103 @@
 #include "Texture.h"
-#include <stdio.h>
-#include <iostream>
-#include <gl/glew.h>
-#include <gl/glut.h>
+#include "TextureCooker.h"
+#include <algorithm>
+#include <filesystem>
 
-unsigned char *Texture::LoadBitmapFile(char *filename, BITMAPINFOHEADER *bitmapInfoHeader)
-{
-    FILE *filePtr;
-    BITMAPFILEHEADER bitmapFileHeader;
-    unsigned char *bitmapImage;
-    int imageIdx = 0;
-    unsigned char tempRGB;
+namespace {
 
-    fopen_s(&filePtr, filename, "rb");
-    if (filePtr == NULL) {
-        std::cerr << "Error in LoadBitmapFile: could not open file " << filename << std::endl;
-        return NULL;
-    }
-    fread(&bitmapFileHeader, sizeof(BITMAPFILEHEADER), 1, filePtr);
-    if (bitmapFileHeader.bfType != BITMAP_ID) {
-        std::cerr << "Error in LoadBitmapFile: the file is not a bitmap file" << std::endl;
-        fclose(filePtr);
-        return NULL;
-    }
+// 8x8 stand-in while loading (grey) or after a failed load (magenta/black checkerboard)
+constexpr int PLACEHOLDER_SIZE = 8;
+
+}  // namespace
+
+Texture::Texture(const std::string& filepath)
+    : ID(0), path(filepath), name(std::filesystem::path(filepath).stem().string()), state(State::LOADING),
+      width(0), height(0), residentBytes(0) {
+}
+
+Texture::~Texture() {
+    if (ID) glDeleteTextures(1, &ID);
+}
 
-    fread(bitmapInfoHeader, sizeof(BITMAPINFOHEADER), 1, filePtr);
-    fseek(filePtr, bitmapFileHeader.bfOffBits, SEEK_SET);
-    bitmapImage = new unsigned char[bitmapInfoHeader->biSizeImage];
-    if (!bitmapImage) {
-        std::cerr << "Error in LoadBitmapFile: memory error" << std::endl;
-        fclose(filePtr);
-        return NULL;
+void Texture::uploadPlaceholder(State placeholderState) {
+    unsigned char texels[PLACEHOLDER_SIZE * PLACEHOLDER_SIZE * 4];
+    for (int y = 0; y < PLACEHOLDER_SIZE; y++) {
+        for (int x = 0; x < PLACEHOLDER_SIZE; x++) {
+            unsigned char* texel = &texels[(y * PLACEHOLDER_SIZE + x) * 4];
+            if (placeholderState == State::MISSING) {
+                bool lit = ((x / 2) + (y / 2)) % 2 == 0;
+                texel[0] = lit ? 255 : 0;
+                texel[1] = 0;
+                texel[2] = lit ? 255 : 0;
+            } else {
+                texel[0] = texel[1] = texel[2] = 160;
+            }
+            texel[3] = 255;
+        }
     }
+    upload(texels, PLACEHOLDER_SIZE, PLACEHOLDER_SIZE);
+    state = placeholderState;
+}
+
+void Texture::upload(const void* pixels, int imageWidth, int imageHeight) {
+    if (!ID) glGenTextures(1, &ID);
+    width = imageWidth;
+    height = imageHeight;
+    state = State::READY;
 
-    fread(bitmapImage, 1, bitmapInfoHeader->biSizeImage, filePtr);
-    if (bitmapImage == NULL) {
-        std::cerr << "Error in LoadBitmapFile: memory error" << std::endl;
-        delete[] bitmapImage;
-        fclose(filePtr);
-        return NULL;
+    // Large enough for any chain; glGenerateMipmap fills what it needs
+    bindWithSampling(1000);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);  // RGBA rows are always 4-byte aligned
+
+    if (GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object) {
+        // Let the driver build the chain on the GPU
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    } else {
+        // OpenGL 1.4 path: levels are regenerated whenever level 0 is specified
+        glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
     }
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    for (size_t imageIdx = 0; imageIdx < bitmapInfoHeader->biSizeImage; imageIdx += 3) {
-        tempRGB = bitmapImage[imageIdx];
-        bitmapImage[imageIdx] = bitmapImage[imageIdx + 2];
-        bitmapImage[imageIdx + 2] = tempRGB;
+    residentBytes = 0;
+    for (int w = width, h = height;; w = std::max(1, w / 2), h = std::max(1, h / 2)) {
+        residentBytes += static_cast<size_t>(w) * h * 4;
+        if (w == 1 && h == 1) break;
     }
-    fclose(filePtr);
-    return bitmapImage;
 }
 
-void Texture::texload(unsigned int textureID, char *filename)
-{
-    BITMAPINFOHEADER bitmapInfoHeader;
-    unsigned char*   bitmapData;
+void Texture::uploadCompressed(const CookedTexture& cooked) {
+    if (!ID) glGenTextures(1, &ID);
+    width = cooked.width;
+    height = cooked.height;
+    state = State::READY;
 
-    bitmapData = LoadBitmapFile(filename, &bitmapInfoHeader);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    GLenum format = cooked.format == CookedTexture::BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+                                                        : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    bindWithSampling(cooked.levelCount);
+    int levelWidth = width, levelHeight = height;
+    for (int level = 0; level < cooked.levelCount; level++) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, format, levelWidth, levelHeight, 0,
+                               static_cast<GLsizei>(cooked.levelSizes[level]), cooked.levels[level]);
+        levelWidth = std::max(1, levelWidth / 2);
+        levelHeight = std::max(1, levelHeight / 2);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    residentBytes = cooked.getDataBytes();
+}
 
-    glTexImage2D(GL_TEXTURE_2D,
-        0,
-        GL_RGB,
-        bitmapInfoHeader.biWidth,
-        bitmapInfoHeader.biHeight,
-        0,
-        GL_RGB,
-        GL_UNSIGNED_BYTE,
-        bitmapData);
-}
\ No newline at end of file
+void Texture::bindWithSampling(int levelCount) {
+    glBindTexture(GL_TEXTURE_2D, ID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    // A cooked chain may stop short of 1x1; sampling past it would leave the texture incomplete
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    if (GLEW_EXT_texture_filter_anisotropic) {
+        GLfloat maxAnisotropy = 1.0f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(maxAnisotropy, MAX_ANISOTROPY));
+    }
+}
@@ -0,0 +1,219 @@
+#include "TextureCache.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+TextureCache::TextureCache()
+    : generation(0), stopping(false), compressionSupported(false), pixelBuffer(0), pixelBufferChecked(false),
+      uploadBudget(DEFAULT_UPLOAD_BUDGET), pendingCount(0), uploadedLastFrame(0) {
+}
+
+TextureCache::~TextureCache() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        requestReady.notify_all();
+        worker.join();
+    }
+    if (pixelBuffer) glDeleteBuffers(1, &pixelBuffer);
+}
+
+Texture* TextureCache::get(const std::string& filepath) {
+    // "a/../b.bmp" and "b.bmp" name the same file
+    std::string key = std::filesystem::path(filepath).lexically_normal().generic_string();
+    auto it = textures.find(key);
+    if (it != textures.end()) return it->second.get();
+
+    std::unique_ptr<Texture> texture(new Texture(key));
+    texture->uploadPlaceholder(Texture::State::LOADING);
+    Texture* result = texture.get();
+    textures.emplace(key, std::move(texture));
+
+    if (!worker.joinable()) {
+        compressionSupported = GLEW_EXT_texture_compression_s3tc != 0;
+        if (!compressionSupported) {
+            std::cerr << "TextureCache: no S3TC support, textures stay uncompressed" << std::endl;
+        }
+        worker = std::thread(&TextureCache::workerLoop, this);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.emplace_back(result, generation);
+    }
+    requestReady.notify_one();
+    pendingCount++;
+    return result;
+}
+
+void TextureCache::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        requestReady.wait(lock, [this] { return stopping || !requests.empty(); });
+        if (stopping) return;
+
+        Decoded item;
+        item.texture = requests.front().first;
+        item.generation = requests.front().second;
+        requests.pop_front();
+        std::string path = item.texture->getPath();  // immutable, but the texture may die once unlocked
+
+        // Disk reads and decoding happen without the lock
+        lock.unlock();
+        item.ok = (compressionSupported && loadCooked(path, item)) || ImageIO::load(path, item.image);
+        lock.lock();
+
+        decoded.push_back(std::move(item));
+        decodeReady.notify_all();
+    }
+}
+
+bool TextureCache::loadCooked(const std::string& path, Decoded& item) {
+    std::string cookedPath = TextureCooker::cookedPathFor(path);
+    if (!TextureCooker::isUpToDate(path, cookedPath)) {
+        Image image;
+        if (!ImageIO::load(path, image)) return false;
+        if (!TextureCooker::cook(image, cookedPath)) {
+            // E.g. a read-only install: use the image already decoded
+            item.image = std::move(image);
+            return true;
+        }
+    }
+
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    if (!file->open(cookedPath) || !TextureCooker::parse(file->data(), file->size(), item.cooked)) {
+        std::cerr << "TextureCache: ignoring " << cookedPath << ", loading the source instead" << std::endl;
+        return false;
+    }
+    // Fault the pages in here rather than during the upload on the main thread
+    file->prefetch();
+    item.file = std::move(file);
+    return true;
+}
+
+void TextureCache::update() {
+    uploadedLastFrame = 0;
+    if (pendingCount > 0) uploadDecoded(uploadBudget);
+}
+
+void TextureCache::finishLoading() {
+    while (pendingCount > 0) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            decodeReady.wait(lock, [this] { return !decoded.empty(); });
+        }
+        uploadDecoded(SIZE_MAX);
+    }
+}
+
+int TextureCache::uploadDecoded(size_t budget) {
+    std::deque<Decoded> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t bytes = 0;
+        while (!decoded.empty()) {
+            size_t size = decoded.front().getUploadBytes();
+            if (!ready.empty() && bytes + size > budget) break;
+            bytes += size;
+            ready.push_back(std::move(decoded.front()));
+            decoded.pop_front();
+        }
+    }
+
+    int uploaded = 0;
+    for (Decoded& item : ready) {
+        // Textures dropped by clear() after they were queued
+        if (item.generation != generation) continue;
+        upload(item);
+        pendingCount--;
+        uploaded++;
+    }
+    return uploaded;
+}
+
+void TextureCache::upload(Decoded& item) {
+    Texture* texture = item.texture;
+    if (!item.ok) {
+        texture->uploadPlaceholder(Texture::State::MISSING);
+        std::cerr << "TextureCache: using a placeholder for " << texture->getPath() << std::endl;
+        return;
+    }
+
+    if (item.file) {
+        texture->uploadCompressed(item.cooked);
+        uploadedLastFrame += item.cooked.getDataBytes();
+        std::cout << "TextureCache: loaded " << texture->getPath() << " ("
+                  << (item.cooked.format == CookedTexture::BC1 ? "BC1" : "BC3") << " " << item.cooked.width << "x"
+                  << item.cooked.height << ", " << texture->getResidentBytes() / 1024 << " KB with mipmaps)"
+                  << std::endl;
+        return;
+    }
+
+    if (!pixelBufferChecked) {
+        pixelBufferChecked = true;
+        if (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object) {
+            glGenBuffers(1, &pixelBuffer);
+        } else {
+            std::cerr << "TextureCache: no pixel buffer objects, uploading straight from client memory" << std::endl;
+        }
+    }
+
+    const Image& image = item.image;
+    size_t size = image.pixels.size();
+    bool viaBuffer = false;
+    if (pixelBuffer) {
+        // Orphan last upload's storage so mapping never waits for the GPU to finish reading it
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        void* staging = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+        if (staging) {
+            std::memcpy(staging, image.pixels.data(), size);
+            viaBuffer = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+        }
+        if (viaBuffer) texture->upload(nullptr, image.width, image.height);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    if (!viaBuffer) texture->upload(image.pixels.data(), image.width, image.height);
+
+    uploadedLastFrame += size;
+    std::cout << "TextureCache: loaded " << texture->getPath() << " (" << image.width << "x" << image.height
+              << ", " << texture->getResidentBytes() / 1024 << " KB with mipmaps)" << std::endl;
+}
+
+void TextureCache::clear() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.clear();
+        decoded.clear();
+        // Anything the worker is decoding right now comes back stale
+        generation++;
+    }
+    pendingCount = 0;
+    textures.clear();
+}
+
+void TextureCache::release() {
+    clear();
+    if (pixelBuffer) glDeleteBuffers(1, &pixelBuffer);
+    pixelBuffer = 0;
+    pixelBufferChecked = false;
+}
+
+size_t TextureCache::getResidentBytes() const {
+    size_t total = 0;
+    for (const auto& entry : textures) total += entry.second->getResidentBytes();
+    return total;
+}
+
+void TextureCache::printStats() const {
+    std::cout << "Textures: " << textures.size() << " resident (" << pendingCount << " still loading), "
+              << getResidentBytes() / 1024.0f << " KB, " << uploadedLastFrame / 1024.0f
+              << " KB uploaded last frame (budget " << uploadBudget / 1024 << " KB)" << std::endl;
+}
@@ -0,0 +1,301 @@
+#include "TextureCooker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const char MAGIC[4] = {'C', 'T', 'E', 'X'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 24;
+constexpr size_t LEVEL_ENTRY_SIZE = 8;
+
+typedef unsigned char Block[16][4];  // 4x4 RGBA texels
+
+size_t levelBytes(uint32_t format, int width, int height) {
+    size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * (format == CookedTexture::BC1 ? 8 : 16);
+}
+
+void writeU32(std::vector<unsigned char>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+}
+
+uint32_t readU32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Next mip level by 2x2 box filter; odd edges repeat the last texel
+Image downsample(const Image& source) {
+    Image result;
+    result.width = std::max(1, source.width / 2);
+    result.height = std::max(1, source.height / 2);
+    result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+    for (int y = 0; y < result.height; y++) {
+        int y0 = std::min(y * 2, source.height - 1), y1 = std::min(y * 2 + 1, source.height - 1);
+        for (int x = 0; x < result.width; x++) {
+            int x0 = std::min(x * 2, source.width - 1), x1 = std::min(x * 2 + 1, source.width - 1);
+            for (int c = 0; c < 4; c++) {
+                int sum = source.pixels[(static_cast<size_t>(y0) * source.width + x0) * 4 + c] +
+                          source.pixels[(static_cast<size_t>(y0) * source.width + x1) * 4 + c] +
+                          source.pixels[(static_cast<size_t>(y1) * source.width + x0) * 4 + c] +
+                          source.pixels[(static_cast<size_t>(y1) * source.width + x1) * 4 + c];
+                result.pixels[(static_cast<size_t>(y) * result.width + x) * 4 + c] =
+                    static_cast<unsigned char>((sum + 2) / 4);
+            }
+        }
+    }
+    return result;
+}
+
+void fetchBlock(const Image& image, int blockX, int blockY, Block block) {
+    for (int i = 0; i < 16; i++) {
+        int x = std::min(blockX * 4 + i % 4, image.width - 1);
+        int y = std::min(blockY * 4 + i / 4, image.height - 1);
+        std::memcpy(block[i], &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4], 4);
+    }
+}
+
+uint16_t pack565(const float color[3]) {
+    int r = static_cast<int>(std::lround(std::min(std::max(color[0], 0.0f), 255.0f) * 31.0f / 255.0f));
+    int g = static_cast<int>(std::lround(std::min(std::max(color[1], 0.0f), 255.0f) * 63.0f / 255.0f));
+    int b = static_cast<int>(std::lround(std::min(std::max(color[2], 0.0f), 255.0f) * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpack565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// BC1 color block: endpoints at the extremes of the block's principal axis
+// (a few power iterations on the covariance), inset slightly, then the
+// nearest of the four palette entries per texel
+void encodeColorBlock(const Block block, unsigned char* out) {
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) mean[c] += block[i][c] / 16.0f;
+    }
+    float cov[6] = {0, 0, 0, 0, 0, 0};  // rr rg rb gg gb bb
+    for (int i = 0; i < 16; i++) {
+        float r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    for (int iteration = 0; iteration < 4; iteration++) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float length = std::max(std::max(std::fabs(x), std::fabs(y)), std::fabs(z));
+        if (length < 1e-4f) break;  // flat block: keep the grey axis
+        axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+    }
+
+    float minT = 1e30f, maxT = -1e30f;
+    for (int i = 0; i < 16; i++) {
+        float t = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] +
+                  (block[i][2] - mean[2]) * axis[2];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    // Pull the endpoints in by 1/16 of the range; the interpolated entries then cover the ends better
+    float inset = (maxT - minT) / 16.0f;
+    minT += inset;
+    maxT -= inset;
+    float high[3], low[3];
+    for (int c = 0; c < 3; c++) {
+        high[c] = mean[c] + axis[c] * maxT;
+        low[c] = mean[c] + axis[c] * minT;
+    }
+
+    uint16_t color0 = pack565(high), color1 = pack565(low);
+    if (color0 < color1) std::swap(color0, color1);  // color0 > color1 selects the 4-color mode
+    out[0] = color0 & 0xFF; out[1] = color0 >> 8;
+    out[2] = color1 & 0xFF; out[3] = color1 >> 8;
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        unpack565(color0, palette[0]);
+        unpack565(color1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestError = 1 << 30;
+            for (int p = 0; p < 4; p++) {
+                int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= static_cast<uint32_t>(best) << (i * 2);
+        }
+    }
+    for (int i = 0; i < 4; i++) out[4 + i] = static_cast<unsigned char>(indices >> (i * 8));
+}
+
+// BC3 alpha block: min/max endpoints with the 8-entry interpolated palette
+void encodeAlphaBlock(const Block block, unsigned char* out) {
+    int alpha0 = 0, alpha1 = 255;
+    for (int i = 0; i < 16; i++) {
+        alpha0 = std::max(alpha0, static_cast<int>(block[i][3]));
+        alpha1 = std::min(alpha1, static_cast<int>(block[i][3]));
+    }
+    out[0] = static_cast<unsigned char>(alpha0);
+    out[1] = static_cast<unsigned char>(alpha1);
+
+    uint64_t indices = 0;
+    if (alpha0 != alpha1) {
+        int palette[8] = {alpha0, alpha1};
+        for (int p = 2; p < 8; p++) palette[p] = ((8 - p) * alpha0 + (p - 1) * alpha1) / 7;
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestError = 256;
+            for (int p = 0; p < 8; p++) {
+                int error = std::abs(block[i][3] - palette[p]);
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+}
+
+std::vector<unsigned char> compressLevel(const Image& image, uint32_t format) {
+    std::vector<unsigned char> data(levelBytes(format, image.width, image.height));
+    unsigned char* out = data.data();
+    Block block;
+    for (int blockY = 0; blockY < (image.height + 3) / 4; blockY++) {
+        for (int blockX = 0; blockX < (image.width + 3) / 4; blockX++) {
+            fetchBlock(image, blockX, blockY, block);
+            if (format == CookedTexture::BC3) {
+                encodeAlphaBlock(block, out);
+                out += 8;
+            }
+            encodeColorBlock(block, out);
+            out += 8;
+        }
+    }
+    return data;
+}
+
+}  // namespace
+
+size_t CookedTexture::getDataBytes() const {
+    size_t total = 0;
+    for (int i = 0; i < levelCount; i++) total += levelSizes[i];
+    return total;
+}
+
+namespace TextureCooker {
+
+std::string cookedPathFor(const std::string& sourcePath) {
+    return std::filesystem::path(sourcePath).replace_extension(".ctex").generic_string();
+}
+
+bool isUpToDate(const std::string& sourcePath, const std::string& cookedPath) {
+    std::error_code error;
+    auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+    if (error) return false;
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+    // A cooked file without its source (e.g. a shipped build) is still usable
+    return error || cookedTime >= sourceTime;
+}
+
+bool cook(const Image& image, const std::string& cookedPath) {
+    bool opaque = true;
+    for (size_t i = 3; i < image.pixels.size(); i += 4) {
+        if (image.pixels[i] != 255) { opaque = false; break; }
+    }
+    uint32_t format = opaque ? CookedTexture::BC1 : CookedTexture::BC3;
+
+    std::vector<std::vector<unsigned char>> levels;
+    Image level = image;
+    while (static_cast<int>(levels.size()) < CookedTexture::MAX_LEVELS) {
+        levels.push_back(compressLevel(level, format));
+        if (level.width == 1 && level.height == 1) break;
+        level = downsample(level);
+    }
+
+    std::vector<unsigned char> header;
+    header.insert(header.end(), MAGIC, MAGIC + 4);
+    writeU32(header, VERSION);
+    writeU32(header, format);
+    writeU32(header, image.width);
+    writeU32(header, image.height);
+    writeU32(header, static_cast<uint32_t>(levels.size()));
+    uint32_t offset = static_cast<uint32_t>(HEADER_SIZE + LEVEL_ENTRY_SIZE * levels.size());
+    for (const auto& data : levels) {
+        writeU32(header, offset);
+        writeU32(header, static_cast<uint32_t>(data.size()));
+        offset += static_cast<uint32_t>(data.size());
+    }
+
+    std::string temporaryPath = cookedPath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "TextureCooker: cannot write " << temporaryPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        for (const auto& data : levels) file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!file) {
+            std::cerr << "TextureCooker: write to " << temporaryPath << " failed" << std::endl;
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, cookedPath, error);
+    if (error) {
+        std::cerr << "TextureCooker: cannot replace " << cookedPath << " (" << error.message() << ")" << std::endl;
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    std::cout << "TextureCooker: cooked " << cookedPath << " (" << (opaque ? "BC1" : "BC3") << ", "
+              << levels.size() << " levels, " << offset / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+bool parse(const unsigned char* data, size_t size, CookedTexture& texture) {
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, 4) != 0 || readU32(data + 4) != VERSION) {
+        std::cerr << "TextureCooker: not a cooked texture (or an older version)" << std::endl;
+        return false;
+    }
+    texture.format = readU32(data + 8);
+    texture.width = static_cast<int>(readU32(data + 12));
+    texture.height = static_cast<int>(readU32(data + 16));
+    texture.levelCount = static_cast<int>(readU32(data + 20));
+    if ((texture.format != CookedTexture::BC1 && texture.format != CookedTexture::BC3) || texture.width <= 0 ||
+        texture.height <= 0 || texture.levelCount <= 0 || texture.levelCount > CookedTexture::MAX_LEVELS ||
+        size < HEADER_SIZE + LEVEL_ENTRY_SIZE * texture.levelCount) {
+        std::cerr << "TextureCooker: corrupt cooked texture header" << std::endl;
+        return false;
+    }
+
+    int width = texture.width, height = texture.height;
+    for (int i = 0; i < texture.levelCount; i++) {
+        const unsigned char* entry = data + HEADER_SIZE + LEVEL_ENTRY_SIZE * i;
+        size_t offset = readU32(entry), levelSize = readU32(entry + 4);
+        if (levelSize != levelBytes(texture.format, width, height) || offset + levelSize > size) {
+            std::cerr << "TextureCooker: cooked texture level " << i << " is truncated" << std::endl;
+            return false;
+        }
+        texture.levels[i] = data + offset;
+        texture.levelSizes[i] = levelSize;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return true;
+}
+
+}  // namespace TextureCooker
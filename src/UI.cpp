@@ -1,5 +1,8 @@
-﻿#include "ui.h"
+﻿#include "UI.h"
 #include "Shapes.h"  // Include Shape class definition
+#include "Texture.h"
+#include "HudBatch.h"
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
@@ -29,9 +32,6 @@ void UI::drawCross() const {
     glPushMatrix();
     glLoadIdentity();
 
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_LIGHTING);
-
     glColor3f(1.0f, 1.0f, 1.0f);
     glLineWidth(2.0f);
     glBegin(GL_LINES);
@@ -43,9 +43,6 @@ void UI::drawCross() const {
     glVertex2f(crossX, crossY + crossHalfSize);
     glEnd();
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
@@ -78,9 +75,6 @@ void UI::drawEditorUI() const {
     glPushMatrix();
     glLoadIdentity();
 
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_LIGHTING);
-
     // Draw editor background
     glColor4f(0.1f, 0.1f, 0.1f, 0.8f);
     glBegin(GL_QUADS);
@@ -91,42 +85,19 @@ void UI::drawEditorUI() const {
     glEnd();
 
     // Draw title
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawText("Edit Mode", 20, 30, 1.5f);
+    const Color white(1.0f, 1.0f, 1.0f);
+    drawText("Edit Mode", 20, 30, white, 1.5f);
 
     // Draw object list box
     drawRect(20, 60, 300, 400, 0.2f, 0.2f, 0.2f, 0.7f);
 
-    // Draw object list
-    glColor3f(1.0f, 1.0f, 1.0f);
+    // Draw object list (labels are built in updateObjectList(); rows below
+    // the window are never visible, so they are skipped)
     float y_pos = 80;
-    for (size_t i = 0; i < sceneObjects.size(); ++i) {
-        std::string objName = "Object " + std::to_string(i) + ": ";
-        
-        if (auto cube = std::dynamic_pointer_cast<Cube>(sceneObjects[i])) {
-            objName += "Cube";
-        } else if (auto sphere = std::dynamic_pointer_cast<Sphere>(sceneObjects[i])) {
-            objName += "Sphere";
-        } else if (auto cylinder = std::dynamic_pointer_cast<Cylinder>(sceneObjects[i])) {
-            objName += "Cylinder";
-        } else if (auto cone = std::dynamic_pointer_cast<Cone>(sceneObjects[i])) {
-            objName += "Cone";
-        } else if (auto prism = std::dynamic_pointer_cast<Prism>(sceneObjects[i])) {
-            objName += "Prism";
-        } else if (auto frustum = std::dynamic_pointer_cast<Frustum>(sceneObjects[i])) {
-            objName += "Frustum";
-        } else {
-            objName += "Unknown";
-        }
-
-        // Highlight selected object
-        if (static_cast<int>(i) == selectedObjectIndex) {
-            glColor3f(0.0f, 1.0f, 1.0f); // Cyan when selected
-        } else {
-            glColor3f(1.0f, 1.0f, 1.0f); // Default white
-        }
-
-        drawText(objName, 40, y_pos);
+    for (size_t i = 0; i < objectLabels.size() && y_pos < windowHeight + 25; ++i) {
+        // Highlight selected object: cyan when selected, white otherwise
+        Color rowColor = static_cast<int>(i) == selectedObjectIndex ? Color(0.0f, 1.0f, 1.0f) : white;
+        drawText(objectLabels[i], 40, y_pos, rowColor);
         y_pos += 25;
     }
 
@@ -137,66 +108,47 @@ void UI::drawEditorUI() const {
         // Draw details box
         drawRect(340, 60, 400, 300, 0.2f, 0.2f, 0.2f, 0.7f);
         
-        glColor3f(1.0f, 1.0f, 1.0f);
-        drawText("Object Details", 360, 80, 1.2f);
+        drawText("Object Details", 360, 80, white, 1.2f);
         
         // Show object type and position
-        std::string typeText = "Type: ";
-        if (std::dynamic_pointer_cast<Cube>(obj)) {
-            typeText += "Cube";
-        } else if (std::dynamic_pointer_cast<Sphere>(obj)) {
-            typeText += "Sphere";
-        } else if (std::dynamic_pointer_cast<Cylinder>(obj)) {
-            typeText += "Cylinder";
-        } else if (std::dynamic_pointer_cast<Cone>(obj)) {
-            typeText += "Cone";
-        } else if (std::dynamic_pointer_cast<Prism>(obj)) {
-            typeText += "Prism";
-        } else if (std::dynamic_pointer_cast<Frustum>(obj)) {
-            typeText += "Frustum";
-        } else {
-            typeText += "Unknown";
-        }
-        
-        drawText(typeText, 360, 110);
+        std::string typeText = std::string("Type: ") + shapeTypeName(*obj);
+        drawText(typeText, 360, 110, white);
         
         Vector3 pos = obj->getPosition();
         std::string posText = "Position: (" + 
                              std::to_string(pos.x).substr(0, 4) + ", " +
                              std::to_string(pos.y).substr(0, 4) + ", " +
                              std::to_string(pos.z).substr(0, 4) + ")";
-        drawText(posText, 360, 135);
+        drawText(posText, 360, 135, white);
         
         Vector3 size = obj->getSize();
         std::string sizeText = "Size: (" + 
                               std::to_string(size.x).substr(0, 4) + ", " +
                               std::to_string(size.y).substr(0, 4) + ", " +
                               std::to_string(size.z).substr(0, 4) + ")";
-        drawText(sizeText, 360, 160);
+        drawText(sizeText, 360, 160, white);
         
         // Texture name display
-        glColor3f(1.0f, 1.0f, 1.0f);
-        drawText("Texture: ", 360, 185);
+        drawText("Texture: ", 360, 185, white);
         std::string textureText = currentTextureName.empty() ? "No texture" : currentTextureName;
-        drawText(textureText, 420, 185);
+        drawText(textureText, 420, 185, white);
         
         // Material editing area
-        glColor3f(1.0f, 1.0f, 1.0f);
-        drawText("Material Editing", 360, 210, 1.2f);
+        drawText("Material Editing", 360, 210, white, 1.2f);
         
         // Material parameters with clickable labels
         float materialY = 240;
-        drawText("R:", 360, materialY);
+        drawText("R:", 360, materialY, white);
         std::string rText = std::to_string(currentColor.r).substr(0, 4);
-        drawText(rText, 450, materialY);
+        drawText(rText, 450, materialY, white);
         
-        drawText("G:", 360, materialY + 25);
+        drawText("G:", 360, materialY + 25, white);
         std::string gText = std::to_string(currentColor.g).substr(0, 4);
-        drawText(gText, 450, materialY + 25);
+        drawText(gText, 450, materialY + 25, white);
         
-        drawText("B:", 360, materialY + 50);
+        drawText("B:", 360, materialY + 50, white);
         std::string bText = std::to_string(currentColor.b).substr(0, 4);
-        drawText(bText, 450, materialY + 50);
+        drawText(bText, 450, materialY + 50, white);
     }
 
     // Draw active slider if one is selected
@@ -209,9 +161,6 @@ void UI::drawEditorUI() const {
     drawButton("Apply Texture", 470, 380, 120, 30);
     drawButton("Exit Edit", 600, 380, 120, 30);
 
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
@@ -299,6 +248,22 @@ void UI::handleMouseMotion(int x, int y) {
 
 void UI::updateObjectList(const std::vector<std::shared_ptr<Shape>>& objects) {
     sceneObjects = objects;
+
+    objectLabels.clear();
+    objectLabels.reserve(sceneObjects.size());
+    for (size_t i = 0; i < sceneObjects.size(); ++i) {
+        objectLabels.push_back("Object " + std::to_string(i) + ": " + shapeTypeName(*sceneObjects[i]));
+    }
+}
+
+const char* UI::shapeTypeName(const Shape& shape) {
+    if (dynamic_cast<const Cube*>(&shape)) return "Cube";
+    if (dynamic_cast<const Sphere*>(&shape)) return "Sphere";
+    if (dynamic_cast<const Cylinder*>(&shape)) return "Cylinder";
+    if (dynamic_cast<const Cone*>(&shape)) return "Cone";
+    if (dynamic_cast<const Prism*>(&shape)) return "Prism";
+    if (dynamic_cast<const Frustum*>(&shape)) return "Frustum";
+    return "Unknown";
 }
 
 void UI::selectObject(int index) {
@@ -310,7 +275,8 @@ void UI::selectObject(int index) {
         currentColor = obj->getColor();
         
         // 获取当前对象的纹理名称
-        currentTextureName = obj->getTextureName(Shape::BOTH);
+        Texture* texture = obj->getBoundTexture(Shape::BOTH);
+        currentTextureName = texture ? texture->getName() : "";
         
         std::cout << "Selected object: " << index << std::endl;
         
@@ -335,20 +301,13 @@ void UI::applyTextureChanges() {
     }
 }
 
-void UI::drawText(const std::string& text, float x, float y, float scale) const {
-    glRasterPos2f(x, y);
-    
-    // Apply scaling
-    glPushMatrix();
-    glTranslatef(x, y, 0);
-    glScalef(scale, scale, 1);
-    glTranslatef(-x, -y, 0);
-    
-    for (char c : text) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, c);
-    }
-    
-    glPopMatrix();
+void UI::drawText(const std::string& text, float x, float y, const Color& color, float scale) const {
+    // The editor lays out in a top-left origin window of windowWidth x windowHeight;
+    // the HUD batch works in bottom-left viewport pixels and draws all text at frame end
+    HudBatch& hud = HudBatch::instance();
+    float hudX = x * hud.getViewportWidth() / windowWidth;
+    float hudY = (windowHeight - y) * hud.getViewportHeight() / windowHeight;
+    hud.addText(hudX, hudY, GLUT_BITMAP_HELVETICA_12, text, color, scale);
 }
 
 void UI::drawRect(float x, float y, float width, float height, float r, float g, float b, float a) const {
@@ -383,10 +342,9 @@ void UI::drawButton(const std::string& text, float x, float y, float width, floa
     glLineWidth(1.0f);
 
     // Button text
-    glColor3f(1.0f, 1.0f, 1.0f);
     float textX = x + (width - text.length() * 8) / 2;  // Estimate text width
     float textY = y + height / 2 + 5;  // Center vertically
-    drawText(text, textX, textY);
+    drawText(text, textX, textY, Color(1.0f, 1.0f, 1.0f));
 }
 
 void UI::drawSlider(float x, float y, float width, float height, float value, float min, float max, const std::string& label) const {
@@ -415,8 +373,7 @@ void UI::drawSlider(float x, float y, float width, float height, float value, fl
     glEnd();
 
     // Draw label and current value
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawText(label + ": " + std::to_string(value).substr(0, 4), x, y - 10);
+    drawText(label + ": " + std::to_string(value).substr(0, 4), x, y - 10, Color(1.0f, 1.0f, 1.0f));
 }
 
 void UI::handleSliderClick(int button, int state, int x, int y) {
@@ -449,7 +406,7 @@ void UI::handleSliderClick(int button, int state, int x, int y) {
 
 void UI::updateSliderValue(float x) {
     float normalizedX = (x - sliderX) / sliderWidth;
-    normalizedX = max(0.0f, min(1.0f, normalizedX)); // Clamp between 0 and 1
+    normalizedX = std::clamp(normalizedX, 0.0f, 1.0f);
     sliderValue = sliderMin + normalizedX * (sliderMax - sliderMin);
 }
 
@@ -0,0 +1,58 @@
+#include "ViewFrustum.h"
+
+ViewFrustum::ViewFrustum() {
+    // Until extract() runs every plane accepts everything
+    for (Plane& plane : planes) {
+        plane.normal = Vector3();
+        plane.d = 1.0f;
+    }
+}
+
+void ViewFrustum::extract(const CameraView& camera) {
+    extract(camera.viewProjection);
+    cameraPosition = camera.position;
+}
+
+void ViewFrustum::extract(const Matrix4& viewProjection) {
+    // Gribb/Hartmann: each plane is the last row of the clip matrix plus or minus another row
+    const Matrix4& m = viewProjection;
+    const float signs[2] = {1.0f, -1.0f};
+    for (int i = 0; i < 6; i++) {
+        int row = i / 2;        // left/right, bottom/top, near/far
+        float sign = signs[i % 2];
+        Vector3 normal(m.at(3, 0) + sign * m.at(row, 0),
+                       m.at(3, 1) + sign * m.at(row, 1),
+                       m.at(3, 2) + sign * m.at(row, 2));
+        float d = m.at(3, 3) + sign * m.at(row, 3);
+
+        float length = normal.length();
+        if (length > 1e-9f) {
+            normal = normal / length;
+            d /= length;
+        }
+        planes[i].normal = normal;
+        planes[i].d = d;
+    }
+}
+
+bool ViewFrustum::intersectsSphere(const Vector3& center, float radius) const {
+    for (const Plane& plane : planes) {
+        if (plane.normal.dot(center) + plane.d < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ViewFrustum::intersectsAABB(const Vector3& min, const Vector3& max) const {
+    for (const Plane& plane : planes) {
+        // Corner furthest along the plane normal; if even that is outside, the box is
+        Vector3 corner(plane.normal.x >= 0.0f ? max.x : min.x,
+                       plane.normal.y >= 0.0f ? max.y : min.y,
+                       plane.normal.z >= 0.0f ? max.z : min.z);
+        if (plane.normal.dot(corner) + plane.d < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
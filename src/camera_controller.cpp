@@ -3,8 +3,10 @@
 #include <GL/glut.h>
 #include <cmath>
 CameraController::CameraController(int windowWidth, int windowHeight)
-    : cameraDistance(10.0f), cameraAngle(0.0f), playerX(0.0f), playerY(0.0f), playerRotation(0.0f),
-      windowWidth(windowWidth), windowHeight(windowHeight) {}
+    : cameraDistance(10.0f), cameraAngle(0.0f), playerX(0.0f), playerY(0.0f),
+      prevPlayerX(0.0f), prevPlayerY(0.0f), playerRotation(0.0f),
+      windowWidth(windowWidth), windowHeight(windowHeight),
+      perspective(45.0f, (float)windowWidth / windowHeight, 0.1f, 100.0f) {}
 
 void CameraController::movePlayerAbsolute(float dx, float dy) {
     playerX += dx;
@@ -28,13 +30,21 @@ void CameraController::updateRotation(int mouseX, int mouseY) {
 
 void CameraController::applyView() {
     glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluPerspective(45.0f, (float)windowWidth / windowHeight, 0.1f, 100.0f);
-
+    glLoadMatrixf(getProjectionMatrix().data());
     glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    glLoadMatrixf(getViewMatrix().data());
+}
+
+Matrix4 CameraController::getViewMatrix() const {
+    // Top-down view over the player, +Z toward the top of the screen
+    return Matrix4::lookAt(Vector3(playerX, cameraDistance, playerY), Vector3(playerX, 0.0f, playerY),
+                           Vector3(0.0f, 0.0f, 1.0f));
+}
 
-    gluLookAt(playerX, cameraDistance, playerY, playerX, 0.0f, playerY, 0.0f, 0.0f, 1.0f);
+Matrix4 CameraController::getInterpolatedViewMatrix(float alpha) const {
+    float x = prevPlayerX + (playerX - prevPlayerX) * alpha;
+    float y = prevPlayerY + (playerY - prevPlayerY) * alpha;
+    return Matrix4::lookAt(Vector3(x, cameraDistance, y), Vector3(x, 0.0f, y), Vector3(0.0f, 0.0f, 1.0f));
 }
 
 void CameraController::getPlayerPosition(float* x, float* y, float* rotation) const {
@@ -47,6 +57,7 @@ void CameraController::reset() {
     playerX = 0.0f;
     playerY = 0.0f;
     playerRotation = 0.0f;
+    storePreviousState();
 }
 
 Vector3 CameraController::getShootPosition() const {
@@ -3,10 +3,14 @@
 #include <GL/glut.h>
 #include <iostream>
 #include <filesystem>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include "UI.h"
 #include "Stob.h"
 #include "Camera.h"
 #include "Scene.h"
+#include "SceneRenderer.h"
 #include "InputHandler.h"
 #include "camera_controller.h"
 #include "FreeCamera.h"
@@ -15,9 +19,23 @@
 #include "Bullet.h"
 #include "Lighting.h"
 #include "MeshIO.h"
+#include "MeshLibrary.h"
 #include "Shapes.h"
 #include "GameState.h"
 #include "EnemyManager.h"
+#include "HudBatch.h"
+#include "Benchmark.h"
+#include "HeadlessContext.h"
+#include "TextureCache.h"
+#include "StreamBuffer.h"
+#include "FrameGraph.h"
+#include "FrameClock.h"
+#include "InputRecorder.h"
+#include "FrameSnapshot.h"
+#include "SimulationThread.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <thread>
 
 // Window dimensions
 const int WINDOW_WIDTH = 1280;
@@ -35,12 +53,27 @@ Camera* camera = nullptr;
 CameraController* camera_controller = nullptr;
 FreeCamera* free_camera = nullptr;
 Scene* scene = nullptr;
+SceneRenderer* sceneRenderer = nullptr;
 Stob* stob_0 = nullptr;
 Player* player = nullptr;
 InputHandler* inputHandler = nullptr;
 ScreenRecorder* screenRecorder = nullptr;
 Lighting* lighting = nullptr;
 EnemyManager* enemyManager = nullptr;
+Benchmark* benchmark = nullptr;  // set only when started with --benchmark
+HeadlessContext* headlessContext = nullptr;  // --benchmark's context when no window is needed
+FrameGraph* frameGraph = nullptr;
+FrameClock* frameClock = nullptr;  // fixed-step timing of the interactive loop
+InputRecorder* inputRecorder = nullptr;  // --record / --replay of the session's input
+uint32_t simulationTick = 0;  // fixed steps simulated so far; input events are stamped with it
+SimulationThread* simulationThread = nullptr;  // steps the world while the main thread renders
+FrameSnapshot* renderSnapshot = nullptr;  // last finished frame, drawn by the main thread
+FrameSnapshot* simSnapshot = nullptr;     // being filled by the simulation thread
+int stepsOwed = 0;  // steps the clock granted but a replay held back to the next frame
+
+// Current window size, kept by reshape() so the HUD never has to query GL_VIEWPORT
+int viewportWidth = WINDOW_WIDTH;
+int viewportHeight = WINDOW_HEIGHT;
 
 void initOpenGL() {
     glEnable(GL_DEPTH_TEST);
@@ -52,205 +85,195 @@ void initOpenGL() {
     glClearColor(0.53f, 0.81f, 0.92f, 1.0f);
 }
 
-void display() {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+// Queues the Game Over panel into the HUD batch
+void queueGameOverOverlay() {
+    HudBatch& hud = HudBatch::instance();
+    float screenW = static_cast<float>(hud.getViewportWidth());
+    float screenH = static_cast<float>(hud.getViewportHeight());
+    float centerX = screenW / 2.0f;
+    float centerY = screenH / 2.0f;
+
+    // Full-screen dark overlay
+    hud.addQuad(0.0f, 0.0f, screenW, screenH, Color(0.0f, 0.0f, 0.0f), 0.7f);
+
+    // Central panel - larger and more prominent
+    float panelWidth = 400.0f;
+    float panelHeight = 180.0f;
+    float left = centerX - panelWidth / 2;
+    float right = centerX + panelWidth / 2;
+    float bottom = centerY - panelHeight / 2;
+    float top = centerY + panelHeight / 2;
+
+    // Panel shadow (offset dark rectangle)
+    hud.addQuad(left + 8, bottom - 8, right + 8, top - 8, Color(0.0f, 0.0f, 0.0f), 0.5f);
+
+    // Main panel background (dark gray gradient, lighter at the top)
+    hud.addGradientQuad(left, bottom, right, top,
+                        Color(0.08f, 0.08f, 0.1f), 0.95f, Color(0.15f, 0.15f, 0.18f), 0.95f);
+
+    // Panel border - double line effect
+    hud.addRectOutline(left, bottom, right, top, 4.0f, Color(0.4f, 0.1f, 0.1f));  // Dark red outer
+    hud.addRectOutline(left + 4, bottom + 4, right - 4, top - 4, 2.0f, Color(0.8f, 0.2f, 0.2f));  // Brighter red inner
+
+    // Decorative line under title
+    hud.addLine(centerX - 120.0f, centerY + 15.0f, centerX + 120.0f, centerY + 15.0f, 2.0f, Color(0.6f, 0.15f, 0.15f));
+
+    // "GAME OVER" title - large text
+    const char* titleText = "GAME OVER";
+    int titleCharWidth = 14;  // Approximate width per character
+    float titleX = centerX - (strlen(titleText) * titleCharWidth) / 2.0f;
+    hud.addText(titleX, centerY + 40.0f, GLUT_BITMAP_TIMES_ROMAN_24, titleText, Color(0.9f, 0.2f, 0.2f));
+
+    // "You were defeated" message
+    const char* defeatText = "You were defeated by the enemies";
+    int defeatCharWidth = 9;
+    float defeatX = centerX - (strlen(defeatText) * defeatCharWidth) / 2.0f;
+    hud.addText(defeatX, centerY - 15.0f, GLUT_BITMAP_HELVETICA_18, defeatText, Color(0.7f, 0.7f, 0.7f));
+
+    // "Press ESC to exit" instruction
+    const char* exitText = "Press ESC to exit";
+    int exitCharWidth = 8;
+    float exitX = centerX - (strlen(exitText) * exitCharWidth) / 2.0f;
+    hud.addText(exitX, centerY - 55.0f, GLUT_BITMAP_HELVETICA_12, exitText, Color(0.5f, 0.5f, 0.5f));
+}
+
+// Declares one frame's passes for the given camera and runs them into
+// whatever framebuffer is bound. The graph sets each pass's depth/blend
+// state and skips passes nothing consumes (capture when not recording).
+// Moving objects and the HUD come from snapshot, never the live simulation.
+void renderFrame(const FrameSnapshot& snapshot, const CameraView& cameraView) {
+    sceneRenderer->applySnapshot(snapshot);
+    // Finished background decodes go to the GPU within the per-frame upload budget
+    TextureCache::instance().update();
+    // Per-frame vertex and instance data is written into this frame's ring segment
+    StreamBuffer::instance().beginFrame();
+    HudBatch::instance().beginFrame(cameraView);
+
+    FrameGraph& graph = *frameGraph;
+    graph.reset();
+    FrameGraph::Resource backbuffer = graph.importTarget("backbuffer", FrameGraph::getBoundFramebuffer(),
+                                                         cameraView.viewportWidth, cameraView.viewportHeight);
+    graph.markOutput(backbuffer);
+
+    // While recording, the frame is drawn offscreen so capture reads the
+    // finished color target directly before it is presented
+    bool capturing = screenRecorder && screenRecorder->isRecording();
+    FrameGraph::Resource color = backbuffer;
+    if (capturing && graph.supportsTransientTargets()) {
+        color = graph.createTarget("sceneColor", {cameraView.viewportWidth, cameraView.viewportHeight, true});
+    }
+
+    FrameGraph::PassState opaqueState;
+    opaqueState.clear = GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT;
+    FrameGraph::PassId opaque = graph.addPass("opaque", opaqueState, [&cameraView]() {
+        cameraView.apply();
+        // CRITICAL: Apply lighting AFTER camera view is set
+        // This allows light position to be transformed by the current modelview (headlight mode)
+        if (lighting) {
+            lighting->apply(cameraView);
+        }
+        sceneRenderer->drawOpaque(cameraView);
+        //Draw the controlled Stob
+        //stob_0->draw();
+        sceneRenderer->drawPlayer();
+    });
+    graph.write(opaque, color);
+
+    FrameGraph::PassState transparentState;
+    transparentState.depthWrite = false;
+    transparentState.blend = true;
+    FrameGraph::PassId transparent = graph.addPass("transparent", transparentState, []() {
+        sceneRenderer->drawTransparent();
+    });
+    graph.write(transparent, color);
+
+    // Editor panels are opaque; the HUD blends over everything
+    FrameGraph::PassState overlayState;
+    overlayState.depthTest = false;
+    overlayState.lighting = false;
+    FrameGraph::PassId editor = graph.addPass("editor", overlayState, []() {
+        gameUI->drawEditorUI();
+    });
+    graph.write(editor, color);
+
+    overlayState.blend = true;
+    bool gameOver = snapshot.gameState == GameState::GAME_OVER;
+    FrameGraph::PassId hud = graph.addPass("hud", overlayState, [gameOver]() {
+        gameUI->drawCross();
+        if (gameOver) {
+            queueGameOverOverlay();
+        }
+        // Every health bar, label and overlay queued this frame, in one draw
+        HudBatch::instance().flush();
+    });
+    graph.write(hud, color);
 
-    // Set up projection matrix
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluPerspective(60.0, (double)WINDOW_WIDTH / WINDOW_HEIGHT, 0.1, 100.0);
+    FrameGraph::PassId capture = graph.addPass("capture", FrameGraph::PassState(), []() {
+        screenRecorder->captureFrame();
+    });
+    graph.read(capture, color);
+    graph.setSideEffect(capture, capturing);
+
+    if (color != backbuffer) {
+        int width = cameraView.viewportWidth, height = cameraView.viewportHeight;
+        FrameGraph::PassId present = graph.addPass("present", FrameGraph::PassState(), [width, height]() {
+            glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        });
+        graph.read(present, color);
+        graph.write(present, backbuffer);
+    }
 
-    // Set up modelview matrix
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    graph.execute();
+    StreamBuffer::instance().endFrame();
+}
 
-    // Apply camera view
+// Draws the last finished frame. Everything moving sits between the two
+// simulation steps the snapshot holds, blended at its alpha, so motion stays
+// smooth whatever the ratio of frame rate to step rate.
+void display() {
+    const FrameSnapshot& snapshot = *renderSnapshot;
+
+    // Build the active camera's matrices on the CPU; culling, LOD, lighting
+    // and the HUD all read them from here instead of querying GL
+    CameraView cameraView;
     if(inputHandler && inputHandler->isFreeCameraActive()) {
-        // Free Camera / Spectator mode
-        free_camera->applyView();
+        // Free Camera / Spectator mode (input-driven only, so read live)
+        cameraView = CameraView(free_camera->getViewMatrix(), free_camera->getProjectionMatrix(),
+                                viewportWidth, viewportHeight);
     }
     else if(Active_Third_Camera == false) {
-        camera->applyView();
+        cameraView = CameraView(snapshot.firstPersonView, snapshot.firstPersonProjection,
+                                viewportWidth, viewportHeight);
     }
     else {
-        camera_controller->applyView();
+        cameraView = CameraView(snapshot.thirdPersonView, snapshot.thirdPersonProjection,
+                                viewportWidth, viewportHeight);
     }
 
-    // CRITICAL: Apply lighting AFTER camera view is set
-    // This allows light position to be transformed by the current modelview (headlight mode)
-    if (lighting) {
-        // Update headlight position if in headlight mode
-        if (lighting->isHeadlightMode()) {
-            if (Active_Third_Camera == false) {
-                // First-person: light follows camera
-                Vector3 lookDir = camera->getLookDirection();
-                lighting->updateHeadlight(camera->getX(), camera->getY(), camera->getZ(),
-                                         lookDir.x, lookDir.y, lookDir.z);
-            } else {
-                // Third-person: light follows player
-                Vector3 playerPos = player->getPosition();
-                Vector3 visionDir = -player->getVisionDirection();
-                lighting->updateHeadlight(playerPos.x, playerPos.y + 1.0f, playerPos.z,
-                                         visionDir.x, visionDir.y, visionDir.z);
-            }
+    // Update headlight position if in headlight mode
+    if (lighting && lighting->isHeadlightMode()) {
+        if (Active_Third_Camera == false) {
+            // First-person: light follows camera
+            Vector3 eye = snapshot.firstPersonEye;
+            Vector3 lookDir = snapshot.firstPersonLook;
+            lighting->updateHeadlight(eye.x, eye.y, eye.z, lookDir.x, lookDir.y, lookDir.z);
+        } else {
+            // Third-person: light follows player
+            const FrameSnapshot::PlayerState& shown = snapshot.player;
+            Vector3 playerPos = shown.previousPosition + (shown.position - shown.previousPosition) * snapshot.alpha;
+            Vector3 visionDir = -shown.visionDirection;
+            lighting->updateHeadlight(playerPos.x, playerPos.y + 1.0f, playerPos.z,
+                                     visionDir.x, visionDir.y, visionDir.z);
         }
-        lighting->apply();
     }
 
-    // Draw the scene
-    scene->draw();
-    //Draw the controlled Stob
-    //stob_0->draw();
-    player->draw();
-    gameUI->drawCross();
-    gameUI->drawEditorUI();
-
-    // Draw Game Over overlay if dead
-    if (gameState == GameState::GAME_OVER) {
-        // Save OpenGL state
-        glPushMatrix();
-        glMatrixMode(GL_PROJECTION);
-        glPushMatrix();
-        glLoadIdentity();
-
-        // Set up orthographic projection for 2D overlay
-        GLint viewport[4];
-        glGetIntegerv(GL_VIEWPORT, viewport);
-        glOrtho(0, viewport[2], 0, viewport[3], -1, 1);
-
-        glMatrixMode(GL_MODELVIEW);
-        glPushMatrix();
-        glLoadIdentity();
-
-        glDisable(GL_DEPTH_TEST);
-        glDisable(GL_LIGHTING);
-
-        float screenW = static_cast<float>(viewport[2]);
-        float screenH = static_cast<float>(viewport[3]);
-        float centerX = screenW / 2.0f;
-        float centerY = screenH / 2.0f;
-
-        // Draw full-screen dark overlay with gradient effect
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        // Darker at edges, lighter at center (vignette effect)
-        glBegin(GL_QUADS);
-        // Dark overlay
-        glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
-        glVertex2f(0, 0);
-        glVertex2f(screenW, 0);
-        glVertex2f(screenW, screenH);
-        glVertex2f(0, screenH);
-        glEnd();
-
-        // Central panel - larger and more prominent
-        float panelWidth = 400.0f;
-        float panelHeight = 180.0f;
-
-        // Panel shadow (offset dark rectangle)
-        glColor4f(0.0f, 0.0f, 0.0f, 0.5f);
-        glBegin(GL_QUADS);
-        glVertex2f(centerX - panelWidth/2 + 8, centerY - panelHeight/2 - 8);
-        glVertex2f(centerX + panelWidth/2 + 8, centerY - panelHeight/2 - 8);
-        glVertex2f(centerX + panelWidth/2 + 8, centerY + panelHeight/2 - 8);
-        glVertex2f(centerX - panelWidth/2 + 8, centerY + panelHeight/2 - 8);
-        glEnd();
-
-        // Main panel background (dark gray gradient)
-        glBegin(GL_QUADS);
-        glColor4f(0.15f, 0.15f, 0.18f, 0.95f);  // Top - slightly lighter
-        glVertex2f(centerX - panelWidth/2, centerY + panelHeight/2);
-        glVertex2f(centerX + panelWidth/2, centerY + panelHeight/2);
-        glColor4f(0.08f, 0.08f, 0.1f, 0.95f);   // Bottom - darker
-        glVertex2f(centerX + panelWidth/2, centerY - panelHeight/2);
-        glVertex2f(centerX - panelWidth/2, centerY - panelHeight/2);
-        glEnd();
-
-        glDisable(GL_BLEND);
-
-        // Panel border - double line effect
-        glColor3f(0.4f, 0.1f, 0.1f);  // Dark red outer
-        glLineWidth(4.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(centerX - panelWidth/2, centerY - panelHeight/2);
-        glVertex2f(centerX + panelWidth/2, centerY - panelHeight/2);
-        glVertex2f(centerX + panelWidth/2, centerY + panelHeight/2);
-        glVertex2f(centerX - panelWidth/2, centerY + panelHeight/2);
-        glEnd();
-
-        glColor3f(0.8f, 0.2f, 0.2f);  // Brighter red inner
-        glLineWidth(2.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(centerX - panelWidth/2 + 4, centerY - panelHeight/2 + 4);
-        glVertex2f(centerX + panelWidth/2 - 4, centerY - panelHeight/2 + 4);
-        glVertex2f(centerX + panelWidth/2 - 4, centerY + panelHeight/2 - 4);
-        glVertex2f(centerX - panelWidth/2 + 4, centerY + panelHeight/2 - 4);
-        glEnd();
-        glLineWidth(1.0f);
-
-        // Decorative line under title
-        glColor3f(0.6f, 0.15f, 0.15f);
-        glLineWidth(2.0f);
-        glBegin(GL_LINES);
-        glVertex2f(centerX - 120.0f, centerY + 15.0f);
-        glVertex2f(centerX + 120.0f, centerY + 15.0f);
-        glEnd();
-        glLineWidth(1.0f);
-
-        // "GAME OVER" title - large text
-        glColor3f(0.9f, 0.2f, 0.2f);  // Bright red
-        const char* titleText = "GAME OVER";
-        // GLUT_BITMAP_TIMES_ROMAN_24 is larger
-        int titleCharWidth = 14;  // Approximate width per character
-        float titleX = centerX - (strlen(titleText) * titleCharWidth) / 2.0f;
-        glRasterPos2f(titleX, centerY + 40.0f);
-        for (const char* c = titleText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_TIMES_ROMAN_24, *c);
-        }
-
-        // "You were defeated" message
-        glColor3f(0.7f, 0.7f, 0.7f);
-        const char* defeatText = "You were defeated by the enemies";
-        int defeatCharWidth = 9;
-        float defeatX = centerX - (strlen(defeatText) * defeatCharWidth) / 2.0f;
-        glRasterPos2f(defeatX, centerY - 15.0f);
-        for (const char* c = defeatText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-        }
-
-        // "Press ESC to exit" instruction
-        glColor3f(0.5f, 0.5f, 0.5f);
-        const char* exitText = "Press ESC to exit";
-        int exitCharWidth = 8;
-        float exitX = centerX - (strlen(exitText) * exitCharWidth) / 2.0f;
-        glRasterPos2f(exitX, centerY - 55.0f);
-        for (const char* c = exitText; *c != '\0'; c++) {
-            glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, *c);
-        }
-
-        // Restore OpenGL state
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_LIGHTING);
-
-        glPopMatrix();
-        glMatrixMode(GL_PROJECTION);
-        glPopMatrix();
-        glMatrixMode(GL_MODELVIEW);
-        glPopMatrix();
-    }
+    renderFrame(snapshot, cameraView);
 
     glutSwapBuffers();
-
-    // Capture frame for screen recording if recording is active
-    if (screenRecorder && screenRecorder->isRecording()) {
-        screenRecorder->captureFrame();
-    }
 }
 
-void update(int value) {
-    float deltaTime = 0.016f; // ~60 FPS = 16ms
-
+// One fixed simulation step of length deltaTime
+void simulate(float deltaTime) {
     // Update game state based on free camera mode
     if (inputHandler && inputHandler->isFreeCameraActive() || inputHandler->isEditModeActive()) {
         if (gameState == GameState::PLAYING) {
@@ -263,7 +286,7 @@ void update(int value) {
     }
 
     // Always update input handler (for camera controls)
-    inputHandler->update();
+    inputHandler->update(deltaTime);
 
     // Only update gameplay when PLAYING
     if (gameState == GameState::PLAYING) {
@@ -296,12 +319,93 @@ void update(int value) {
             }
         }
     }
+}
 
-    glutPostRedisplay();
-    glutTimerFunc(16, update, 0); // ~60 FPS
+void applyInput(const InputEvent& event);
+
+// Captures the frame the renderer will show next
+void captureSnapshot(FrameSnapshot& snapshot, float alpha) {
+    snapshot.capture(*scene, enemyManager->getHorde(), *player, *camera, *camera_controller, gameState,
+                     simulationTick, alpha);
 }
 
-void keyboard(unsigned char key, int x, int y) {
+// Idle callback of the interactive loop, one pipelined frame: the simulation
+// thread runs the steps wall time has accumulated (capped by FrameClock) and
+// captures the result into simSnapshot, while this thread draws
+// renderSnapshot, captured at the end of the previous frame. The two swap
+// once both halves are done, so a frame costs about max(sim, render) at the
+// price of showing the world one frame late. With vsync the swap in
+// display() paces the loop; uncapped it spins freely.
+void tick() {
+    stepsOwed = std::min(stepsOwed + frameClock->advance(), FrameClock::MAX_STEPS_PER_FRAME);
+
+    // Replayed input lands right before the step it preceded when recorded,
+    // so a batch stops at the next event and the rest waits for the next frame
+    InputEvent event;
+    while (inputRecorder && inputRecorder->nextDue(simulationTick, event)) {
+        applyInput(event);
+    }
+    int steps = stepsOwed;
+    uint32_t nextEventTick;
+    if (inputRecorder && inputRecorder->peekTick(nextEventTick)) {
+        steps = static_cast<int>(std::min<uint32_t>(steps, nextEventTick - simulationTick));
+    }
+    stepsOwed -= steps;
+
+    float alpha = frameClock->getAlpha();
+    simulationThread->launch([steps, alpha]() {
+        for (int i = 0; i < steps; i++) {
+            // Interpolation blends from the state each step starts with
+            camera->storePreviousState();
+            camera_controller->storePreviousState();
+            player->storePreviousState();
+            scene->storePreviousState();
+            simulate(FrameClock::FIXED_STEP);
+            simulationTick++;
+        }
+        captureSnapshot(*simSnapshot, alpha);
+    });
+
+    display();
+
+    // Input callbacks only run after this returns, with the worker idle
+    simulationThread->wait();
+    std::swap(renderSnapshot, simSnapshot);
+}
+
+// Benchmark mode replaces the timer/display pair: one scripted frame per idle
+// callback, simulated with a fixed step so every run sees the same scene
+void benchmarkFrame() {
+    const float deltaTime = FrameClock::FIXED_STEP;
+    scene->update(deltaTime);
+    if (enemyManager) {
+        // Enemies chase a stand-in player at the arena centre; nobody takes damage
+        enemyManager->update(deltaTime, GameState::PLAYING, Vector3(0.0f, 0.0f, 0.0f));
+    }
+    // Serial, one step per frame, so every frame shows the latest step
+    captureSnapshot(*renderSnapshot, 1.0f);
+
+    CameraView cameraView = benchmark->getCameraView();
+    if (lighting && lighting->isHeadlightMode()) {
+        Vector3 eye = cameraView.position;
+        // The view matrix's third row is the camera's backward axis
+        const Matrix4& view = cameraView.view;
+        Vector3 lookDir(-view.at(2, 0), -view.at(2, 1), -view.at(2, 2));
+        lighting->updateHeadlight(eye.x, eye.y, eye.z, lookDir.x, lookDir.y, lookDir.z);
+    }
+
+    benchmark->beginFrame();
+    renderFrame(*renderSnapshot, cameraView);
+    const SceneRenderer::CullStats& cull = sceneRenderer->getCullStats();
+    benchmark->endFrame(cull.submitted, cull.culled, cull.occluded);
+
+    if (benchmark->isFinished()) {
+        bool written = benchmark->writeReport();
+        exit(written ? 0 : 1);
+    }
+}
+
+void keyPress(unsigned char key) {
     // Handle screen recording toggle (R key)
     if (key == 'r' || key == 'R') {
         if (screenRecorder) {
@@ -322,63 +426,185 @@ void keyboard(unsigned char key, int x, int y) {
         return;
     }
 
+    // Render statistics (the input handler prints the scene's part)
+    if (key == 'i' || key == 'I') {
+        if (frameGraph) frameGraph->printStats();
+        if (frameClock) frameClock->printStats();
+        if (simulationThread) simulationThread->printStats();
+        JobSystem::instance().printStats();
+    }
+
     inputHandler->handleKeyPress(key);
 }
 
+// Every input reaches the game through here, whether live or replayed
+void applyInput(const InputEvent& event) {
+    switch (event.type) {
+    case InputEvent::KEY_DOWN:
+        keyPress(event.code);
+        break;
+    case InputEvent::KEY_UP:
+        inputHandler->handleKeyRelease(event.code);
+        break;
+    case InputEvent::SPECIAL_KEY:
+        inputHandler->handleSpecialKey(event.code, event.x, event.y);
+        break;
+    case InputEvent::MOUSE_BUTTON:
+        inputHandler->setModifiers(event.modifiers);
+        // Mouse wheel events (buttons 3 and 4) - legacy GLUT
+        if (event.code == 3 || event.code == 4) {
+            inputHandler->handleMouseWheel(event.code, event.state, event.x, event.y);
+        } else {
+            inputHandler->handleMouseClick(event.code, event.state, event.x, event.y);
+        }
+        break;
+    case InputEvent::MOUSE_MOTION:
+        inputHandler->handleMouseMotion(event.x, event.y);
+        break;
+    case InputEvent::RESIZE:
+        inputHandler->setWindowSize(event.x, event.y);
+        break;
+    }
+}
+
+// GLUT callbacks: stamp the event, log it when recording and apply it. While
+// a replay runs only ESC gets through, so the session can still be quit.
+void liveInput(InputEvent event) {
+    if (inputRecorder && inputRecorder->isReplaying() &&
+        !(event.type == InputEvent::KEY_DOWN && event.code == 27)) {
+        return;
+    }
+    event.tick = simulationTick;
+    if (inputRecorder) inputRecorder->record(event);
+    applyInput(event);
+}
+
+InputEvent makeInput(InputEvent::Type type, int code, int x, int y) {
+    InputEvent event;
+    event.type = type;
+    event.code = static_cast<uint8_t>(code);
+    event.x = static_cast<int16_t>(x);
+    event.y = static_cast<int16_t>(y);
+    return event;
+}
+
+void keyboard(unsigned char key, int x, int y) {
+    liveInput(makeInput(InputEvent::KEY_DOWN, key, x, y));
+}
+
 void keyboardUp(unsigned char key, int x, int y) {
-    inputHandler->handleKeyRelease(key);
+    liveInput(makeInput(InputEvent::KEY_UP, key, x, y));
 }
 
 void mouseMotion(int x, int y) {
-    inputHandler->handleMouseMotion(x, y);
+    liveInput(makeInput(InputEvent::MOUSE_MOTION, 0, x, y));
 }
 
 void specialKey(int key, int x, int y) {
-    inputHandler->handleSpecialKey(key, x, y);
+    liveInput(makeInput(InputEvent::SPECIAL_KEY, key, x, y));
 }
 
 void reshape(int width, int height) {
     glViewport(0, 0, width, height);
-    inputHandler->setWindowSize(width, height);
+    viewportWidth = width;
+    viewportHeight = height;
+    liveInput(makeInput(InputEvent::RESIZE, 0, width, height));
 }
 
 void mouse(int button, int state, int x, int y) {
-    // Mouse wheel events (buttons 3 and 4) - legacy GLUT
-    if (button == 3 || button == 4) {
-        inputHandler->handleMouseWheel(button, state, x, y);
-    } else {
-        inputHandler->handleMouseClick(button, state, x, y);
-    }
+    InputEvent event = makeInput(InputEvent::MOUSE_BUTTON, button, x, y);
+    event.state = static_cast<uint8_t>(state);
+    event.modifiers = static_cast<uint8_t>(glutGetModifiers());
+    liveInput(event);
 }
 
 void mouseWheel(int wheel, int direction, int x, int y) {
     // Freeglut mouse wheel callback
     // direction > 0 = scroll up (zoom in), direction < 0 = scroll down (zoom out)
     int button = (direction > 0) ? 3 : 4;  // Convert to legacy button numbers
-    inputHandler->handleMouseWheel(button, GLUT_DOWN, x, y);
+    InputEvent event = makeInput(InputEvent::MOUSE_BUTTON, button, x, y);
+    event.state = GLUT_DOWN;
+    liveInput(event);
 }
 
 void cleanup() {
+    // Joined first: its job touches most of what follows
+    delete simulationThread;
+    delete renderSnapshot;
+    delete simSnapshot;
+    delete inputRecorder;
+    delete benchmark;
+    delete frameClock;
+    delete frameGraph;
     delete enemyManager;
     delete lighting;
     delete screenRecorder;
     delete camera_controller;
     delete free_camera;
     delete camera;
+    delete sceneRenderer;
     delete scene;
     delete stob_0;
     delete inputHandler;
     delete gameUI;
+    // Every shape is gone now, so this frees the shared meshes and textures
+    // while the GL context still exists (both singletons outlive it)
+    MeshLibrary::instance().releaseUnused();
+    TextureCache::instance().release();
+    delete headlessContext;
 }
 
 int main(int argc, char** argv) {
-    glutInit(&argc, argv);
-    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
-    glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
-    glutCreateWindow("FPS Game");
+    BenchmarkOptions benchmarkOptions;
+    bool benchmarkMode = Benchmark::parseArgs(argc, argv, benchmarkOptions);
+    // The benchmark draws offscreen, so where EGL is available it runs
+    // without a window or display server; otherwise it uses a hidden GLUT window
+    if (benchmarkMode) {
+        headlessContext = new HeadlessContext();
+        if (!headlessContext->create()) {
+            delete headlessContext;
+            headlessContext = nullptr;
+        }
+    }
+    if (!headlessContext) glutInit(&argc, argv);
+    FrameClock::Pacing pacing = FrameClock::Pacing::VSYNC;
+    uint64_t seed = static_cast<uint64_t>(time(nullptr));
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    int hordeSize = 0;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--uncapped") == 0) pacing = FrameClock::Pacing::UNCAPPED;
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--record") == 0 && hasValue) recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--horde") == 0 && hasValue) hordeSize = std::max(0, std::atoi(argv[++i]));
+    }
+    if (recordPath && replayPath) {
+        std::cerr << "--record and --replay cannot be combined" << std::endl;
+        return -1;
+    }
+    if (recordPath || replayPath) {
+        inputRecorder = new InputRecorder();
+        bool opened = recordPath ? inputRecorder->startRecording(recordPath, seed)
+                                 : inputRecorder->loadReplay(replayPath);
+        if (!opened) return -1;
+        // A replay reruns the recorded session's seed
+        if (replayPath) seed = inputRecorder->getReplaySeed();
+    }
+
+    if (!headlessContext) {
+        glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
+        glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
+        glutCreateWindow("FPS Game");
+    }
 
     // Initialize GLEW
     GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // A GLX build of GLEW loads the GL functions, then finds no GLX display
+    if (headlessContext && err == GLEW_ERROR_NO_GLX_DISPLAY) err = GLEW_OK;
+#endif
     if (err != GLEW_OK) {
         std::cerr << "GLEW Error: " << glewGetErrorString(err) << std::endl;
         return -1;
@@ -386,16 +612,20 @@ int main(int argc, char** argv) {
 
     // Initialize OpenGL settings
     initOpenGL();
+    frameGraph = new FrameGraph();
 
     // Create game objects
     scene = new Scene();
     scene->initialize();
+    sceneRenderer = new SceneRenderer(*scene);
+    sceneRenderer->initialize();
 
     // Create lighting system (enabled by default with headlight mode)
     lighting = new Lighting();
+    lighting->initializeShader();
     // Headlight mode is enabled by default - light follows active camera
     // Press 'L' to toggle lighting on/off
-    scene->setLighting(lighting);
+    sceneRenderer->setLighting(lighting);
     std::cout << "Lighting initialized: Headlight mode ENABLED (follows camera)" << std::endl;
 
     // === Mesh Import/Export Demo ===
@@ -510,12 +740,14 @@ int main(int argc, char** argv) {
     camera = new Camera(0.0f, 1.5f, 0.0f);  // Position camera at eye level above Stob
     camera->setScene(scene);  // Set scene for collision detection
     camera->setCollisionRadius(0.5f);  // Set player collision radius
+    camera->setPerspective(Perspective(60.0f, (float)WINDOW_WIDTH / WINDOW_HEIGHT, 0.1f, 100.0f));
 
     camera_controller = new CameraController(WINDOW_WIDTH, WINDOW_HEIGHT);
     camera_controller->setPlayerPosition(0.0f, 0.0f);  // Sync with Stob's starting position
 
     // Create Free Camera / Spectator mode camera
     free_camera = new FreeCamera(0.0f, 10.0f, 0.0f);  // Start elevated above scene
+    free_camera->setPerspective(Perspective(60.0f, (float)WINDOW_WIDTH / WINDOW_HEIGHT, 0.1f, 100.0f));
 
     player = new Player(scene);
     // IMPORTANT: Sync player position with camera at startup to prevent position mismatch
@@ -525,6 +757,7 @@ int main(int argc, char** argv) {
     gameUI = new UI(WINDOW_WIDTH, WINDOW_HEIGHT);
     inputHandler = new InputHandler(camera, camera_controller, free_camera, scene, stob_0, player, gameUI, WINDOW_WIDTH, WINDOW_HEIGHT);
     inputHandler->setLighting(lighting);
+    inputHandler->setSceneRenderer(sceneRenderer);
 
     // Initialize enemy manager
     enemyManager = new EnemyManager(scene);
@@ -534,7 +767,46 @@ int main(int argc, char** argv) {
     enemyManager->setMaxEnemies(6);          // Maximum 6 enemies at once
     enemyManager->setEnemySpeed(1.5f);       // Enemies move at 1.5 units/second
     enemyManager->setNavigationGrid(&scene->getNavigationGrid());
+    enemyManager->setSeed(seed);
     std::cout << "Enemy system initialized: spawning every 5s, max 6 enemies" << std::endl;
+    if (hordeSize > 0) {
+        // The horde fills up over about ten seconds
+        enemyManager->setHordeMode(true);
+        enemyManager->setMaxEnemies(hordeSize);
+        enemyManager->setSpawnInterval(0.5f);
+        enemyManager->setHordeSpawnBatch(std::max(1, hordeSize / 20));
+        std::cout << "Horde mode: up to " << hordeSize << " enemies" << std::endl;
+    }
+
+    renderSnapshot = new FrameSnapshot();
+    simSnapshot = new FrameSnapshot();
+
+    if (benchmarkMode) {
+        // Offscreen fly-through: fixed seed and enemy count, no input, no window
+        enemyManager->setSeed(12345);
+        enemyManager->setMaxEnemies(benchmarkOptions.enemies);
+        enemyManager->setSpawnInterval(0.5f);
+        viewportWidth = benchmarkOptions.width;
+        viewportHeight = benchmarkOptions.height;
+
+        benchmark = new Benchmark();
+        if (!benchmark->initialize(benchmarkOptions)) {
+            std::cerr << "Benchmark mode unavailable on this GL context" << std::endl;
+            return -1;
+        }
+        // Measure rendering, not texture streaming
+        TextureCache::instance().finishLoading();
+        atexit(cleanup);
+        if (headlessContext) {
+            // No window, so no GLUT loop; benchmarkFrame() exits once the report is written
+            for (;;) benchmarkFrame();
+        }
+        glutHideWindow();
+        glutDisplayFunc([]() {});  // GLUT insists on one; frames come from benchmarkFrame()
+        glutIdleFunc(benchmarkFrame);
+        glutMainLoop();
+        return 0;
+    }
 
     // Initialize screen recorder (30 FPS)
     screenRecorder = new ScreenRecorder(WINDOW_WIDTH, WINDOW_HEIGHT, 30);
@@ -561,7 +833,8 @@ int main(int argc, char** argv) {
     std::cout << "Mouse wheel via buttons 3/4 (legacy GLUT)" << std::endl;
     #endif
 
-    glutTimerFunc(0, update, 0);
+    FrameClock::setPacing(pacing);
+    glutIdleFunc(tick);
 
     // Print controls
     std::cout << "Controls:" << std::endl;
@@ -573,6 +846,9 @@ int main(int argc, char** argv) {
     std::cout << "  Tab - Toggle mouse capture (free cursor for other windows)" << std::endl;
     std::cout << "  R - Start/Stop screen recording (saves to project root videos/ folder)" << std::endl;
     std::cout << "  P - Take screenshot (saves PNG to project root pics/ folder)" << std::endl;
+    std::cout << "  I - Print render statistics (resident meshes, GPU memory)" << std::endl;
+    std::cout << "  B - Toggle static geometry batching" << std::endl;
+    std::cout << "  O - Toggle occlusion culling" << std::endl;
     std::cout << std::endl;
     std::cout << "Free Camera / Spectator Mode (Photo Mode):" << std::endl;
     std::cout << "  V - Toggle Free Camera ON/OFF (freezes player, shows cursor)" << std::endl;
@@ -587,10 +863,23 @@ int main(int argc, char** argv) {
     std::cout << "  (Headlight mode: light automatically follows camera)" << std::endl;
     std::cout << std::endl;
     std::cout << "  ESC - Exit" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Frame pacing: vsync by default, FirstOGL --uncapped to render as fast as possible" << std::endl;
+    std::cout << "Reproducible sessions: FirstOGL [--seed N] --record file.inputs, then FirstOGL --replay file.inputs" << std::endl;
+    std::cout << "Benchmark: FirstOGL --benchmark [--frames N] [--size WxH] [--enemies N] [--out file.json]" << std::endl;
 
     // Cleanup on exit
     atexit(cleanup);
 
+    // The first frame shows the world as loaded while step one simulates
+    captureSnapshot(*renderSnapshot, 1.0f);
+    simulationThread = new SimulationThread();
+    // One core renders and one simulates; job workers share the rest
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    JobSystem::instance().setWorkerCount(hardwareThreads > 2 ? hardwareThreads - 2 : 0);
+
+    // Started last so loading time is not simulated as one long first frame
+    frameClock = new FrameClock();
     glutMainLoop();
     return 0;
 }